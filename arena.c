@@ -0,0 +1,178 @@
+//! Bump arena and frame buffer pool
+
+//! @file arena.c
+
+
+#include <string.h>
+#include "config.h"
+#include "arena.h"
+
+
+#ifdef CONFIG_ARENA
+#define ARENA_UP(x) (((x) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1)) //!< round up to ARENA_ALIGN
+#define POOL_HEADER ARENA_UP(sizeof(size_t)) //!< size of the class, in front of every block
+
+
+//! give an arena its memory
+
+//! @param a arena
+//! @param mem memory, the start is aligned to ARENA_ALIGN
+//! @param size bytes at mem
+void arena_init(arena_t *a, void *mem, size_t size)
+{
+	size_t skip = ARENA_UP((uintptr_t)mem) - (uintptr_t)mem;
+	a->base = (uint8_t *)mem + skip;
+	a->size = (size > skip) ? size - skip : 0;
+	a->used = 0;
+	a->peak = 0;
+}
+
+
+//! take a piece of an arena
+
+//! @param a arena
+//! @param size bytes
+//! @return ARENA_ALIGN aligned memory, NULL if the arena is full
+void *arena_alloc(arena_t *a, size_t size)
+{
+	void *out;
+	size = ARENA_UP(size);
+	if(size > a->size - a->used)
+		return(NULL);
+	out = a->base + a->used;
+	a->used += size;
+	if(a->used > a->peak)
+		a->peak = a->used;
+	return(out);
+}
+
+
+//! remember the fill of an arena, for arena_release()
+size_t arena_mark(const arena_t *a)
+{
+	return(a->used);
+}
+
+
+//! drop all pieces taken after a mark
+void arena_release(arena_t *a, size_t mark)
+{
+	if(mark < a->used)
+		a->used = mark;
+}
+
+
+#ifndef __AVR__
+//! arena of the calling thread, empty until given memory with arena_init()
+arena_t *arena_thread(void)
+{
+	static _Thread_local arena_t a;
+	return(&a);
+}
+#endif
+
+
+//! empty a pool
+void pool_init(pool_t *p)
+{
+	memset(p, 0, sizeof(*p));
+}
+
+
+//! add blocks of a size
+
+//! @param p pool
+//! @param a arena giving the memory
+//! @param size usable bytes of a block, blocks of the same size are added to its class
+//! @param count amount of blocks
+//! @return 0 on success, -1 if the arena is full or there are POOL_CLASSES sizes already
+int pool_add(pool_t *p, arena_t *a, size_t size, unsigned int count)
+{
+	pool_block_t *b;
+	uint8_t *mem;
+	size_t stride;
+	unsigned int i;
+	uint_fast8_t c;
+	size = ARENA_UP(size ? size : 1);
+	stride = POOL_HEADER + size;
+	if(count && stride > (a->size - a->used) / count)
+		return(-1);
+	for(c=0;c<p->classes && p->size[c] < size;c++);
+	if(c == p->classes || p->size[c] != size) {
+		if(p->classes == POOL_CLASSES)
+			return(-1);
+		//keep the sizes ascending
+		memmove(&p->size[c+1], &p->size[c], (p->classes - c) * sizeof(p->size[0]));
+		memmove(&p->free[c+1], &p->free[c], (p->classes - c) * sizeof(p->free[0]));
+		p->size[c] = size;
+		p->free[c] = NULL;
+		p->classes++;
+	}
+	mem = arena_alloc(a, stride * count);
+	for(i=0;i<count;i++) {
+		memcpy(mem + i * stride, &size, sizeof(size));
+		b = (pool_block_t *)(mem + i * stride + POOL_HEADER);
+		b->next = p->free[c];
+		p->free[c] = b;
+	}
+	return(0);
+}
+
+
+//! add the blocks a chain needs for encoding and decoding
+
+//! @param p pool
+//! @param a arena giving the memory
+//! @param chain chain planned with bc_chain_plan()
+//! @param count amount of blocks of each size
+//! @return 0 on success, -1 if the arena is full or there are too many sizes
+int pool_add_chain(pool_t *p, arena_t *a, const bytecodec_chain_t *chain, unsigned int count)
+{
+	if(pool_add(p, a, chain->enc_buf_len, count))
+		return(-1);
+	if(chain->dec_buf_len != chain->enc_buf_len)
+		return(pool_add(p, a, chain->dec_buf_len, count));
+	return(0);
+}
+
+
+//! take a block
+
+//! @param p pool
+//! @param size bytes needed
+//! @return block of the smallest size with a free block, NULL if there is none
+void *pool_alloc(pool_t *p, size_t size)
+{
+	pool_block_t *b;
+	uint_fast8_t c;
+	for(c=0;c<p->classes;c++) {
+		if(p->size[c] >= size && p->free[c]) {
+			b = p->free[c];
+			p->free[c] = b->next;
+			return(b);
+		}
+	}
+	p->misses++;
+	return(NULL);
+}
+
+
+//! give a block back
+
+//! @param p pool the block was taken from
+//! @param buf block, NULL is ignored
+void pool_free(pool_t *p, void *buf)
+{
+	pool_block_t *b = buf;
+	size_t size;
+	uint_fast8_t c;
+	if(!buf)
+		return;
+	memcpy(&size, (uint8_t *)buf - POOL_HEADER, sizeof(size));
+	for(c=0;c<p->classes && p->size[c] != size;c++);
+	if(c == p->classes)
+		return;
+	b->next = p->free[c];
+	p->free[c] = b;
+}
+#endif //CONFIG_ARENA
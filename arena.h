@@ -0,0 +1,67 @@
+//! Bump arena and frame buffer pool
+
+//! @file arena.h
+//!
+//! Frames and scratch space without malloc() on the hot path. Both work on
+//! memory given once by the caller (a static array on a MCU), nothing is
+//! returned to the system.
+//!
+//! An arena hands out ARENA_ALIGN aligned pieces from the front of its
+//! memory. Pieces are not freed one by one, arena_release() drops
+//! everything after a mark at once, e.g. the scratch space of one frame.
+//! Every thread uses its own arena, arena_thread() gives one per thread.
+//!
+//! A pool keeps blocks of up to POOL_CLASSES sizes, carved from an arena,
+//! in one free list per size. pool_add_chain() makes the sizes a chain
+//! needs for encoding and decoding (enc_buf_len and dec_buf_len of
+//! bc_chain_plan()). Allocating takes the first free block of the smallest
+//! size which fits, freeing puts it back, both without a search. A pool
+//! belongs to one thread.
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "config.h"
+#include "bytecoder.h"
+
+#define ARENA_ALIGN 16    //!< alignment of every piece, a power of 2 (SSE loads)
+#define POOL_CLASSES 4    //!< block sizes of a pool
+
+typedef struct {
+	uint8_t *base;        //!< ARENA_ALIGN aligned start of the memory
+	size_t size;
+	size_t used;
+	size_t peak;          //!< most bytes used at once
+} arena_t;
+
+//! free block, the link is kept in the block itself
+typedef struct pool_block_s {
+	struct pool_block_s *next;
+} pool_block_t;
+
+typedef struct {
+	size_t size[POOL_CLASSES];         //!< usable bytes of a block, ascending
+	pool_block_t *free[POOL_CLASSES];  //!< free blocks of each size
+	uint_fast8_t classes;
+	unsigned long misses;              //!< allocations without a free block
+} pool_t;
+
+#ifdef CONFIG_ARENA
+void arena_init(arena_t *a, void *mem, size_t size);
+void *arena_alloc(arena_t *a, size_t size);
+size_t arena_mark(const arena_t *a);
+void arena_release(arena_t *a, size_t mark);
+#ifndef __AVR__
+arena_t *arena_thread(void);
+#endif
+void pool_init(pool_t *p);
+int pool_add(pool_t *p, arena_t *a, size_t size, unsigned int count);
+int pool_add_chain(pool_t *p, arena_t *a, const bytecodec_chain_t *chain, unsigned int count);
+void *pool_alloc(pool_t *p, size_t size);
+void pool_free(pool_t *p, void *buf);
+#endif
+
+#endif
@@ -0,0 +1,294 @@
+//! Batch decoding of many captures
+
+//! @file batch.c
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "config.h"
+#ifdef CONFIG_BATCH
+#include <pthread.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#endif
+#include "helper.h"
+#include "batch.h"
+#include "deframer.h"
+#include "wav_map.h"
+
+
+#ifdef CONFIG_BATCH
+typedef struct batch_shared_s batch_shared_t;
+
+typedef struct {
+	_Atomic uint64_t range;          //!< next job in the low word, end of the range in the high word
+	uint8_t pad[64 - sizeof(uint64_t)]; //!< the ranges of two workers do not share a cache line
+	batch_shared_t *s;
+	int index;
+	deframer_t d;
+	uint8_t *frame_buf;              //!< on air and decoded frame of the deframer
+	uint8_t *scratch;                //!< frames of the job, an int length followed by the frame
+	size_t scratch_len;
+	size_t used;
+	int frames;
+	bool overflow;                   //!< the scratch space could not grow
+	unsigned long steals;
+} batch_worker_t;
+
+struct batch_shared_s {
+	batch_t *b;
+	batch_job_t *jobs;
+	long num_jobs;
+	int workers;
+	batch_worker_t *w;
+	pthread_mutex_t lock;            //!< protects next, the kept results and the counts of workers
+	pthread_cond_t moved;            //!< next has advanced
+	long next;                       //!< job to report next
+	size_t held;                     //!< bytes of the kept results
+	int live;                        //!< running workers
+	int waiting;                     //!< workers waiting for next to advance
+	uint8_t **result;                //!< frames of jobs finished before their turn
+	size_t *result_len;
+	bool *ready;
+};
+
+
+//! both ends of a range in one word
+static uint64_t batch_range(uint64_t lo, uint64_t hi)
+{
+	return((hi << 32) | lo);
+}
+
+
+//! get the next job, from the own range or stolen from another worker
+
+//! @param w worker
+//! @param job set to the job
+//! @return false when all jobs are taken
+static bool batch_take(batch_worker_t *w, long *job)
+{
+	batch_shared_t *s = w->s;
+	batch_worker_t *v;
+	uint64_t r, lo, hi, mid;
+	int k;
+	r = atomic_load(&w->range);
+	while((lo = r & 0xFFFFFFFFUL) < (hi = r >> 32)) {
+		if(atomic_compare_exchange_weak(&w->range, &r, batch_range(lo + 1, hi))) {
+			*job = lo;
+			return(true);
+		}
+	}
+	//take the back half of another range, the first job of it at once
+	for(k=1;k<s->workers;k++) {
+		v = &s->w[(w->index + k) % s->workers];
+		r = atomic_load(&v->range);
+		while((lo = r & 0xFFFFFFFFUL) < (hi = r >> 32)) {
+			mid = lo + (hi - lo) / 2;
+			if(atomic_compare_exchange_weak(&v->range, &r, batch_range(lo, mid))) {
+				atomic_store(&w->range, batch_range(mid + 1, hi));
+				w->steals++;
+				*job = mid;
+				return(true);
+			}
+		}
+	}
+	return(false);
+}
+
+
+//! deframer callback, keeps a frame in the scratch space
+static void batch_frame(void *ctx, const deframer_frame_t *frame)
+{
+	batch_worker_t *w = ctx;
+	size_t need = w->used + sizeof(int) + frame->len, len;
+	uint8_t *scratch;
+	if(need > w->scratch_len) {
+		len = (2 * w->scratch_len > need) ? 2 * w->scratch_len : need;
+		scratch = realloc(w->scratch, len);
+		if(!scratch) {
+			w->overflow = true;
+			return;
+		}
+		w->scratch = scratch;
+		w->scratch_len = len;
+	}
+	memcpy(w->scratch + w->used, &frame->len, sizeof(int));
+	memcpy(w->scratch + w->used + sizeof(int), frame->data, frame->len);
+	w->used = need;
+	w->frames++;
+}
+
+
+//! hand the frames of a job to the callback
+static void batch_emit(batch_shared_t *s, long job, const uint8_t *frames, size_t len)
+{
+	size_t pos;
+	int n;
+	for(pos=0;pos<len;pos+=sizeof(int)+n) {
+		memcpy(&n, frames + pos, sizeof(int));
+		if(s->b->cb)
+			s->b->cb(s->b->ctx, job, frames + pos + sizeof(int), n);
+	}
+	if(s->b->cb)
+		s->b->cb(s->b->ctx, job, NULL, 0);
+}
+
+
+//! report a finished job and the kept ones after it which are ready
+
+//! a job finished early waits while more than BATCH_HELD_MAX bytes would be
+//! kept, unless all other workers are waiting: the job next in line is then
+//! still to be taken by this worker, from its own range or a stolen one
+static void batch_finish(batch_worker_t *w, long job)
+{
+	batch_shared_t *s = w->s;
+	uint8_t *copy = NULL;
+	long next;
+	pthread_mutex_lock(&s->lock);
+	next = s->next;
+	while(job != s->next && s->held + w->used > BATCH_HELD_MAX && s->waiting + 1 < s->live) {
+		s->waiting++;
+		pthread_cond_wait(&s->moved, &s->lock);
+		s->waiting--;
+	}
+	if(job == s->next) {
+		batch_emit(s, job, w->scratch, w->used);
+		s->next++;
+	} else {
+		//keep a copy, the scratch space is needed for the next job
+		s->held += w->used;
+		pthread_mutex_unlock(&s->lock);
+		if(w->used) {
+			copy = malloc(w->used);
+			if(copy)
+				memcpy(copy, w->scratch, w->used);
+			else
+				s->jobs[job].error = true;
+		}
+		pthread_mutex_lock(&s->lock);
+		if(!copy)
+			s->held -= w->used;
+		s->result[job] = copy;
+		s->result_len[job] = copy ? w->used : 0;
+		s->ready[job] = true;
+	}
+	while(s->next < s->num_jobs && s->ready[s->next]) {
+		batch_emit(s, s->next, s->result[s->next], s->result_len[s->next]);
+		s->held -= s->result_len[s->next];
+		free(s->result[s->next]);
+		s->result[s->next] = NULL;
+		s->next++;
+	}
+	if(s->next != next)
+		pthread_cond_broadcast(&s->moved);
+	pthread_mutex_unlock(&s->lock);
+}
+
+
+//! thread of a worker
+static void *batch_worker(void *arg)
+{
+	batch_worker_t *w = arg;
+	batch_shared_t *s = w->s;
+	batch_job_t *j;
+	unsigned long failures;
+	wav_map_t m;
+	long job;
+	while(batch_take(w, &job)) {
+		j = &s->jobs[job];
+		j->frames = 0;
+		j->failures = 0;
+		j->error = false;
+		w->used = 0;
+		w->frames = 0;
+		w->overflow = false;
+		deframer_reset(&w->d);
+		failures = w->d.failures;
+		if(!j->filename) {
+			deframer_push(&w->d, j->buf, j->len);
+		} else if(!wav_map_open_raw(&m, j->filename, WAV_MAP_SEQUENTIAL, WAV_UINT8, 1, 0)) {
+			deframer_push(&w->d, m.samples, m.frames);
+			wav_map_close(&m);
+		} else {
+			j->error = true;
+		}
+		j->frames = w->frames;
+		j->failures = w->d.failures - failures;
+		j->error |= w->overflow;
+		batch_finish(w, job);
+	}
+	return(NULL);
+}
+
+
+//! decode a list of chip streams
+
+//! the calling thread is one of the workers, if threads can not be started
+//! the others take over their jobs
+//! @param b chain, amount of workers and callback
+//! @param jobs streams, get the amount of frames and failures
+//! @param num_jobs amount of jobs (up to 2^32 - 1)
+//! @return 0 on success, -1 on invalid parameters or when out of memory
+int batch_run(batch_t *b, batch_job_t *jobs, long num_jobs)
+{
+	pthread_t thread[BATCH_MAX_WORKERS];
+	bool started[BATCH_MAX_WORKERS] = {false};
+	batch_shared_t s;
+	int i, e = 0, buf_len = b->chain->dec_buf_len + 1;
+	memset(&s, 0, sizeof(s));
+	if(num_jobs < 0 || (uint64_t)num_jobs > 0xFFFFFFFFUL)
+		return(-1);
+	s.b = b;
+	s.jobs = jobs;
+	s.num_jobs = num_jobs;
+	s.workers = (b->workers > 0) ? b->workers : (int)sysconf(_SC_NPROCESSORS_ONLN);
+	s.workers = max(1, min(s.workers, BATCH_MAX_WORKERS));
+	s.workers = (int)max(1, min(s.workers, num_jobs));
+	s.w = calloc(s.workers, sizeof(*s.w));
+	s.result = calloc(num_jobs + 1, sizeof(*s.result));
+	s.result_len = calloc(num_jobs + 1, sizeof(*s.result_len));
+	s.ready = calloc(num_jobs + 1, sizeof(*s.ready));
+	e = !s.w || !s.result || !s.result_len || !s.ready;
+	for(i=0;i<s.workers && !e;i++) {
+		s.w[i].s = &s;
+		s.w[i].index = i;
+		s.w[i].frame_buf = malloc(2 * buf_len);
+		s.w[i].scratch = malloc(BATCH_SCRATCH);
+		s.w[i].scratch_len = BATCH_SCRATCH;
+		atomic_init(&s.w[i].range, batch_range((uint64_t)num_jobs * i / s.workers, (uint64_t)num_jobs * (i + 1) / s.workers));
+		e = !s.w[i].frame_buf || !s.w[i].scratch;
+		e = e || deframer_init(&s.w[i].d, b->chain, s.w[i].frame_buf, s.w[i].frame_buf + buf_len, buf_len, batch_frame, &s.w[i]);
+	}
+	b->steals = 0;
+	if(!e) {
+		pthread_mutex_init(&s.lock, NULL);
+		pthread_cond_init(&s.moved, NULL);
+		s.live = s.workers;
+		for(i=1;i<s.workers;i++) {
+			started[i] = !pthread_create(&thread[i], NULL, batch_worker, &s.w[i]);
+			if(!started[i]) {
+				pthread_mutex_lock(&s.lock);
+				s.live--;
+				pthread_mutex_unlock(&s.lock);
+			}
+		}
+		batch_worker(&s.w[0]);
+		for(i=1;i<s.workers;i++) {
+			if(started[i])
+				pthread_join(thread[i], NULL);
+		}
+		pthread_cond_destroy(&s.moved);
+		pthread_mutex_destroy(&s.lock);
+	}
+	for(i=0;s.w && i<s.workers;i++) {
+		b->steals += s.w[i].steals;
+		free(s.w[i].frame_buf);
+		free(s.w[i].scratch);
+	}
+	free(s.w);
+	free(s.result);
+	free(s.result_len);
+	free(s.ready);
+	return(e ? -1 : 0);
+}
+#endif //CONFIG_BATCH
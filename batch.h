@@ -0,0 +1,66 @@
+//! Batch decoding of many captures
+
+//! @file batch.h
+//!
+//! Runs a deframer with a bytecodec chain (line code, length, CRC, ...) over
+//! a list of chip streams, from memory or from files, on a pool of threads.
+//! Every worker owns a range of the jobs and takes them from the front,
+//! a worker without jobs steals the back half of the range of another one,
+//! so files of different sizes still keep all cores busy. Both ends of a
+//! range are one 64 bit word, taking and stealing are a compare and swap.
+//!
+//! Every worker has its own deframer and scratch space for the collected
+//! frames, allocated once and reused for every job, files are mapped. The
+//! frames are handed to the callback in the order of the jobs: a job which
+//! is next in line is reported straight from the scratch space of its
+//! worker, a job finished early is copied and waits for the ones before it.
+//! The copies are capped at BATCH_HELD_MAX bytes, above it a worker waits
+//! with its frames until the jobs before its own are reported. The last
+//! worker which is not waiting never does, it takes over the jobs of
+//! threads which could not be started.
+//!
+//! The stream format is the one of the deframer, chips packed LSB first.
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "config.h"
+#include "bytecoder.h"
+
+#define BATCH_MAX_WORKERS 64
+#define BATCH_SCRATCH 4096   //!< initial bytes of frame scratch space per worker, grows when needed
+#define BATCH_HELD_MAX (16UL << 20) //!< bytes of frames kept for jobs finished before their turn
+
+//! result callback, called in the order of the jobs
+
+//! @param ctx as given in batch_t
+//! @param job index of the job
+//! @param frame decoded frame, NULL once all frames of the job are reported
+//! @param len length of frame
+typedef void (*batch_cb_t)(void *ctx, long job, const uint8_t *frame, int len);
+
+typedef struct {
+	const char *filename;   //!< chip stream file, NULL for buf
+	const uint8_t *buf;     //!< chip stream in memory
+	size_t len;             //!< bytes at buf
+	int frames;             //!< valid frames, set by batch_run()
+	int failures;           //!< frames failing length, line code or crc check
+	bool error;             //!< the file could not be mapped or the frames not kept
+} batch_job_t;
+
+typedef struct {
+	const bytecodec_chain_t *chain; //!< chain in encoding order, planned with bc_chain_plan()
+	int workers;                    //!< threads, 0 for one per online CPU
+	batch_cb_t cb;
+	void *ctx;
+	unsigned long steals;           //!< ranges taken from other workers, set by batch_run()
+} batch_t;
+
+#ifdef CONFIG_BATCH
+int batch_run(batch_t *b, batch_job_t *jobs, long num_jobs);
+#endif
+
+#endif
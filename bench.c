@@ -0,0 +1,513 @@
+//! Throughput benchmark of the coding kernels
+
+//! @file bench.c
+//!
+//! Every kernel runs for at least BENCH_TIME, the throughput is given in MB/s
+//! of unencoded data. Run with make bench.
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "config.h"
+#include "helper.h"
+#include "manchester.h"
+#include "crc.h"
+#include "deframer.h"
+#include "conv.h"
+#include "fec.h"
+#include "interleave.h"
+#include "pcm.h"
+#include "nco.h"
+#include "fsk.h"
+#include "fir.h"
+#include "slicer.h"
+#include "capture.h"
+#include "pin.h"
+#include "bits.h"
+#include "batch.h"
+
+#define BENCH_LEN 4096                     //!< unencoded bytes per run
+#define BENCH_TIME (CLOCKS_PER_SEC / 2)    //!< minimum time per kernel
+
+
+static uint8_t bench_data[BENCH_LEN];                   //!< unencoded data
+static uint8_t bench_enc[CONV_ENC_LEN(BENCH_LEN)];      //!< encoded data of the kernel
+static uint8_t bench_soft[CONV_ENC_LEN(BENCH_LEN) * 8]; //!< soft symbols of the convolutional code
+static uint8_t bench_buf[CONV_ENC_LEN(BENCH_LEN) * 8];  //!< work buffer
+
+
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC)
+static void bench_manchester_encode(void)
+{
+	memcpy(bench_buf, bench_data, BENCH_LEN);
+	manchester_encode_buf(bench_buf, BENCH_LEN);
+}
+#endif
+
+
+#if defined(CONFIG_MANCHESTER_FIXED) && defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC) && defined(CONFIG_MANCHESTER_DEC)
+//! BENCH_LEN bytes as frames of 64 bytes
+static void bench_manchester_encode_64(void)
+{
+	int i;
+	for(i=0;i<BENCH_LEN;i+=64)
+		manchester_encode_fixed(64, bench_buf + (i << 1), bench_data + i, false);
+}
+
+
+static void bench_manchester_decode_64(void)
+{
+	int i;
+	for(i=0;i<BENCH_LEN;i+=64)
+		manchester_decode_fixed(64, bench_buf + i, bench_enc + (i << 1), false);
+}
+#endif
+
+
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_DEC)
+static void bench_manchester_decode(void)
+{
+	memcpy(bench_buf, bench_enc, BENCH_LEN * 2);
+	manchester_decode_buf(bench_buf, BENCH_LEN * 2);
+}
+#endif
+
+
+#ifdef CONFIG_CONV
+static void bench_conv_encode(void)
+{
+	conv_encode_buf(bench_buf, bench_data, BENCH_LEN);
+}
+
+
+static void bench_conv_decode(void)
+{
+	memcpy(bench_buf, bench_enc, CONV_ENC_LEN(BENCH_LEN));
+	conv_decode_buf(bench_buf, CONV_ENC_LEN(BENCH_LEN));
+}
+
+
+static void bench_conv_decode_soft(void)
+{
+	conv_decode_soft(bench_buf, bench_soft, BENCH_LEN);
+}
+#endif
+
+
+//! frame of the deframer, the sync word errors are set by the prepare functions
+static bytecodec_t bench_frame_codecs[] = {
+	{BYTECODEC_CRC16, {0, CRC16_INIT, 0}, NULL},
+	{BYTECODEC_ENCODED_LENGTH, {0, 0, 0}, NULL},
+	{BYTECODEC_MANCHESTER_GE_THOMAS, {0, 0, 0}, NULL},
+	{BYTECODEC_SYNC_WORD, {0x2DD4, 2, 0}, NULL},
+	{BYTECODEC_PREAMBLE, {0xAA, 4, 0}, NULL}
+};
+static bytecodec_chain_t bench_frame_chain = {bench_frame_codecs, sizeof(bench_frame_codecs)/sizeof(bench_frame_codecs[0]), 0, 0, 0, 0};
+static deframer_t bench_deframer;
+static uint8_t bench_deframer_buf[2][256];
+
+
+static void bench_deframer_cb(void *ctx, const deframer_frame_t *frame)
+{
+	(void)ctx;
+	(void)frame;
+}
+
+
+//! hunt for the sync word in BENCH_LEN bytes of noise
+static void bench_deframer_push(void)
+{
+	deframer_push(&bench_deframer, bench_data, BENCH_LEN);
+}
+
+
+static void bench_prepare_deframer(int sync_errors)
+{
+	bench_frame_codecs[3].opt[2] = sync_errors;
+	bc_chain_plan(&bench_frame_chain, 100);
+	deframer_init(&bench_deframer, &bench_frame_chain, bench_deframer_buf[0], bench_deframer_buf[1], sizeof(bench_deframer_buf[0]), bench_deframer_cb, NULL);
+}
+
+
+static void bench_prepare_deframer_exact(void)
+{
+	bench_prepare_deframer(0);
+}
+
+
+static void bench_prepare_deframer_1(void)
+{
+	bench_prepare_deframer(1);
+}
+
+
+#ifdef CONFIG_BATCH
+#define BENCH_BATCH_JOBS 64
+#define BENCH_BATCH_LEN (1L << 16) //!< chip stream bytes per job
+static uint8_t bench_batch_stream[BENCH_BATCH_LEN];
+static batch_job_t bench_batch_jobs[BENCH_BATCH_JOBS];
+
+
+//! noise with a frame of 16 bytes every KB, every job decodes the same stream
+static void bench_prepare_batch(void)
+{
+	uint8_t frame[256];
+	long i;
+	int j, len;
+	bench_prepare_deframer_exact();
+	for(i=0;i<BENCH_BATCH_LEN;i++)
+		bench_batch_stream[i] = rand();
+	for(i=0;i+(long)sizeof(frame)<=BENCH_BATCH_LEN;i+=1024) {
+		for(j=0;j<16;j++)
+			frame[j] = i + j;
+		len = bc_encode_chain(&bench_frame_chain, frame, 16);
+		memcpy(bench_batch_stream + i, frame, len);
+	}
+	for(j=0;j<BENCH_BATCH_JOBS;j++) {
+		bench_batch_jobs[j].buf = bench_batch_stream;
+		bench_batch_jobs[j].len = BENCH_BATCH_LEN;
+	}
+}
+
+
+//! batch_run() over BENCH_BATCH_JOBS streams, MB/s of chip stream by wall clock time
+
+//! @param workers threads, 0 for one per online CPU
+static void bench_batch(int workers)
+{
+	batch_t b = {&bench_frame_chain, workers, NULL, NULL, 0};
+	struct timespec start, now;
+	char name[32];
+	double t;
+	long runs = 0;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	do {
+		batch_run(&b, bench_batch_jobs, BENCH_BATCH_JOBS);
+		runs++;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		t = (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1e9;
+	} while(t < (double)BENCH_TIME / CLOCKS_PER_SEC);
+	if(workers)
+		snprintf(name, sizeof(name), "batch_run (%d worker%s)", workers, (workers > 1) ? "s" : "");
+	else
+		snprintf(name, sizeof(name), "batch_run (online CPUs)");
+	printf("%-28s %8.2f MB/s\n", name, (double)runs * BENCH_BATCH_JOBS * BENCH_BATCH_LEN / t / 1e6);
+}
+#endif
+
+
+#ifdef CONFIG_REED_SOLOMON
+//! 32 syndromes of the blocks of RS_BLOCK_LEN bytes in BENCH_LEN
+static void bench_rs_syndromes(void)
+{
+	int i;
+	for(i=0;i+RS_BLOCK_LEN<=BENCH_LEN;i+=RS_BLOCK_LEN)
+		rs_syndromes(32, bench_data + i, RS_BLOCK_LEN, bench_buf + i);
+}
+#endif
+
+
+#ifdef CONFIG_INTERLEAVE
+static void bench_interleave_block(void)
+{
+	interleave_block_buf(bench_buf, bench_data, 64, 512, BENCH_LEN, false);
+}
+
+
+static void bench_interleave_conv(void)
+{
+	interleave_conv_encode(bench_buf, bench_data, 16, BENCH_LEN);
+}
+#endif
+
+
+#ifdef CONFIG_PCM
+static pcm_t bench_pcm;
+static const bytecodec_t bench_manchester = {BYTECODEC_MANCHESTER_GE_THOMAS, {0, 0, 0}, NULL};
+
+
+//! 8 samples per chip, so the payload is done in pieces which fit bench_buf
+static void bench_pcm_int16(void)
+{
+	int i;
+	for(i=0;i<BENCH_LEN;i+=BENCH_LEN/32)
+		pcm_modulate_int16(&bench_pcm, (int16_t *)bench_buf, bench_data + i, BENCH_LEN / 32);
+}
+
+
+static void bench_prepare_pcm(void)
+{
+	pcm_init(&bench_pcm, &bench_manchester, 8, 2, 0.8);
+}
+#endif
+
+
+#ifdef CONFIG_NCO
+//! BENCH_LEN bytes of int16 samples
+static void bench_nco_int16(void)
+{
+	static nco_t n = {0, 0x0253c825UL};
+	nco_int16(&n, (int16_t *)bench_buf, BENCH_LEN / sizeof(int16_t), 32000);
+}
+#endif
+
+
+#ifdef CONFIG_FSK
+static fsk_t bench_fsk;
+
+
+//! 8 samples per bit, so the payload is done in pieces which fit bench_buf
+static void bench_fsk_int16(void)
+{
+	int i;
+	for(i=0;i<BENCH_LEN;i+=BENCH_LEN/16)
+		fsk_modulate_int16(&bench_fsk, (int16_t *)bench_buf, bench_data + i, BENCH_LEN / 16);
+}
+
+
+static void bench_prepare_fsk(void)
+{
+	fsk_init(&bench_fsk, FSK_GFSK, 8, 0.5, 25000, 100000, 400000, 0.8);
+}
+#endif
+
+
+#ifdef CONFIG_FIR
+static fir_t bench_fir;
+
+
+//! BENCH_LEN bytes of int16 samples through 64 taps, decimation 4
+static void bench_fir_int16(void)
+{
+	fir_int16(&bench_fir, (int16_t *)bench_buf, (const int16_t *)bench_data, BENCH_LEN / sizeof(int16_t));
+}
+
+
+static void bench_prepare_fir(void)
+{
+	float taps[64];
+	fir_lowpass(taps, 64, 50000, 1000000);
+	fir_init(&bench_fir, taps, 64, 4);
+}
+#endif
+
+
+#if defined(CONFIG_SLICER) && defined(CONFIG_PCM)
+static slicer_t bench_slicer;
+static int16_t bench_chips[BENCH_LEN / sizeof(int16_t)]; //!< manchester at 8 samples per chip
+
+
+//! BENCH_LEN bytes of int16 samples
+static void bench_slicer_int16(void)
+{
+	slicer_int16(&bench_slicer, bench_buf, bench_chips, BENCH_LEN / sizeof(int16_t));
+}
+
+
+static void bench_prepare_slicer(void)
+{
+	static pcm_t p;
+	pcm_init(&p, &bench_manchester, 8, 4, 0.5);
+	pcm_modulate_int16(&p, bench_chips, bench_data, BENCH_LEN / sizeof(int16_t) / 128);
+	slicer_init(&bench_slicer, 8, 0.05);
+}
+#endif
+
+
+//! run a kernel and print its throughput
+
+//! @param name name of the kernel
+//! @param kernel function doing one run over BENCH_LEN bytes
+//! @param prepare function filling bench_enc / bench_soft, or NULL
+static void bench_run(const char *name, void (*kernel)(void), void (*prepare)(void))
+{
+	clock_t start, t;
+	long runs = 0;
+	if(prepare)
+		prepare();
+	start = clock();
+	do {
+		kernel();
+		runs++;
+		t = clock() - start;
+	} while(t < BENCH_TIME);
+	printf("%-28s %8.2f MB/s\n", name, (double)runs * BENCH_LEN * CLOCKS_PER_SEC / t / 1e6);
+}
+
+
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC)
+static void bench_prepare_manchester(void)
+{
+	memcpy(bench_enc, bench_data, BENCH_LEN);
+	manchester_encode_buf(bench_enc, BENCH_LEN);
+}
+#endif
+
+
+#ifdef CONFIG_CONV
+static void bench_prepare_conv(void)
+{
+	int i;
+	conv_encode_buf(bench_enc, bench_data, BENCH_LEN);
+	for(i=0;i<CONV_ENC_LEN(BENCH_LEN)*8;i++)
+		bench_soft[i] = READ_BIT(bench_enc[i>>3], i & 7) ? 192 : 64;
+}
+#endif
+
+
+
+#if defined(__linux__) && defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC)
+static uint32_t bench_edges[BENCH_LEN * 16 + 1]; //!< manchester edge log, 50 us chips
+static long bench_edges_len;
+static long bench_highs;                          //!< high pulses in the log
+
+
+//! get_pulse_length() over a replayed edge log on a virtual pin
+static void bench_pin_host(void)
+{
+	long i;
+	pin_host_reset();
+	pin_host_edges(PIN_HOST_0, bench_edges, bench_edges_len, bench_enc[0] & 1 ? PIN_STATE_LOW : PIN_STATE_HIGH, cycles_per_ms());
+	for(i=0;i<bench_highs;i++)
+		get_pulse_length(PIN_HOST_0, PIN_STATE_HIGH, 1000);
+}
+
+
+static void bench_prepare_pin_host(void)
+{
+	long i, run = 1;
+	bench_prepare_manchester();
+	bench_edges_len = 1;
+	bench_highs = 0;
+	for(i=1;i<=BENCH_LEN*16;i++) {
+		if(i < BENCH_LEN*16 && READ_BIT(bench_enc[i>>3], i & 7) == READ_BIT(bench_enc[(i-1)>>3], (i-1) & 7)) {
+			run++;
+			continue;
+		}
+		bench_edges[bench_edges_len] = bench_edges[bench_edges_len-1] + run * 50;
+		bench_highs += READ_BIT(bench_enc[(i-1)>>3], (i-1) & 7);
+		bench_edges_len++;
+		run = 1;
+	}
+	bench_highs -= bench_enc[0] & 1; //a pulse which is high at the start is skipped
+}
+#endif
+
+
+#ifdef CONFIG_CAPTURE
+static capture_map_t bench_capture;
+static capture_cursor_t bench_cursor;
+
+
+//! seek and read BENCH_LEN bytes of time stamps from a mapped capture
+static void bench_capture_read(void)
+{
+	capture_seek(&bench_cursor, &bench_capture, 0);
+	capture_read(&bench_cursor, (uint32_t *)bench_buf, BENCH_LEN / sizeof(uint32_t), UINT64_MAX);
+}
+
+
+//! an edge every 50 - 305 ticks, the file is gone once the mapping is closed
+static void bench_prepare_capture(void)
+{
+	static capture_writer_t w;
+	uint64_t times[BENCH_LEN / sizeof(uint32_t)];
+	size_t i;
+	times[0] = 0;
+	for(i=1;i<BENCH_LEN/sizeof(uint32_t);i++)
+		times[i] = times[i-1] + 50 + bench_data[i];
+	if(capture_open(&w, "bench_capture.edg", 1000000, 1000000, false) || capture_append(&w, times, BENCH_LEN / sizeof(uint32_t))
+	   || capture_close(&w) || capture_map_open(&bench_capture, "bench_capture.edg"))
+		exit(1);
+	remove("bench_capture.edg");
+}
+#endif
+
+#ifdef CONFIG_BITS
+static uint64_t bench_bits_word[2][BITS_WORDS(BENCH_LEN * 16 + 64)];
+static bits_t bench_bits_in;
+
+
+//! manchester encode BENCH_LEN bytes starting at bit 3, 32 bits per step
+static void bench_bits_manchester(void)
+{
+	bits_t out;
+	bits_init(&out, bench_bits_word[1], BITS_WORDS(BENCH_LEN * 16 + 64));
+	bits_manchester_encode(&out, &bench_bits_in, false);
+}
+
+
+static void bench_prepare_bits(void)
+{
+	bits_t b;
+	bits_init(&b, bench_bits_word[0], BITS_WORDS(BENCH_LEN * 16 + 64));
+	bits_append(&b, 0, 3);
+	bits_append_bytes(&b, bench_data, BENCH_LEN);
+	bits_slice(&bench_bits_in, &b, 3, BENCH_LEN * 8);
+}
+#endif
+
+int main(void)
+{
+	int i;
+	for(i=0;i<BENCH_LEN;i++)
+		bench_data[i] = rand();
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC)
+	bench_run("manchester_encode_buf", bench_manchester_encode, NULL);
+#if defined(CONFIG_MANCHESTER_DEC)
+	bench_run("manchester_decode_buf", bench_manchester_decode, bench_prepare_manchester);
+#endif
+#endif
+#if defined(CONFIG_MANCHESTER_FIXED) && defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC) && defined(CONFIG_MANCHESTER_DEC)
+	bench_run("manchester_encode_64", bench_manchester_encode_64, NULL);
+	bench_run("manchester_decode_64", bench_manchester_decode_64, bench_prepare_manchester);
+#endif
+#ifdef CONFIG_BITS
+	bench_run("bits_manchester_encode", bench_bits_manchester, bench_prepare_bits);
+#endif
+#ifdef CONFIG_CONV
+	bench_run("conv_encode_buf", bench_conv_encode, NULL);
+	bench_run("conv_decode_buf", bench_conv_decode, bench_prepare_conv);
+	bench_run("conv_decode_soft", bench_conv_decode_soft, bench_prepare_conv);
+#endif
+	bench_run("deframer_push (exact sync)", bench_deframer_push, bench_prepare_deframer_exact);
+	bench_run("deframer_push (1 sync error)", bench_deframer_push, bench_prepare_deframer_1);
+#ifdef CONFIG_BATCH
+	bench_prepare_batch();
+	for(i=1;i<=8;i*=2)
+		bench_batch(i);
+	bench_batch(0);
+#endif
+#ifdef CONFIG_REED_SOLOMON
+	bench_run("rs_syndromes (32)", bench_rs_syndromes, NULL);
+#endif
+#ifdef CONFIG_PCM
+	bench_run("pcm_modulate_int16", bench_pcm_int16, bench_prepare_pcm);
+#endif
+#ifdef CONFIG_NCO
+	bench_run("nco_int16", bench_nco_int16, NULL);
+#endif
+#ifdef CONFIG_FSK
+	bench_run("fsk_modulate_int16", bench_fsk_int16, bench_prepare_fsk);
+#endif
+#ifdef CONFIG_FIR
+	bench_run("fir_int16", bench_fir_int16, bench_prepare_fir);
+#endif
+#if defined(CONFIG_SLICER) && defined(CONFIG_PCM)
+	bench_run("slicer_int16", bench_slicer_int16, bench_prepare_slicer);
+#endif
+#if defined(__linux__) && defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC)
+	bench_run("get_pulse_length (virtual)", bench_pin_host, bench_prepare_pin_host);
+#endif
+#ifdef CONFIG_CAPTURE
+	bench_run("capture_read", bench_capture_read, bench_prepare_capture);
+	capture_map_close(&bench_capture);
+#endif
+#ifdef CONFIG_INTERLEAVE
+	bench_run("interleave_block_buf", bench_interleave_block, NULL);
+	bench_run("interleave_conv_encode", bench_interleave_conv, NULL);
+#endif
+	return(0);
+}
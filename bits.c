@@ -0,0 +1,419 @@
+//! Bit streams in 64 bit words
+
+//! @file bits.c
+
+
+#include <string.h>
+#include "config.h"
+#include "helper.h"
+#include "bits.h"
+
+
+#ifdef CONFIG_BITS
+#define BITS_EVEN 0x5555555555555555ull
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define BITS_LITTLE_ENDIAN //!< the storage of a stream is its byte buffer
+#endif
+
+
+//! the lowest n bits (0 - 64)
+static uint64_t bits_mask(uint_fast8_t n)
+{
+	return((n >= 64) ? ~(uint64_t)0 : ((uint64_t)1 << n) - 1);
+}
+
+
+//! read n bits (0 - 64) at bit p of the storage
+static uint64_t bits_get(const uint64_t *word, size_t p, uint_fast8_t n)
+{
+	size_t i = p >> 6;
+	uint_fast8_t s = p & 63;
+	uint64_t w;
+	if(!n)
+		return(0);
+	w = word[i] >> s;
+	if(s && s + n > 64)
+		w |= word[i+1] << (64 - s);
+	return(w & bits_mask(n));
+}
+
+
+//! write n bits (0 - 64) at bit p of the storage
+static void bits_put(uint64_t *word, size_t p, uint64_t v, uint_fast8_t n)
+{
+	size_t i = p >> 6;
+	uint_fast8_t s = p & 63;
+	uint64_t m = bits_mask(n);
+	if(!n)
+		return;
+	v &= m;
+	word[i] = (word[i] & ~(m << s)) | (v << s);
+	if(s && s + n > 64)
+		word[i+1] = (word[i+1] & ~(m >> (64 - s))) | (v >> (64 - s));
+}
+
+
+//! make an empty stream
+
+//! @param b stream
+//! @param word storage
+//! @param words amount of words at word, see BITS_WORDS()
+void bits_init(bits_t *b, uint64_t *word, size_t words)
+{
+	b->word = word;
+	b->off = 0;
+	b->len = 0;
+	b->cap = words * 64;
+}
+
+
+//! empty a stream, keeping its storage
+void bits_clear(bits_t *b)
+{
+	b->len = 0;
+}
+
+
+//! append bits
+
+//! @param b stream
+//! @param value bits, the first one in the LSB
+//! @param n amount of bits (0 - 64)
+//! @return 0 on success, -1 if the storage is full
+int bits_append(bits_t *b, uint64_t value, uint_fast8_t n)
+{
+	if(n > 64 || b->off + b->len + n > b->cap)
+		return(-1);
+	bits_put(b->word, b->off + b->len, value, n);
+	b->len += n;
+	return(0);
+}
+
+
+//! append another stream or a view, 64 bits at a time
+
+//! @return 0 on success, -1 if the storage is full
+int bits_append_bits(bits_t *b, const bits_t *src)
+{
+	size_t i;
+	uint_fast8_t n;
+	if(b->off + b->len + src->len > b->cap)
+		return(-1);
+	for(i=0;i<src->len;i+=n) {
+		n = (src->len - i < 64) ? src->len - i : 64;
+		bits_put(b->word, b->off + b->len, bits_get(src->word, src->off + i, n), n);
+		b->len += n;
+	}
+	return(0);
+}
+
+
+//! append a byte buffer, 8 bytes at a time
+
+//! @return 0 on success, -1 if the storage is full
+int bits_append_bytes(bits_t *b, const uint8_t *buf, size_t len)
+{
+	size_t i;
+	uint_fast8_t j, n;
+	uint64_t w;
+	if(b->off + b->len + len * 8 > b->cap)
+		return(-1);
+	for(i=0;i<len;i+=n) {
+		n = (len - i < 8) ? len - i : 8;
+#ifdef BITS_LITTLE_ENDIAN
+		if(n == 8) {
+			memcpy(&w, buf + i, 8);
+		} else
+#endif
+		{
+			for(j=0,w=0;j<n;j++)
+				w |= (uint64_t)buf[i+j] << (j << 3);
+		}
+		bits_put(b->word, b->off + b->len, w, n << 3);
+		b->len += n << 3;
+	}
+	return(0);
+}
+
+
+//! read bits at any offset
+
+//! @param b stream
+//! @param pos bit of the stream
+//! @param n amount of bits (0 - 64), bits past the end of the stream are 0
+//! @return bits, the first one in the LSB
+uint64_t bits_peek(const bits_t *b, size_t pos, uint_fast8_t n)
+{
+	if(pos >= b->len)
+		return(0);
+	if(n > b->len - pos)
+		n = b->len - pos;
+	return(bits_get(b->word, b->off + pos, n));
+}
+
+
+//! make a view of a part of a stream
+
+//! the view shares the storage, writing to one changes the other
+//! @param view set to the part
+//! @param b stream
+//! @param pos first bit of the part
+//! @param len bits of the part
+//! @return 0 on success, -1 if the part is not in the stream
+int bits_slice(bits_t *view, const bits_t *b, size_t pos, size_t len)
+{
+	size_t p = b->off + pos;
+	if(pos > b->len || len > b->len - pos)
+		return(-1);
+	view->word = b->word + (p >> 6);
+	view->off = p & 63;
+	view->len = len;
+	view->cap = b->cap - (p & ~(size_t)63);
+	return(0);
+}
+
+
+//! copy bytes from any bit offset
+
+//! @param b stream
+//! @param pos first bit
+//! @param dest destination buffer
+//! @param len bytes to copy
+//! @return bytes copied, a last partial byte is filled up with zeroes
+size_t bits_copy_bytes(const bits_t *b, size_t pos, uint8_t *dest, size_t len)
+{
+	size_t i;
+	uint_fast8_t j, n;
+	uint64_t w;
+	if(pos >= b->len)
+		return(0);
+	if(len > (b->len - pos + 7) / 8)
+		len = (b->len - pos + 7) / 8;
+	for(i=0;i<len;i+=n) {
+		n = (len - i < 8) ? len - i : 8;
+		w = bits_peek(b, pos + (i << 3), n << 3);
+		for(j=0;j<n;j++)
+			dest[i+j] = READ_BYTE(w, j);
+	}
+	return(len);
+}
+
+
+//! byte buffer of a stream
+
+//! @return the first byte of the stream, NULL if it does not start on a byte boundary (or on big endian CPUs)
+uint8_t *bits_bytes(const bits_t *b)
+{
+#ifdef BITS_LITTLE_ENDIAN
+	if(!(b->off & 7))
+		return((uint8_t *)b->word + (b->off >> 3));
+#endif
+	(void)b;
+	return(NULL);
+}
+
+
+//! move a stream to bit 0 of its first word
+
+//! the storage is shared, bits in front of the stream in its first word are overwritten
+void bits_align(bits_t *b)
+{
+	size_t i;
+	uint_fast8_t n;
+	if(!b->off)
+		return;
+	//every word is read before it is written
+	for(i=0;i<b->len;i+=n) {
+		n = (b->len - i < 64) ? b->len - i : 64;
+		bits_put(b->word, i, bits_get(b->word, b->off + i, n), n);
+	}
+	b->off = 0;
+}
+
+
+//! manchester encode a stream, 32 bits at a time
+
+//! @param dest stream the chips are appended to, not src
+//! @param src data
+//! @param ieee IEEE802.3 convention, otherwise G.E. Thomas
+//! @return 0 on success, -1 if dest is full
+int bits_manchester_encode(bits_t *dest, const bits_t *src, bool ieee)
+{
+	size_t i;
+	uint_fast8_t n;
+	uint64_t x, w;
+	if(dest->off + dest->len + 2 * src->len > dest->cap)
+		return(-1);
+	for(i=0;i<src->len;i+=n) {
+		n = (src->len - i < 32) ? src->len - i : 32;
+		x = bits_get(src->word, src->off + i, n);
+		//a 1 is the chips 1 then 0, a 0 is 0 then 1
+		w = spread_bits(x);
+		w |= (w ^ BITS_EVEN) << 1;
+		if(ieee)
+			w = ~w;
+		bits_put(dest->word, dest->off + dest->len, w, n << 1);
+		dest->len += n << 1;
+	}
+	return(0);
+}
+
+
+//! manchester decode a stream, 64 chips at a time
+
+//! @param dest stream the data is appended to, not src
+//! @param src chips
+//! @param ieee IEEE802.3 convention, otherwise G.E. Thomas
+//! @return 0 on success, -1 on invalid chips or if dest is full
+int bits_manchester_decode(bits_t *dest, const bits_t *src, bool ieee)
+{
+	size_t i;
+	uint_fast8_t n;
+	uint64_t w, even;
+	if((src->len & 1) || dest->off + dest->len + src->len / 2 > dest->cap)
+		return(-1);
+	for(i=0;i<src->len;i+=n) {
+		n = (src->len - i < 64) ? src->len - i : 64;
+		w = bits_get(src->word, src->off + i, n);
+		if(ieee)
+			w = ~w & bits_mask(n);
+		even = BITS_EVEN & bits_mask(n);
+		if(((w ^ (w >> 1)) & even) != even)
+			return(-1);
+		bits_put(dest->word, dest->off + dest->len, compress_bits(w), n >> 1);
+		dest->len += n >> 1;
+	}
+	return(0);
+}
+
+
+//! NRZI encode a stream, transition on 1, 64 bits at a time
+
+//! invert the data for transition on 0
+//! @param dest stream the chips are appended to, an empty view at the start of src codes in place
+//! @param src data
+//! @param prev level before the stream, set to the level after it
+//! @return 0 on success, -1 if dest is full
+int bits_nrzi_encode(bits_t *dest, const bits_t *src, bool *prev)
+{
+	size_t i, len = src->len, from = src->off;
+	const uint64_t *word = src->word;
+	uint_fast8_t n;
+	uint64_t w;
+	if(dest->off + dest->len + len > dest->cap)
+		return(-1);
+	for(i=0;i<len;i+=n) {
+		n = (len - i < 64) ? len - i : 64;
+		w = prefix_xor(bits_get(word, from + i, n)) ^ (0 - (uint64_t)*prev);
+		*prev = (w >> (n - 1)) & 1;
+		bits_put(dest->word, dest->off + dest->len, w, n);
+		dest->len += n;
+	}
+	return(0);
+}
+
+
+//! NRZI decode a stream, transition = 1, 64 bits at a time
+
+//! @param dest stream the data is appended to, an empty view at the start of src codes in place
+//! @param src chips
+//! @param prev level before the stream, set to the level after it
+//! @return 0 on success, -1 if dest is full
+int bits_nrzi_decode(bits_t *dest, const bits_t *src, bool *prev)
+{
+	size_t i, len = src->len, from = src->off;
+	const uint64_t *word = src->word;
+	uint_fast8_t n;
+	uint64_t w;
+	if(dest->off + dest->len + len > dest->cap)
+		return(-1);
+	for(i=0;i<len;i+=n) {
+		n = (len - i < 64) ? len - i : 64;
+		w = bits_get(word, from + i, n);
+		bits_put(dest->word, dest->off + dest->len, w ^ ((w << 1) | *prev), n);
+		*prev = (w >> (n - 1)) & 1;
+		dest->len += n;
+	}
+	return(0);
+}
+
+
+//! byte buffer of a stream for a chain, filled up to whole bytes
+
+//! @return NULL if the stream does not start on a byte boundary, the storage is too small or on big endian CPUs
+static uint8_t *bits_chain_bytes(bits_t *b, int buf_len)
+{
+	if(b->off & 7)
+		return(NULL);
+	if((size_t)buf_len * 8 > b->cap - b->off)
+		return(NULL);
+	if(b->len & 7)
+		bits_put(b->word, b->off + b->len, 0, 8 - (b->len & 7));
+	return(bits_bytes(b));
+}
+
+
+//! run a chain on a stream, in place or through a scratch buffer
+
+//! @param scratch NULL to code in place, else the stream is copied to it and the result back
+static int bits_chain(const bytecodec_chain_t *codec_chain, bits_t *b, uint8_t *scratch, bool encode)
+{
+	int buf_len = encode ? codec_chain->enc_buf_len : codec_chain->dec_buf_len;
+	uint8_t *buf = scratch;
+	uint64_t w;
+	size_t i;
+	int j, n, len = (b->len + 7) >> 3;
+	if(!scratch && !(buf = bits_chain_bytes(b, buf_len)))
+		return(-1);
+	if(scratch)
+		bits_copy_bytes(b, 0, scratch, len);
+	len = encode ? bc_encode_chain(codec_chain, buf, len) : bc_decode_chain(codec_chain, buf, len);
+	if(len < 0)
+		return(-1);
+	if(scratch) {
+		//only the result is written, the bits in front of the stream are kept
+		if(b->off + (size_t)len * 8 > b->cap)
+			return(-1);
+		for(i=0;i<(size_t)len;i+=n) {
+			n = (len - i < 8) ? len - i : 8;
+			for(j=0,w=0;j<n;j++)
+				w |= (uint64_t)scratch[i+j] << (j << 3);
+			bits_put(b->word, b->off + (i << 3), w, n << 3);
+		}
+	}
+	b->len = (size_t)len << 3;
+	return(0);
+}
+
+
+//! encode a stream with a chain of codecs
+
+//! Without scratch buffer the stream is coded in place: it has to start on a
+//! byte boundary, it is not moved, and the CPU has to be little endian as the
+//! storage is the byte buffer of the chain, which is written up to its length.
+//! With a scratch buffer the stream is copied to it, coded and only the result
+//! is written back at the start of the stream, at any bit offset and on any
+//! CPU. A last partial byte is filled up with zeroes.
+//! @param codec_chain chain planned with bc_chain_plan()
+//! @param b stream, its storage needs codec_chain->enc_buf_len bytes from the start of the stream in place
+//! @param scratch codec_chain->enc_buf_len bytes, or NULL
+//! @return 0 on success, -1 on error, if the storage is too small or the stream can not be coded in place
+int bits_encode_chain(const bytecodec_chain_t *codec_chain, bits_t *b, uint8_t *scratch)
+{
+	return(bits_chain(codec_chain, b, scratch, true));
+}
+
+
+//! decode a stream with a chain of codecs
+
+//! in place or through a scratch buffer, see bits_encode_chain()
+//! @param codec_chain chain planned with bc_chain_plan()
+//! @param b stream, its storage needs codec_chain->dec_buf_len bytes from the start of the stream in place
+//! @param scratch codec_chain->dec_buf_len bytes, or NULL
+//! @return 0 on success, -1 on error, if the storage is too small or the stream can not be coded in place
+int bits_decode_chain(const bytecodec_chain_t *codec_chain, bits_t *b, uint8_t *scratch)
+{
+	return(bits_chain(codec_chain, b, scratch, false));
+}
+#endif //CONFIG_BITS
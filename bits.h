@@ -0,0 +1,65 @@
+//! Bit streams in 64 bit words
+
+//! @file bits.h
+//!
+//! A bit stream of any length, not only whole bytes, kept in 64 bit words:
+//! bit n of the stream is bit n % 64 of word n / 64, the first bit is the
+//! LSB like in the byte buffers of the codecs. On little endian CPUs the
+//! storage of a stream starting on a byte boundary is the byte buffer of
+//! the same stream, bits_bytes() hands it to the byte codecs without a copy.
+//!
+//! Appending and reading work on up to 64 bits at any bit offset with two
+//! word accesses at most. A view (bits_slice()) is a part of a stream which
+//! shares its storage, it starts at any bit, nothing is copied or shifted.
+//!
+//! The bit line codes (Manchester, NRZI) code 32 or 64 bits per step from
+//! and to streams at any offset. The other line codes (differential
+//! Manchester, BMC, Miller, 4B5B, 8B10B) have no bit stream coder, they run
+//! in a bytecodec chain. bits_encode_chain() and bits_decode_chain() run a
+//! chain in place on the storage of a stream, which has to start on a byte
+//! boundary on a little endian CPU, the storage is written up to the buffer
+//! length of the chain. Given a scratch buffer they take any view on any CPU:
+//! the stream is copied to it and the result written back at the start of
+//! the view, the bits in front of it are kept. bits_align() moves a view to
+//! bit 0 and overwrites the bits in front of it in its first word. The
+//! storage is given by the caller, the streams never allocate.
+
+#ifndef BITS_H
+#define BITS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "config.h"
+#include "bytecoder.h"
+
+//! amount of words for a stream of n bits
+#define BITS_WORDS(n) (((n) + 63) / 64)
+
+typedef struct {
+	uint64_t *word;   //!< storage, shared by the views of a stream
+	size_t off;       //!< bit of word[0] the stream starts at (0 - 63)
+	size_t len;       //!< bits in the stream
+	size_t cap;       //!< bits of storage from bit 0 of word[0]
+} bits_t;
+
+#ifdef CONFIG_BITS
+void bits_init(bits_t *b, uint64_t *word, size_t words);
+void bits_clear(bits_t *b);
+int bits_append(bits_t *b, uint64_t value, uint_fast8_t n);
+int bits_append_bits(bits_t *b, const bits_t *src);
+int bits_append_bytes(bits_t *b, const uint8_t *buf, size_t len);
+uint64_t bits_peek(const bits_t *b, size_t pos, uint_fast8_t n);
+int bits_slice(bits_t *view, const bits_t *b, size_t pos, size_t len);
+size_t bits_copy_bytes(const bits_t *b, size_t pos, uint8_t *dest, size_t len);
+uint8_t *bits_bytes(const bits_t *b);
+void bits_align(bits_t *b);
+int bits_manchester_encode(bits_t *dest, const bits_t *src, bool ieee);
+int bits_manchester_decode(bits_t *dest, const bits_t *src, bool ieee);
+int bits_nrzi_encode(bits_t *dest, const bits_t *src, bool *prev);
+int bits_nrzi_decode(bits_t *dest, const bits_t *src, bool *prev);
+int bits_encode_chain(const bytecodec_chain_t *codec_chain, bits_t *b, uint8_t *scratch);
+int bits_decode_chain(const bytecodec_chain_t *codec_chain, bits_t *b, uint8_t *scratch);
+#endif
+
+#endif
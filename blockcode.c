@@ -0,0 +1,349 @@
+//! 4B5B and 8b/10b block line codes
+
+//! @file blockcode.c
+//!
+//! The code tables below are written in the notation of the standards
+//! (first transmitted bit is the MSB), the code words are reversed to stream
+//! order (first transmitted bit is the LSB) when they are put together.
+
+
+#include "blockcode.h"
+#if defined(CONFIG_4B5B_LOOKUP) || defined(CONFIG_8B10B_LOOKUP)
+#include "blockcode_lookup.h"
+#endif
+
+
+//! reverse the lowest n bits
+static uint_fast16_t blockcode_reverse(uint_fast16_t in, uint_fast8_t n)
+{
+	uint_fast16_t out=0;
+	uint_fast8_t i;
+	for(i=0;i<n;i++) {
+		if(READ_BIT(in, i))
+			SET_BIT(out, n - i - 1);
+	}
+	return(out);
+}
+
+
+//! put 10 bit symbols into a bit stream
+
+//! @param dest output (BLOCKCODE_ENC_LEN(n) bytes)
+//! @param sym symbols
+//! @param n amount of symbols (1-4)
+static void blockcode_pack(uint8_t *dest, const uint_fast16_t *sym, uint_fast8_t n)
+{
+	uint64_t acc=0;
+	uint_fast8_t i;
+	for(i=0;i<n;i++)
+		acc |= (uint64_t)sym[i] << (i * 10);
+	for(i=0;i<BLOCKCODE_ENC_LEN(n);i++)
+		dest[i] = READ_BYTE(acc, i);
+}
+
+
+//! read up to 5 bytes of a bit stream
+static uint64_t blockcode_unpack(const uint8_t *buf, uint_fast8_t len)
+{
+	uint64_t acc=0;
+	uint_fast8_t i;
+	for(i=0;i<len;i++)
+		acc |= (uint64_t)buf[i] << (i << 3);
+	return(acc);
+}
+
+
+#ifdef CONFIG_4B5B
+static const uint8_t fourb_fiveb_code[16] = {
+	0x1E, 0x09, 0x14, 0x15, 0x0A, 0x0B, 0x0E, 0x0F, //11110 01001 10100 10101 01010 01011 01110 01111
+	0x12, 0x13, 0x16, 0x17, 0x1A, 0x1B, 0x1C, 0x1D  //10010 10011 10110 10111 11010 11011 11100 11101
+};
+
+
+//! 4b5b encode a nibble
+
+//! @return 5 bit code word, first bit in LSB
+uint_fast8_t fourb_fiveb_encode_nibble(uint_fast8_t nibble)
+{
+	return(blockcode_reverse(fourb_fiveb_code[nibble & 0x0f], 5));
+}
+
+
+//! 4b5b decode a 5 bit code word
+
+//! @return nibble or error = -1
+int_fast8_t fourb_fiveb_decode_symbol(uint_fast8_t in)
+{
+	uint_fast8_t i;
+	in = blockcode_reverse(in, 5);
+	for(i=0;i<16;i++) {
+		if(fourb_fiveb_code[i] == in)
+			return(i);
+	}
+	return(-1);
+}
+
+
+//! 4b5b encode a byte, low nibble first
+
+//! @return 10 bit symbol
+uint_fast16_t fourb_fiveb_encode_byte(uint_fast8_t byte)
+{
+#ifdef CONFIG_4B5B_LOOKUP
+	return(fourb_fiveb_enc_lookup[byte]);
+#else
+	return(fourb_fiveb_encode_nibble(LOW_NIBBLE(byte)) | (fourb_fiveb_encode_nibble(HIGH_NIBBLE(byte)) << 5));
+#endif
+}
+
+
+//! 4b5b decode a 10 bit symbol
+
+//! @return byte or error = -1
+int_fast16_t fourb_fiveb_decode_byte(uint_fast16_t in)
+{
+#ifdef CONFIG_4B5B_LOOKUP
+	uint_fast16_t e = fourb_fiveb_dec_lookup[in & 0x3ff];
+	return((e >> 8) ? -1 : (int_fast16_t)e);
+#else
+	int_fast8_t lo = fourb_fiveb_decode_symbol(in & 0x1f), hi = fourb_fiveb_decode_symbol((in >> 5) & 0x1f);
+	if(lo < 0 || hi < 0)
+		return(-1);
+	return(lo | (hi << 4));
+#endif
+}
+
+
+//! 4b5b encode an array
+
+//! the buffer is encoded in place, therefore the buffer needs to be BLOCKCODE_ENC_LEN(len)
+//! @param buf input/output data
+//! @param len length of input data
+void fourb_fiveb_encode_buf(uint8_t *buf, int len)
+{
+	uint_fast16_t sym[4];
+	int g;
+	for(g=(len-1)>>2;g>=0;g--) {
+		uint_fast8_t i, n = min(4, len - (g << 2));
+		for(i=0;i<n;i++)
+			sym[i] = fourb_fiveb_encode_byte(buf[(g<<2)+i]);
+		blockcode_pack(buf + g * 5, sym, n);
+	}
+}
+
+
+//! 4b5b decode an array
+
+//! the buffer is decoded in place to BLOCKCODE_DEC_LEN(len) bytes
+//! invalid code words are decoded as 0
+//! @param buf input/output data
+//! @param len length of input data
+//! @return amount of invalid code words, 0 = ok
+int fourb_fiveb_decode_buf(uint8_t *buf, int len)
+{
+	int g, out_len = BLOCKCODE_DEC_LEN(len), errors=0;
+	for(g=0;(g<<2)<out_len;g++) {
+		uint_fast8_t i, n = min(4, out_len - (g << 2));
+		uint64_t acc = blockcode_unpack(buf + g * 5, min(5, len - g * 5));
+		for(i=0;i<n;i++) {
+#ifdef CONFIG_4B5B_LOOKUP
+			uint_fast16_t e = fourb_fiveb_dec_lookup[(acc >> (i * 10)) & 0x3ff];
+			errors += e >> 8;
+			buf[(g<<2)+i] = e;
+#else
+			int_fast16_t e = fourb_fiveb_decode_byte((acc >> (i * 10)) & 0x3ff);
+			errors += (e < 0);
+			buf[(g<<2)+i] = (e < 0) ? 0 : e;
+#endif
+		}
+	}
+	return(errors);
+}
+#endif //CONFIG_4B5B
+
+
+#ifdef CONFIG_8B10B
+//! 5b/6b, RD- and RD+ (abcdei)
+static const uint8_t eightb_tenb_5b6b[32][2] = {
+	{0x27, 0x18}, {0x1D, 0x22}, {0x2D, 0x12}, {0x31, 0x31}, //D.00-D.03
+	{0x35, 0x0A}, {0x29, 0x29}, {0x19, 0x19}, {0x38, 0x07}, //D.04-D.07
+	{0x39, 0x06}, {0x25, 0x25}, {0x15, 0x15}, {0x34, 0x34}, //D.08-D.11
+	{0x0D, 0x0D}, {0x2C, 0x2C}, {0x1C, 0x1C}, {0x17, 0x28}, //D.12-D.15
+	{0x1B, 0x24}, {0x23, 0x23}, {0x13, 0x13}, {0x32, 0x32}, //D.16-D.19
+	{0x0B, 0x0B}, {0x2A, 0x2A}, {0x1A, 0x1A}, {0x3A, 0x05}, //D.20-D.23
+	{0x33, 0x0C}, {0x26, 0x26}, {0x16, 0x16}, {0x36, 0x09}, //D.24-D.27
+	{0x0E, 0x0E}, {0x2E, 0x11}, {0x1E, 0x21}, {0x2B, 0x14}  //D.28-D.31
+};
+
+static const uint8_t eightb_tenb_k28_6b[2] = {0x0F, 0x30};
+
+//! 3b/4b, RD- and RD+ (fghj), D.x.P7 at 7
+static const uint8_t eightb_tenb_3b4b[8][2] = {
+	{0xB, 0x4}, {0x9, 0x9}, {0x5, 0x5}, {0xC, 0x3},
+	{0xD, 0x2}, {0xA, 0xA}, {0x6, 0x6}, {0xE, 0x1}
+};
+
+static const uint8_t eightb_tenb_k_3b4b[8][2] = {
+	{0xB, 0x4}, {0x6, 0x9}, {0xA, 0x5}, {0xC, 0x3},
+	{0xD, 0x2}, {0x5, 0xA}, {0x9, 0x6}, {0x7, 0x8}
+};
+
+static const uint8_t eightb_tenb_a7[2] = {0x7, 0x8};
+
+
+//! check if a control symbol exists
+static bool eightb_tenb_valid_k(uint_fast16_t in)
+{
+	uint_fast8_t x = in & 0x1f;
+	return(x == 28 || ((in >> 5) == (EIGHTB_TENB_K >> 5 | 7) && (x == 23 || x == 27 || x == 29 || x == 30)));
+}
+
+
+//! D.x.A7 is used instead of D.x.P7 to avoid runs of 5
+#define eightb_tenb_use_a7(x, rd) ((rd) ? ((x) == 11 || (x) == 13 || (x) == 14) : ((x) == 17 || (x) == 18 || (x) == 20))
+
+
+//! 8b/10b encode a data byte or control symbol
+
+//! @param rd running disparity, updated
+//! @param in byte, or control symbol (EIGHTB_TENB_K set)
+//! @return 10 bit code word, a in bit 0, or 0 for an invalid control symbol
+uint_fast16_t eightb_tenb_encode_symbol(bool *rd, uint_fast16_t in)
+{
+	uint_fast8_t x = in & 0x1f, y = (in >> 5) & 7, six, four;
+	bool k = in & EIGHTB_TENB_K, r = *rd;
+
+#ifdef CONFIG_8B10B_LOOKUP
+	if(!k) {
+		uint_fast16_t e = eightb_tenb_enc_lookup[r][in & 0xff];
+		*rd = (e & EIGHTB_TENB_ENC_RD) != 0;
+		return(e & 0x3ff);
+	}
+#endif
+	if(k && !eightb_tenb_valid_k(in))
+		return(0);
+	six = (k && x == 28) ? eightb_tenb_k28_6b[r] : eightb_tenb_5b6b[x][r];
+	if(count_set_bits(six) != 3)
+		r = !r;
+	if(k)
+		four = (x == 28) ? eightb_tenb_k_3b4b[y][r] : eightb_tenb_a7[r];
+	else if(y == 7 && eightb_tenb_use_a7(x, r))
+		four = eightb_tenb_a7[r];
+	else
+		four = eightb_tenb_3b4b[y][r];
+	if(count_set_bits(four) != 2)
+		r = !r;
+	*rd = r;
+	return(blockcode_reverse((six << 4) | four, 10));
+}
+
+
+//! running disparity after a code word, valid or not
+#define eightb_tenb_rd_after(rd, in) ((count_set_bits(in) == 5) ? (rd) : (count_set_bits(in) > 5))
+
+
+//! 8b/10b decode a 10 bit code word
+
+//! a code word which is not allowed at the running disparity is an error
+//! @param rd running disparity, updated
+//! @param in 10 bit code word, a in bit 0
+//! @return byte, control symbol (EIGHTB_TENB_K set) or error = -1
+int_fast16_t eightb_tenb_decode_symbol(bool *rd, uint_fast16_t in)
+{
+	uint_fast16_t tmp = blockcode_reverse(in, 10), out;
+	uint_fast8_t six = tmp >> 4, four = tmp & 0x0f, i;
+	int_fast8_t x=-1, y=-1;
+	bool r = *rd, r6;
+
+	*rd = eightb_tenb_rd_after(r, in);
+	r6 = (count_set_bits(six) != 3) ? !r : r;
+	if(six == eightb_tenb_k28_6b[r]) {
+		for(i=0;i<8;i++) {
+			if(eightb_tenb_k_3b4b[i][r6] == four)
+				y = i;
+		}
+		out = EIGHTB_TENB_K | 28 | (y << 5);
+	} else {
+		for(i=0;i<32;i++) {
+			if(eightb_tenb_5b6b[i][r] == six)
+				x = i;
+		}
+		for(i=0;i<8;i++) {
+			if(eightb_tenb_3b4b[i][r6] == four)
+				y = i;
+		}
+		if(four == eightb_tenb_a7[r6])
+			y = 7;
+		if(x < 0 || y < 0)
+			return(-1);
+		out = x | (y << 5);
+		if(four == eightb_tenb_a7[r6] && !eightb_tenb_use_a7(x, r6))
+			out |= EIGHTB_TENB_K;
+	}
+	if(y < 0 || eightb_tenb_encode_symbol(&r, out) != in)
+		return(-1);
+	return(out);
+}
+
+
+//! 8b/10b encode an array
+
+//! Tip: if buf = dest + (len + 3) / 4 you can reuse the same buffer
+//! @param dest destination buffer (needs to be BLOCKCODE_ENC_LEN(len))
+//! @param rd running disparity at the start
+//! @param buf input data
+//! @param len length of buf
+//! @return running disparity at the end
+bool eightb_tenb_encode_buf(uint8_t *dest, bool rd, const uint8_t *buf, int len)
+{
+	uint_fast16_t sym[4];
+	int g;
+	for(g=0;(g<<2)<len;g++) {
+		uint_fast8_t i, n = min(4, len - (g << 2));
+		for(i=0;i<n;i++) {
+#ifdef CONFIG_8B10B_LOOKUP
+			uint_fast16_t e = eightb_tenb_enc_lookup[rd][buf[(g<<2)+i]];
+			rd = e >> 15;
+			sym[i] = e & 0x3ff;
+#else
+			sym[i] = eightb_tenb_encode_symbol(&rd, buf[(g<<2)+i]);
+#endif
+		}
+		blockcode_pack(dest + g * 5, sym, n);
+	}
+	return(rd);
+}
+
+
+//! 8b/10b decode an array
+
+//! the buffer is decoded in place to BLOCKCODE_DEC_LEN(len) bytes
+//! invalid code words, running disparity errors and control symbols count as errors
+//! @param rd running disparity at the start, updated
+//! @param buf input/output data
+//! @param len length of input data
+//! @return amount of errors, 0 = ok
+int eightb_tenb_decode_buf(bool *rd, uint8_t *buf, int len)
+{
+	int g, out_len = BLOCKCODE_DEC_LEN(len), errors=0;
+	bool r = *rd;
+	for(g=0;(g<<2)<out_len;g++) {
+		uint_fast8_t i, n = min(4, out_len - (g << 2));
+		uint64_t acc = blockcode_unpack(buf + g * 5, min(5, len - g * 5));
+		for(i=0;i<n;i++) {
+#ifdef CONFIG_8B10B_LOOKUP
+			uint_fast16_t e = eightb_tenb_dec_lookup[(acc >> (i * 10)) & 0x3ff];
+			errors += ((~e >> (9 + r)) | (e >> 8)) & 1;
+			r ^= (r ^ (e >> 12)) & (e >> 11) & 1;
+			buf[(g<<2)+i] = e;
+#else
+			int_fast16_t e = eightb_tenb_decode_symbol(&r, (acc >> (i * 10)) & 0x3ff);
+			errors += (e < 0) || (e & EIGHTB_TENB_K);
+			buf[(g<<2)+i] = e;
+#endif
+		}
+	}
+	*rd = r;
+	return(errors);
+}
+#endif //CONFIG_8B10B
@@ -0,0 +1,69 @@
+//! 4B5B and 8b/10b block line codes
+
+//! @file blockcode.h
+//!
+//! Both codes turn a byte into a 10 bit symbol, symbols are packed into the
+//! buffer as a bit stream (first bit is the LSB), so 4 bytes become 5 bytes.
+//! The first transmitted bit of a code word is bit 0 of the symbol,
+//! e.g. 8b/10b abcdei fghj has a in bit 0 and j in bit 9.
+//!
+//! 4B5B (FDDI) sends the low nibble first. It has no DC balance of its own,
+//! it limits runs of zeroes and is meant to be followed by NRZI.
+//! 8b/10b (IBM) keeps the running disparity (rd, 0 = RD-, 1 = RD+) between
+//! -1 and +1, and has control symbols (K codes, bit 8 of the symbol).
+//!
+//! Lookup tables (CONFIG_4B5B_LOOKUP, CONFIG_8B10B_LOOKUP) are generated by
+//! blockcode_lookup_create from the SW routines. The decode tables flag invalid
+//! code words and, for 8b/10b, code words not allowed at the current running
+//! disparity, so violations are counted without branches.
+
+#ifndef BLOCKCODE_H
+#define BLOCKCODE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "config.h"
+#include "helper.h"
+
+#define BLOCKCODE_ENC_LEN(len) (((len) * 5 + 3) >> 2) //!< encoded length of len bytes
+#define BLOCKCODE_DEC_LEN(len) (((len) << 2) / 5)     //!< decoded length of len bytes
+
+#define EIGHTB_TENB_K BIT(8) //!< control symbol
+
+//! control symbols
+#define EIGHTB_TENB_K28_0 (EIGHTB_TENB_K | 0x1C)
+#define EIGHTB_TENB_K28_1 (EIGHTB_TENB_K | 0x3C)
+#define EIGHTB_TENB_K28_5 (EIGHTB_TENB_K | 0xBC) //!< comma
+#define EIGHTB_TENB_K28_7 (EIGHTB_TENB_K | 0xFC)
+#define EIGHTB_TENB_K23_7 (EIGHTB_TENB_K | 0xF7)
+#define EIGHTB_TENB_K27_7 (EIGHTB_TENB_K | 0xFB)
+#define EIGHTB_TENB_K29_7 (EIGHTB_TENB_K | 0xFD)
+#define EIGHTB_TENB_K30_7 (EIGHTB_TENB_K | 0xFE)
+
+//! 8b/10b decode table entry, bits 0-8 are the symbol
+#define EIGHTB_TENB_DEC_VALID_RD(rd) BIT(9 + (rd)) //!< code word allowed at running disparity rd
+#define EIGHTB_TENB_DEC_DISPARITY    BIT(11)       //!< code word is not neutral
+#define EIGHTB_TENB_DEC_RD           BIT(12)       //!< running disparity after a code word which is not neutral
+
+//! 8b/10b encode table entry, bits 0-9 are the code word
+#define EIGHTB_TENB_ENC_RD BIT(15) //!< running disparity after the code word
+
+//4b5b
+#ifdef CONFIG_4B5B
+uint_fast8_t fourb_fiveb_encode_nibble(uint_fast8_t nibble);
+int_fast8_t fourb_fiveb_decode_symbol(uint_fast8_t in);
+uint_fast16_t fourb_fiveb_encode_byte(uint_fast8_t byte);
+int_fast16_t fourb_fiveb_decode_byte(uint_fast16_t in);
+void fourb_fiveb_encode_buf(uint8_t *buf, int len);
+int fourb_fiveb_decode_buf(uint8_t *buf, int len);
+#endif
+
+//8b10b
+#ifdef CONFIG_8B10B
+uint_fast16_t eightb_tenb_encode_symbol(bool *rd, uint_fast16_t in);
+int_fast16_t eightb_tenb_decode_symbol(bool *rd, uint_fast16_t in);
+bool eightb_tenb_encode_buf(uint8_t *dest, bool rd, const uint8_t *buf, int len);
+int eightb_tenb_decode_buf(bool *rd, uint8_t *buf, int len);
+#endif
+
+#endif
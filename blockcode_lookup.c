@@ -0,0 +1,2837 @@
+#include "blockcode_lookup.h"
+
+#ifdef CONFIG_4B5B_LOOKUP
+const uint16_t fourb_fiveb_enc_lookup[256] = {
+0x1EF,
+0x1F2,
+0x1E5,
+0x1F5,
+0x1EA,
+0x1FA,
+0x1EE,
+0x1FE,
+0x1E9,
+0x1F9,
+0x1ED,
+0x1FD,
+0x1EB,
+0x1FB,
+0x1E7,
+0x1F7,
+0x24F,
+0x252,
+0x245,
+0x255,
+0x24A,
+0x25A,
+0x24E,
+0x25E,
+0x249,
+0x259,
+0x24D,
+0x25D,
+0x24B,
+0x25B,
+0x247,
+0x257,
+0x0AF,
+0x0B2,
+0x0A5,
+0x0B5,
+0x0AA,
+0x0BA,
+0x0AE,
+0x0BE,
+0x0A9,
+0x0B9,
+0x0AD,
+0x0BD,
+0x0AB,
+0x0BB,
+0x0A7,
+0x0B7,
+0x2AF,
+0x2B2,
+0x2A5,
+0x2B5,
+0x2AA,
+0x2BA,
+0x2AE,
+0x2BE,
+0x2A9,
+0x2B9,
+0x2AD,
+0x2BD,
+0x2AB,
+0x2BB,
+0x2A7,
+0x2B7,
+0x14F,
+0x152,
+0x145,
+0x155,
+0x14A,
+0x15A,
+0x14E,
+0x15E,
+0x149,
+0x159,
+0x14D,
+0x15D,
+0x14B,
+0x15B,
+0x147,
+0x157,
+0x34F,
+0x352,
+0x345,
+0x355,
+0x34A,
+0x35A,
+0x34E,
+0x35E,
+0x349,
+0x359,
+0x34D,
+0x35D,
+0x34B,
+0x35B,
+0x347,
+0x357,
+0x1CF,
+0x1D2,
+0x1C5,
+0x1D5,
+0x1CA,
+0x1DA,
+0x1CE,
+0x1DE,
+0x1C9,
+0x1D9,
+0x1CD,
+0x1DD,
+0x1CB,
+0x1DB,
+0x1C7,
+0x1D7,
+0x3CF,
+0x3D2,
+0x3C5,
+0x3D5,
+0x3CA,
+0x3DA,
+0x3CE,
+0x3DE,
+0x3C9,
+0x3D9,
+0x3CD,
+0x3DD,
+0x3CB,
+0x3DB,
+0x3C7,
+0x3D7,
+0x12F,
+0x132,
+0x125,
+0x135,
+0x12A,
+0x13A,
+0x12E,
+0x13E,
+0x129,
+0x139,
+0x12D,
+0x13D,
+0x12B,
+0x13B,
+0x127,
+0x137,
+0x32F,
+0x332,
+0x325,
+0x335,
+0x32A,
+0x33A,
+0x32E,
+0x33E,
+0x329,
+0x339,
+0x32D,
+0x33D,
+0x32B,
+0x33B,
+0x327,
+0x337,
+0x1AF,
+0x1B2,
+0x1A5,
+0x1B5,
+0x1AA,
+0x1BA,
+0x1AE,
+0x1BE,
+0x1A9,
+0x1B9,
+0x1AD,
+0x1BD,
+0x1AB,
+0x1BB,
+0x1A7,
+0x1B7,
+0x3AF,
+0x3B2,
+0x3A5,
+0x3B5,
+0x3AA,
+0x3BA,
+0x3AE,
+0x3BE,
+0x3A9,
+0x3B9,
+0x3AD,
+0x3BD,
+0x3AB,
+0x3BB,
+0x3A7,
+0x3B7,
+0x16F,
+0x172,
+0x165,
+0x175,
+0x16A,
+0x17A,
+0x16E,
+0x17E,
+0x169,
+0x179,
+0x16D,
+0x17D,
+0x16B,
+0x17B,
+0x167,
+0x177,
+0x36F,
+0x372,
+0x365,
+0x375,
+0x36A,
+0x37A,
+0x36E,
+0x37E,
+0x369,
+0x379,
+0x36D,
+0x37D,
+0x36B,
+0x37B,
+0x367,
+0x377,
+0x0EF,
+0x0F2,
+0x0E5,
+0x0F5,
+0x0EA,
+0x0FA,
+0x0EE,
+0x0FE,
+0x0E9,
+0x0F9,
+0x0ED,
+0x0FD,
+0x0EB,
+0x0FB,
+0x0E7,
+0x0F7,
+0x2EF,
+0x2F2,
+0x2E5,
+0x2F5,
+0x2EA,
+0x2FA,
+0x2EE,
+0x2FE,
+0x2E9,
+0x2F9,
+0x2ED,
+0x2FD,
+0x2EB,
+0x2FB,
+0x2E7,
+0x2F7,
+};
+
+const uint16_t fourb_fiveb_dec_lookup[1024] = {
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x022,
+0x100,
+0x02E,
+0x100,
+0x028,
+0x024,
+0x02C,
+0x100,
+0x02A,
+0x026,
+0x020,
+0x100,
+0x100,
+0x021,
+0x100,
+0x100,
+0x023,
+0x100,
+0x02F,
+0x100,
+0x029,
+0x025,
+0x02D,
+0x100,
+0x02B,
+0x027,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x0E2,
+0x100,
+0x0EE,
+0x100,
+0x0E8,
+0x0E4,
+0x0EC,
+0x100,
+0x0EA,
+0x0E6,
+0x0E0,
+0x100,
+0x100,
+0x0E1,
+0x100,
+0x100,
+0x0E3,
+0x100,
+0x0EF,
+0x100,
+0x0E9,
+0x0E5,
+0x0ED,
+0x100,
+0x0EB,
+0x0E7,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x082,
+0x100,
+0x08E,
+0x100,
+0x088,
+0x084,
+0x08C,
+0x100,
+0x08A,
+0x086,
+0x080,
+0x100,
+0x100,
+0x081,
+0x100,
+0x100,
+0x083,
+0x100,
+0x08F,
+0x100,
+0x089,
+0x085,
+0x08D,
+0x100,
+0x08B,
+0x087,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x042,
+0x100,
+0x04E,
+0x100,
+0x048,
+0x044,
+0x04C,
+0x100,
+0x04A,
+0x046,
+0x040,
+0x100,
+0x100,
+0x041,
+0x100,
+0x100,
+0x043,
+0x100,
+0x04F,
+0x100,
+0x049,
+0x045,
+0x04D,
+0x100,
+0x04B,
+0x047,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x0C2,
+0x100,
+0x0CE,
+0x100,
+0x0C8,
+0x0C4,
+0x0CC,
+0x100,
+0x0CA,
+0x0C6,
+0x0C0,
+0x100,
+0x100,
+0x0C1,
+0x100,
+0x100,
+0x0C3,
+0x100,
+0x0CF,
+0x100,
+0x0C9,
+0x0C5,
+0x0CD,
+0x100,
+0x0CB,
+0x0C7,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x0A2,
+0x100,
+0x0AE,
+0x100,
+0x0A8,
+0x0A4,
+0x0AC,
+0x100,
+0x0AA,
+0x0A6,
+0x0A0,
+0x100,
+0x100,
+0x0A1,
+0x100,
+0x100,
+0x0A3,
+0x100,
+0x0AF,
+0x100,
+0x0A9,
+0x0A5,
+0x0AD,
+0x100,
+0x0AB,
+0x0A7,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x062,
+0x100,
+0x06E,
+0x100,
+0x068,
+0x064,
+0x06C,
+0x100,
+0x06A,
+0x066,
+0x060,
+0x100,
+0x100,
+0x061,
+0x100,
+0x100,
+0x063,
+0x100,
+0x06F,
+0x100,
+0x069,
+0x065,
+0x06D,
+0x100,
+0x06B,
+0x067,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x002,
+0x100,
+0x00E,
+0x100,
+0x008,
+0x004,
+0x00C,
+0x100,
+0x00A,
+0x006,
+0x000,
+0x100,
+0x100,
+0x001,
+0x100,
+0x100,
+0x003,
+0x100,
+0x00F,
+0x100,
+0x009,
+0x005,
+0x00D,
+0x100,
+0x00B,
+0x007,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x012,
+0x100,
+0x01E,
+0x100,
+0x018,
+0x014,
+0x01C,
+0x100,
+0x01A,
+0x016,
+0x010,
+0x100,
+0x100,
+0x011,
+0x100,
+0x100,
+0x013,
+0x100,
+0x01F,
+0x100,
+0x019,
+0x015,
+0x01D,
+0x100,
+0x01B,
+0x017,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x032,
+0x100,
+0x03E,
+0x100,
+0x038,
+0x034,
+0x03C,
+0x100,
+0x03A,
+0x036,
+0x030,
+0x100,
+0x100,
+0x031,
+0x100,
+0x100,
+0x033,
+0x100,
+0x03F,
+0x100,
+0x039,
+0x035,
+0x03D,
+0x100,
+0x03B,
+0x037,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x0F2,
+0x100,
+0x0FE,
+0x100,
+0x0F8,
+0x0F4,
+0x0FC,
+0x100,
+0x0FA,
+0x0F6,
+0x0F0,
+0x100,
+0x100,
+0x0F1,
+0x100,
+0x100,
+0x0F3,
+0x100,
+0x0FF,
+0x100,
+0x0F9,
+0x0F5,
+0x0FD,
+0x100,
+0x0FB,
+0x0F7,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x092,
+0x100,
+0x09E,
+0x100,
+0x098,
+0x094,
+0x09C,
+0x100,
+0x09A,
+0x096,
+0x090,
+0x100,
+0x100,
+0x091,
+0x100,
+0x100,
+0x093,
+0x100,
+0x09F,
+0x100,
+0x099,
+0x095,
+0x09D,
+0x100,
+0x09B,
+0x097,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x052,
+0x100,
+0x05E,
+0x100,
+0x058,
+0x054,
+0x05C,
+0x100,
+0x05A,
+0x056,
+0x050,
+0x100,
+0x100,
+0x051,
+0x100,
+0x100,
+0x053,
+0x100,
+0x05F,
+0x100,
+0x059,
+0x055,
+0x05D,
+0x100,
+0x05B,
+0x057,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x0D2,
+0x100,
+0x0DE,
+0x100,
+0x0D8,
+0x0D4,
+0x0DC,
+0x100,
+0x0DA,
+0x0D6,
+0x0D0,
+0x100,
+0x100,
+0x0D1,
+0x100,
+0x100,
+0x0D3,
+0x100,
+0x0DF,
+0x100,
+0x0D9,
+0x0D5,
+0x0DD,
+0x100,
+0x0DB,
+0x0D7,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x0B2,
+0x100,
+0x0BE,
+0x100,
+0x0B8,
+0x0B4,
+0x0BC,
+0x100,
+0x0BA,
+0x0B6,
+0x0B0,
+0x100,
+0x100,
+0x0B1,
+0x100,
+0x100,
+0x0B3,
+0x100,
+0x0BF,
+0x100,
+0x0B9,
+0x0B5,
+0x0BD,
+0x100,
+0x0BB,
+0x0B7,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x072,
+0x100,
+0x07E,
+0x100,
+0x078,
+0x074,
+0x07C,
+0x100,
+0x07A,
+0x076,
+0x070,
+0x100,
+0x100,
+0x071,
+0x100,
+0x100,
+0x073,
+0x100,
+0x07F,
+0x100,
+0x079,
+0x075,
+0x07D,
+0x100,
+0x07B,
+0x077,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+0x100,
+};
+#endif
+
+#ifdef CONFIG_8B10B_LOOKUP
+const uint16_t eightb_tenb_enc_lookup[2][256] = {
+{
+0x00B9,
+0x00AE,
+0x00AD,
+0x8363,
+0x00AB,
+0x8365,
+0x8366,
+0x8347,
+0x00A7,
+0x8369,
+0x836A,
+0x834B,
+0x836C,
+0x834D,
+0x834E,
+0x00BA,
+0x00B6,
+0x8371,
+0x8372,
+0x8353,
+0x8374,
+0x8355,
+0x8356,
+0x0097,
+0x00B3,
+0x8359,
+0x835A,
+0x009B,
+0x835C,
+0x009D,
+0x009E,
+0x00B5,
+0x8279,
+0x826E,
+0x826D,
+0x0263,
+0x826B,
+0x0265,
+0x0266,
+0x0247,
+0x8267,
+0x0269,
+0x026A,
+0x024B,
+0x026C,
+0x024D,
+0x024E,
+0x827A,
+0x8276,
+0x0271,
+0x0272,
+0x0253,
+0x0274,
+0x0255,
+0x0256,
+0x8257,
+0x8273,
+0x0259,
+0x025A,
+0x825B,
+0x025C,
+0x825D,
+0x825E,
+0x8275,
+0x82B9,
+0x82AE,
+0x82AD,
+0x02A3,
+0x82AB,
+0x02A5,
+0x02A6,
+0x0287,
+0x82A7,
+0x02A9,
+0x02AA,
+0x028B,
+0x02AC,
+0x028D,
+0x028E,
+0x82BA,
+0x82B6,
+0x02B1,
+0x02B2,
+0x0293,
+0x02B4,
+0x0295,
+0x0296,
+0x8297,
+0x82B3,
+0x0299,
+0x029A,
+0x829B,
+0x029C,
+0x829D,
+0x829E,
+0x82B5,
+0x8339,
+0x832E,
+0x832D,
+0x00E3,
+0x832B,
+0x00E5,
+0x00E6,
+0x00C7,
+0x8327,
+0x00E9,
+0x00EA,
+0x00CB,
+0x00EC,
+0x00CD,
+0x00CE,
+0x833A,
+0x8336,
+0x00F1,
+0x00F2,
+0x00D3,
+0x00F4,
+0x00D5,
+0x00D6,
+0x8317,
+0x8333,
+0x00D9,
+0x00DA,
+0x831B,
+0x00DC,
+0x831D,
+0x831E,
+0x8335,
+0x0139,
+0x012E,
+0x012D,
+0x82E3,
+0x012B,
+0x82E5,
+0x82E6,
+0x82C7,
+0x0127,
+0x82E9,
+0x82EA,
+0x82CB,
+0x82EC,
+0x82CD,
+0x82CE,
+0x013A,
+0x0136,
+0x82F1,
+0x82F2,
+0x82D3,
+0x82F4,
+0x82D5,
+0x82D6,
+0x0117,
+0x0133,
+0x82D9,
+0x82DA,
+0x011B,
+0x82DC,
+0x011D,
+0x011E,
+0x0135,
+0x8179,
+0x816E,
+0x816D,
+0x0163,
+0x816B,
+0x0165,
+0x0166,
+0x0147,
+0x8167,
+0x0169,
+0x016A,
+0x014B,
+0x016C,
+0x014D,
+0x014E,
+0x817A,
+0x8176,
+0x0171,
+0x0172,
+0x0153,
+0x0174,
+0x0155,
+0x0156,
+0x8157,
+0x8173,
+0x0159,
+0x015A,
+0x815B,
+0x015C,
+0x815D,
+0x815E,
+0x8175,
+0x81B9,
+0x81AE,
+0x81AD,
+0x01A3,
+0x81AB,
+0x01A5,
+0x01A6,
+0x0187,
+0x81A7,
+0x01A9,
+0x01AA,
+0x018B,
+0x01AC,
+0x018D,
+0x018E,
+0x81BA,
+0x81B6,
+0x01B1,
+0x01B2,
+0x0193,
+0x01B4,
+0x0195,
+0x0196,
+0x8197,
+0x81B3,
+0x0199,
+0x019A,
+0x819B,
+0x019C,
+0x819D,
+0x819E,
+0x81B5,
+0x0239,
+0x022E,
+0x022D,
+0x81E3,
+0x022B,
+0x81E5,
+0x81E6,
+0x81C7,
+0x0227,
+0x81E9,
+0x81EA,
+0x81CB,
+0x81EC,
+0x81CD,
+0x81CE,
+0x023A,
+0x0236,
+0x83B1,
+0x83B2,
+0x81D3,
+0x83B4,
+0x81D5,
+0x81D6,
+0x0217,
+0x0233,
+0x81D9,
+0x81DA,
+0x021B,
+0x81DC,
+0x021D,
+0x021E,
+0x0235,
+},
+{
+0x8346,
+0x8351,
+0x8352,
+0x00A3,
+0x8354,
+0x00A5,
+0x00A6,
+0x00B8,
+0x8358,
+0x00A9,
+0x00AA,
+0x008B,
+0x00AC,
+0x008D,
+0x008E,
+0x8345,
+0x8349,
+0x00B1,
+0x00B2,
+0x0093,
+0x00B4,
+0x0095,
+0x0096,
+0x8368,
+0x834C,
+0x0099,
+0x009A,
+0x8364,
+0x009C,
+0x8362,
+0x8361,
+0x834A,
+0x0246,
+0x0251,
+0x0252,
+0x8263,
+0x0254,
+0x8265,
+0x8266,
+0x8278,
+0x0258,
+0x8269,
+0x826A,
+0x824B,
+0x826C,
+0x824D,
+0x824E,
+0x0245,
+0x0249,
+0x8271,
+0x8272,
+0x8253,
+0x8274,
+0x8255,
+0x8256,
+0x0268,
+0x024C,
+0x8259,
+0x825A,
+0x0264,
+0x825C,
+0x0262,
+0x0261,
+0x024A,
+0x0286,
+0x0291,
+0x0292,
+0x82A3,
+0x0294,
+0x82A5,
+0x82A6,
+0x82B8,
+0x0298,
+0x82A9,
+0x82AA,
+0x828B,
+0x82AC,
+0x828D,
+0x828E,
+0x0285,
+0x0289,
+0x82B1,
+0x82B2,
+0x8293,
+0x82B4,
+0x8295,
+0x8296,
+0x02A8,
+0x028C,
+0x8299,
+0x829A,
+0x02A4,
+0x829C,
+0x02A2,
+0x02A1,
+0x028A,
+0x00C6,
+0x00D1,
+0x00D2,
+0x8323,
+0x00D4,
+0x8325,
+0x8326,
+0x8338,
+0x00D8,
+0x8329,
+0x832A,
+0x830B,
+0x832C,
+0x830D,
+0x830E,
+0x00C5,
+0x00C9,
+0x8331,
+0x8332,
+0x8313,
+0x8334,
+0x8315,
+0x8316,
+0x00E8,
+0x00CC,
+0x8319,
+0x831A,
+0x00E4,
+0x831C,
+0x00E2,
+0x00E1,
+0x00CA,
+0x82C6,
+0x82D1,
+0x82D2,
+0x0123,
+0x82D4,
+0x0125,
+0x0126,
+0x0138,
+0x82D8,
+0x0129,
+0x012A,
+0x010B,
+0x012C,
+0x010D,
+0x010E,
+0x82C5,
+0x82C9,
+0x0131,
+0x0132,
+0x0113,
+0x0134,
+0x0115,
+0x0116,
+0x82E8,
+0x82CC,
+0x0119,
+0x011A,
+0x82E4,
+0x011C,
+0x82E2,
+0x82E1,
+0x82CA,
+0x0146,
+0x0151,
+0x0152,
+0x8163,
+0x0154,
+0x8165,
+0x8166,
+0x8178,
+0x0158,
+0x8169,
+0x816A,
+0x814B,
+0x816C,
+0x814D,
+0x814E,
+0x0145,
+0x0149,
+0x8171,
+0x8172,
+0x8153,
+0x8174,
+0x8155,
+0x8156,
+0x0168,
+0x014C,
+0x8159,
+0x815A,
+0x0164,
+0x815C,
+0x0162,
+0x0161,
+0x014A,
+0x0186,
+0x0191,
+0x0192,
+0x81A3,
+0x0194,
+0x81A5,
+0x81A6,
+0x81B8,
+0x0198,
+0x81A9,
+0x81AA,
+0x818B,
+0x81AC,
+0x818D,
+0x818E,
+0x0185,
+0x0189,
+0x81B1,
+0x81B2,
+0x8193,
+0x81B4,
+0x8195,
+0x8196,
+0x01A8,
+0x018C,
+0x8199,
+0x819A,
+0x01A4,
+0x819C,
+0x01A2,
+0x01A1,
+0x018A,
+0x81C6,
+0x81D1,
+0x81D2,
+0x0223,
+0x81D4,
+0x0225,
+0x0226,
+0x0238,
+0x81D8,
+0x0229,
+0x022A,
+0x004B,
+0x022C,
+0x004D,
+0x004E,
+0x81C5,
+0x81C9,
+0x0231,
+0x0232,
+0x0213,
+0x0234,
+0x0215,
+0x0216,
+0x81E8,
+0x81CC,
+0x0219,
+0x021A,
+0x81E4,
+0x021C,
+0x81E2,
+0x81E1,
+0x81CA,
+},
+};
+
+const uint16_t eightb_tenb_dec_lookup[1024] = {
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0000,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0000,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0000,
+0x0800,
+0x0800,
+0x0800,
+0x0000,
+0x0800,
+0x0000,
+0x0000,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0CEB,
+0x0800,
+0x0CED,
+0x0CEE,
+0x0000,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x03F7,
+0x0800,
+0x0800,
+0x0800,
+0x03FB,
+0x0800,
+0x03FD,
+0x03FE,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0000,
+0x0800,
+0x0800,
+0x0800,
+0x0000,
+0x0800,
+0x0000,
+0x0000,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0000,
+0x0800,
+0x0000,
+0x0000,
+0x1800,
+0x0800,
+0x0000,
+0x0000,
+0x1800,
+0x03FC,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0C0B,
+0x0800,
+0x0C0D,
+0x0C0E,
+0x0000,
+0x0800,
+0x0800,
+0x0800,
+0x0C13,
+0x0800,
+0x0C15,
+0x0C16,
+0x0217,
+0x0800,
+0x0C19,
+0x0C1A,
+0x021B,
+0x0C1C,
+0x021D,
+0x021E,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0C03,
+0x0800,
+0x0C05,
+0x0C06,
+0x0208,
+0x0800,
+0x0C09,
+0x0C0A,
+0x0204,
+0x0C0C,
+0x0202,
+0x0201,
+0x1800,
+0x0800,
+0x0C11,
+0x0C12,
+0x0218,
+0x0C14,
+0x021F,
+0x0210,
+0x1800,
+0x0C07,
+0x0200,
+0x020F,
+0x1800,
+0x031C,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0D7C,
+0x0800,
+0x0C6F,
+0x0C60,
+0x0267,
+0x0800,
+0x0C70,
+0x0C7F,
+0x026B,
+0x0C78,
+0x026D,
+0x026E,
+0x1800,
+0x0800,
+0x0C61,
+0x0C62,
+0x0273,
+0x0C64,
+0x0275,
+0x0276,
+0x1800,
+0x0C68,
+0x0279,
+0x027A,
+0x1800,
+0x027C,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0C7E,
+0x0C7D,
+0x0263,
+0x0C7B,
+0x0265,
+0x0266,
+0x1800,
+0x0C77,
+0x0269,
+0x026A,
+0x1800,
+0x026C,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0271,
+0x0272,
+0x1800,
+0x0274,
+0x1800,
+0x1800,
+0x1800,
+0x0000,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0C8B,
+0x0800,
+0x0C8D,
+0x0C8E,
+0x0000,
+0x0800,
+0x0800,
+0x0800,
+0x0C93,
+0x0800,
+0x0C95,
+0x0C96,
+0x0297,
+0x0800,
+0x0C99,
+0x0C9A,
+0x029B,
+0x0C9C,
+0x029D,
+0x029E,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0C83,
+0x0800,
+0x0C85,
+0x0C86,
+0x0288,
+0x0800,
+0x0C89,
+0x0C8A,
+0x0284,
+0x0C8C,
+0x0282,
+0x0281,
+0x1800,
+0x0800,
+0x0C91,
+0x0C92,
+0x0298,
+0x0C94,
+0x029F,
+0x0290,
+0x1800,
+0x0C87,
+0x0280,
+0x028F,
+0x1800,
+0x039C,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0D5C,
+0x0800,
+0x0CAF,
+0x0CA0,
+0x02A7,
+0x0800,
+0x0CB0,
+0x0CBF,
+0x06AB,
+0x0CB8,
+0x06AD,
+0x06AE,
+0x1800,
+0x0800,
+0x0CA1,
+0x0CA2,
+0x06B3,
+0x0CA4,
+0x06B5,
+0x06B6,
+0x1AB7,
+0x0CA8,
+0x06B9,
+0x06BA,
+0x1ABB,
+0x06BC,
+0x1ABD,
+0x1ABE,
+0x1800,
+0x0800,
+0x0CBE,
+0x0CBD,
+0x06A3,
+0x0CBB,
+0x06A5,
+0x06A6,
+0x1AA8,
+0x0CB7,
+0x06A9,
+0x06AA,
+0x1AA4,
+0x06AC,
+0x1AA2,
+0x1AA1,
+0x1800,
+0x0800,
+0x06B1,
+0x06B2,
+0x1AB8,
+0x06B4,
+0x1ABF,
+0x1AB0,
+0x1800,
+0x04A7,
+0x1AA0,
+0x1AAF,
+0x1800,
+0x1BBC,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0D3C,
+0x0800,
+0x0CCF,
+0x0CC0,
+0x02C7,
+0x0800,
+0x0CD0,
+0x0CDF,
+0x06CB,
+0x0CD8,
+0x06CD,
+0x06CE,
+0x1800,
+0x0800,
+0x0CC1,
+0x0CC2,
+0x06D3,
+0x0CC4,
+0x06D5,
+0x06D6,
+0x1AD7,
+0x0CC8,
+0x06D9,
+0x06DA,
+0x1ADB,
+0x06DC,
+0x1ADD,
+0x1ADE,
+0x1800,
+0x0800,
+0x0CDE,
+0x0CDD,
+0x06C3,
+0x0CDB,
+0x06C5,
+0x06C6,
+0x1AC8,
+0x0CD7,
+0x06C9,
+0x06CA,
+0x1AC4,
+0x06CC,
+0x1AC2,
+0x1AC1,
+0x1800,
+0x0800,
+0x06D1,
+0x06D2,
+0x1AD8,
+0x06D4,
+0x1ADF,
+0x1AD0,
+0x1800,
+0x04C7,
+0x1AC0,
+0x1ACF,
+0x1800,
+0x1BDC,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0000,
+0x0800,
+0x04EF,
+0x04E0,
+0x1AE7,
+0x0800,
+0x04F0,
+0x04FF,
+0x1AEB,
+0x04F8,
+0x1AED,
+0x1AEE,
+0x1800,
+0x0800,
+0x04E1,
+0x04E2,
+0x1AF3,
+0x04E4,
+0x1AF5,
+0x1AF6,
+0x1800,
+0x04E8,
+0x1AF9,
+0x1AFA,
+0x1800,
+0x1AFC,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x04FE,
+0x04FD,
+0x1AE3,
+0x04FB,
+0x1AE5,
+0x1AE6,
+0x1800,
+0x04F7,
+0x1AE9,
+0x1AEA,
+0x1800,
+0x1AEC,
+0x1800,
+0x1800,
+0x1800,
+0x0000,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0000,
+0x0800,
+0x0800,
+0x0800,
+0x0CF3,
+0x0800,
+0x0CF5,
+0x0CF6,
+0x02F7,
+0x0800,
+0x0CF9,
+0x0CFA,
+0x02FB,
+0x0CFC,
+0x02FD,
+0x02FE,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0CE3,
+0x0800,
+0x0CE5,
+0x0CE6,
+0x02E8,
+0x0800,
+0x0CE9,
+0x0CEA,
+0x02E4,
+0x0CEC,
+0x02E2,
+0x02E1,
+0x1800,
+0x0800,
+0x0CF1,
+0x0CF2,
+0x02F8,
+0x0CF4,
+0x02FF,
+0x02F0,
+0x1800,
+0x0CE7,
+0x02E0,
+0x02EF,
+0x1800,
+0x0000,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0DDC,
+0x0800,
+0x0C2F,
+0x0C20,
+0x0227,
+0x0800,
+0x0C30,
+0x0C3F,
+0x062B,
+0x0C38,
+0x062D,
+0x062E,
+0x1800,
+0x0800,
+0x0C21,
+0x0C22,
+0x0633,
+0x0C24,
+0x0635,
+0x0636,
+0x1A37,
+0x0C28,
+0x0639,
+0x063A,
+0x1A3B,
+0x063C,
+0x1A3D,
+0x1A3E,
+0x1800,
+0x0800,
+0x0C3E,
+0x0C3D,
+0x0623,
+0x0C3B,
+0x0625,
+0x0626,
+0x1A28,
+0x0C37,
+0x0629,
+0x062A,
+0x1A24,
+0x062C,
+0x1A22,
+0x1A21,
+0x1800,
+0x0800,
+0x0631,
+0x0632,
+0x1A38,
+0x0634,
+0x1A3F,
+0x1A30,
+0x1800,
+0x0427,
+0x1A20,
+0x1A2F,
+0x1800,
+0x1B3C,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0DBC,
+0x0800,
+0x0C4F,
+0x0C40,
+0x0247,
+0x0800,
+0x0C50,
+0x0C5F,
+0x064B,
+0x0C58,
+0x064D,
+0x064E,
+0x1800,
+0x0800,
+0x0C41,
+0x0C42,
+0x0653,
+0x0C44,
+0x0655,
+0x0656,
+0x1A57,
+0x0C48,
+0x0659,
+0x065A,
+0x1A5B,
+0x065C,
+0x1A5D,
+0x1A5E,
+0x1800,
+0x0800,
+0x0C5E,
+0x0C5D,
+0x0643,
+0x0C5B,
+0x0645,
+0x0646,
+0x1A48,
+0x0C57,
+0x0649,
+0x064A,
+0x1A44,
+0x064C,
+0x1A42,
+0x1A41,
+0x1800,
+0x0800,
+0x0651,
+0x0652,
+0x1A58,
+0x0654,
+0x1A5F,
+0x1A50,
+0x1800,
+0x0447,
+0x1A40,
+0x1A4F,
+0x1800,
+0x1B5C,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x059C,
+0x0800,
+0x048F,
+0x0480,
+0x1A87,
+0x0800,
+0x0490,
+0x049F,
+0x1A8B,
+0x0498,
+0x1A8D,
+0x1A8E,
+0x1800,
+0x0800,
+0x0481,
+0x0482,
+0x1A93,
+0x0484,
+0x1A95,
+0x1A96,
+0x1800,
+0x0488,
+0x1A99,
+0x1A9A,
+0x1800,
+0x1A9C,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x049E,
+0x049D,
+0x1A83,
+0x049B,
+0x1A85,
+0x1A86,
+0x1800,
+0x0497,
+0x1A89,
+0x1A8A,
+0x1800,
+0x1A8C,
+0x1800,
+0x1800,
+0x1800,
+0x0000,
+0x1A91,
+0x1A92,
+0x1800,
+0x1A94,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0800,
+0x0000,
+0x0800,
+0x0800,
+0x0800,
+0x046B,
+0x0800,
+0x046D,
+0x046E,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0473,
+0x0800,
+0x0475,
+0x0476,
+0x1A77,
+0x0800,
+0x0479,
+0x047A,
+0x1A7B,
+0x047C,
+0x1A7D,
+0x1A7E,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x0463,
+0x0800,
+0x0465,
+0x0466,
+0x1A68,
+0x0800,
+0x0469,
+0x046A,
+0x1A64,
+0x046C,
+0x1A62,
+0x1A61,
+0x1800,
+0x0800,
+0x0471,
+0x0472,
+0x1A78,
+0x0474,
+0x1A7F,
+0x1A70,
+0x1800,
+0x0467,
+0x1A60,
+0x1A6F,
+0x1800,
+0x1B7C,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x051C,
+0x0800,
+0x040F,
+0x0400,
+0x1A07,
+0x0800,
+0x0410,
+0x041F,
+0x1A0B,
+0x0418,
+0x1A0D,
+0x1A0E,
+0x1800,
+0x0800,
+0x0401,
+0x0402,
+0x1A13,
+0x0404,
+0x1A15,
+0x1A16,
+0x1800,
+0x0408,
+0x1A19,
+0x1A1A,
+0x1800,
+0x1A1C,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x041E,
+0x041D,
+0x1A03,
+0x041B,
+0x1A05,
+0x1A06,
+0x1800,
+0x0417,
+0x1A09,
+0x1A0A,
+0x1800,
+0x1A0C,
+0x1800,
+0x1800,
+0x1800,
+0x0000,
+0x1A11,
+0x1A12,
+0x1800,
+0x1A14,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0800,
+0x0800,
+0x05FC,
+0x0800,
+0x0000,
+0x0000,
+0x1800,
+0x0800,
+0x0000,
+0x0000,
+0x1800,
+0x0000,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0000,
+0x0000,
+0x1800,
+0x0000,
+0x1800,
+0x1800,
+0x1800,
+0x0000,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x05FE,
+0x05FD,
+0x1800,
+0x05FB,
+0x1800,
+0x1800,
+0x1800,
+0x05F7,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x0000,
+0x1AF1,
+0x1AF2,
+0x1800,
+0x1AF4,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x0800,
+0x0000,
+0x0000,
+0x1800,
+0x0000,
+0x1800,
+0x1800,
+0x1800,
+0x0000,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x0000,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x0000,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+0x1800,
+};
+#endif
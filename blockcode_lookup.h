@@ -0,0 +1,12 @@
+#include <stdint.h>
+#include "config.h"
+
+#ifdef CONFIG_4B5B_LOOKUP
+extern const uint16_t fourb_fiveb_enc_lookup[256];
+extern const uint16_t fourb_fiveb_dec_lookup[1024];
+#endif
+
+#ifdef CONFIG_8B10B_LOOKUP
+extern const uint16_t eightb_tenb_enc_lookup[2][256];
+extern const uint16_t eightb_tenb_dec_lookup[1024];
+#endif
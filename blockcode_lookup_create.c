@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "blockcode.h"
+#if defined(CONFIG_4B5B_LOOKUP) || defined(CONFIG_8B10B_LOOKUP)
+#error need SW routines to generate lookup table
+#endif
+
+int main(void)
+{
+	int i;
+	FILE *fh, *fc;
+	fh = fopen("blockcode_lookup.h", "w");
+	fc = fopen("blockcode_lookup.c", "w");
+	fprintf(fh, "#include <stdint.h>\n#include \"config.h\"\n\n");
+	fprintf(fc, "#include \"blockcode_lookup.h\"\n\n");
+
+	fprintf(fh, "#ifdef CONFIG_4B5B_LOOKUP\nextern const uint16_t fourb_fiveb_enc_lookup[256];\nextern const uint16_t fourb_fiveb_dec_lookup[1024];\n#endif\n\n");
+	fprintf(fc, "#ifdef CONFIG_4B5B_LOOKUP\nconst uint16_t fourb_fiveb_enc_lookup[256] = {\n");
+	for(i=0;i<256;i++) {
+		fprintf(fc, "0x%03X,\n", (unsigned int)fourb_fiveb_encode_byte(i));
+	}
+	fprintf(fc, "};\n\nconst uint16_t fourb_fiveb_dec_lookup[1024] = {\n");
+	for(i=0;i<1024;i++) {
+		int_fast16_t dec = fourb_fiveb_decode_byte(i);
+		fprintf(fc, "0x%03X,\n", (unsigned int)((dec < 0) ? 0x100 : dec));
+	}
+	fprintf(fc, "};\n#endif\n\n");
+
+	fprintf(fh, "#ifdef CONFIG_8B10B_LOOKUP\nextern const uint16_t eightb_tenb_enc_lookup[2][256];\nextern const uint16_t eightb_tenb_dec_lookup[1024];\n#endif\n");
+	fprintf(fc, "#ifdef CONFIG_8B10B_LOOKUP\nconst uint16_t eightb_tenb_enc_lookup[2][256] = {\n");
+	for(i=0;i<512;i++) {
+		bool rd = i >> 8;
+		uint_fast16_t enc = eightb_tenb_encode_symbol(&rd, i & 0xff);
+		if(rd)
+			enc |= EIGHTB_TENB_ENC_RD;
+		fprintf(fc, "%s0x%04X,\n", (i & 0xff) ? "" : "{\n", (unsigned int)enc);
+		if((i & 0xff) == 0xff)
+			fprintf(fc, "},\n");
+	}
+	fprintf(fc, "};\n\nconst uint16_t eightb_tenb_dec_lookup[1024] = {\n");
+	for(i=0;i<1024;i++) {
+		unsigned int entry = 0, ones = count_set_bits(i);
+		int rd;
+		for(rd=0;rd<2;rd++) {
+			bool r = rd;
+			int_fast16_t dec = eightb_tenb_decode_symbol(&r, i);
+			if(dec >= 0)
+				entry |= EIGHTB_TENB_DEC_VALID_RD(rd) | dec;
+		}
+		if(ones != 5)
+			entry |= EIGHTB_TENB_DEC_DISPARITY;
+		if(ones > 5)
+			entry |= EIGHTB_TENB_DEC_RD;
+		fprintf(fc, "0x%04X,\n", entry);
+	}
+	fprintf(fc, "};\n#endif\n");
+
+	fclose(fh);
+	fclose(fc);
+	return(0);
+}
@@ -1,11 +1,24 @@
+//! Byte coder, chains of frame codecs
+
+//! @file bytecoder.c
+
+
+#include <string.h>
 #include "bytecoder.h"
 #include "helper.h"
 #include "manchester.h"
+#include "crc.h"
+#include "whitening.h"
+#include "blockcode.h"
+#include "fec.h"
+#include "conv.h"
+#include "interleave.h"
 
 #ifdef CONFIG_BYTECODER_BIGLEN
 void bc_encode_len(uint8_t *buf, bc_len_t len, bc_len_t encoded_len, bc_len_t offset, uint_fast8_t bytes, bool big_endian)
 {
 	uint_fast8_t i;
+	(void)len;
 	for(i=0;i<bytes;i++) {
 		if(big_endian)
 			buf[offset+i] = READ_BYTE(encoded_len, bytes-i-1);
@@ -16,11 +29,12 @@ void bc_encode_len(uint8_t *buf, bc_len_t len, bc_len_t encoded_len, bc_len_t of
 
 bc_len_t bc_decode_len(uint8_t *buf, bc_len_t len, bc_len_t offset, uint_fast8_t bytes, bool big_endian)
 {
-	bytecodec_len_t out=0;
+	bc_len_t out=0;
 	uint_fast8_t i;
+	(void)len;
 	for(i=0;i<bytes;i++) {
 		if(big_endian)
-			out |= buf[offset+i] << (8*(i-1));
+			out |= buf[offset+i] << (8*(bytes-i-1));
 		else
 			out |= buf[offset+i] << (8*i);
 	}
@@ -29,73 +43,741 @@ bc_len_t bc_decode_len(uint8_t *buf, bc_len_t len, bc_len_t offset, uint_fast8_t
 #else
 void bc_encode_len(uint8_t *buf, bc_len_t len, bc_len_t encoded_len, bc_len_t offset)
 {
+	(void)len;
 	buf[offset] = encoded_len;
 }
 
 
 bc_len_t bc_decode_len(uint8_t *buf, bc_len_t len, bc_len_t offset)
 {
+	(void)len;
 	return(buf[offset]);
 }
 #endif
 
 
-void lshift_bytes(uint8_t *buf, bc_len_t len, bc_len_t offset)
+void lshift_bytes(uint8_t *buf, int len, int offset)
 {
-	bc_len_t i;
+	int i;
 	for(i=0;i<len-offset;i++)
 		buf[i] = buf[i+offset];
 }
 
 
-void lshift_bits(uint8_t *buf, bc_len_t len, uint_fast8_t offset)
+//! shift a bit stream (first bit is LSB of buf[0]) towards the start
+
+//! the last byte is filled up with zeroes
+void lshift_bits(uint8_t *buf, int len, uint_fast8_t offset)
 {
-	bc_len_t i;
+	int i;
+	if(!offset)
+		return;
 	for(i=0;i<len;i++) {
-		buf[i] >> offset;
+		buf[i] >>= offset;
 		if(i<(len-1))
-			buf[i] |= (buf[i] & (pow(2,offset)-1)) << (8-offset);
+			buf[i] |= buf[i+1] << (8-offset);
 	}
 }
 
 
-//void codec_chain_add(bytecodec_chain_t *codec_chain, bytecodec_id_t,
+static void bc_invert(uint8_t *buf, int len)
+{
+	int i;
+	for(i=0;i<len;i++)
+		buf[i] = ~buf[i];
+}
 
-int bc_encode(bytecodec_t *codec, uint8_t *buf, bc_len_t len)
+
+//! insert bytes at the start of the buffer
+static void bc_prepend(uint8_t *buf, int len, int bytes)
 {
-	switch(codec_chain->codec[i]->id) {
-	case BYTECODEC_ABORT:
+	memmove(buf + bytes, buf, len);
+}
+
+
+//! interleaver options, rows/columns default to 8, the delay step to 1
+#define bc_interleave_opt(codec, n) ((int)((codec)->opt[n] ? (codec)->opt[n] : ((codec)->id == BYTECODEC_INTERLEAVE_CONV ? 1 : 8)))
+
+
+#ifdef CONFIG_WHITENING
+//! options of a whitening codec, 0 or the ones of its tables
+static bool bc_whitening_opt_ok(const bytecodec_t *codec)
+{
+	const whitening_t *w = codec->data;
+	return(!w || ((!codec->opt[0] || codec->opt[0] == w->poly) && (!codec->opt[1] || codec->opt[1] == w->seed)));
+}
+
+
+//! @return len, or -1 if opt conflicts with the tables
+static int bc_whiten(const bytecodec_t *codec, uint8_t *buf, int len)
+{
+	const whitening_t *w = codec->data;
+	if(!bc_whitening_opt_ok(codec))
+		return(-1);
+	if(w)
+		whitening_xor(w, w->seed, buf, len);
+	else
+		whitening_lfsr(codec->opt[0] ? codec->opt[0] : WHITENING_PN9, codec->opt[1], buf, len);
+	return(len);
+}
+
+
+//! find codecs to encode in one pass with a whitening codec
+
+//! CRC16, WHITENING and MANCHESTER_GE_THOMAS
+//! @param codec first codec
+//! @param amount codecs left
+//! @param flags whitening_encode() flags
+//! @return amount of fused codecs, 0 if codec does not start a group
+static int bc_whitening_group(const bytecodec_t *codec, int amount, uint_fast8_t *flags)
+{
+	int i=0;
+	*flags = 0;
+	if(amount > 1 && codec[0].id == BYTECODEC_CRC16 && codec[1].id == BYTECODEC_WHITENING) {
+		*flags |= WHITENING_CRC16;
+		i++;
+	}
+	if(codec[i].id != BYTECODEC_WHITENING || !codec[i].data || !bc_whitening_opt_ok(&codec[i]))
 		return(0);
-		case FIXED_LENGTH:
-			return(codec->opt[0]);
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC_BYTE)
+	//whitening_encode() needs the byte encoder for the manchester stage
+	if(i + 1 < amount && codec[i+1].id == BYTECODEC_MANCHESTER_GE_THOMAS) {
+		*flags |= WHITENING_MANCHESTER;
+		i++;
+	}
+#endif
+	return(*flags ? i + 1 : 0);
+}
+
+
+//! find codecs to decode in one pass with a whitening codec
+
+//! @param codec codecs
+//! @param last codec to decode next
+//! @param flags whitening_decode() flags
+//! @return index of the first fused codec, -1 if codec[last] does not end a group
+static int bc_whitening_group_back(const bytecodec_t *codec, int last, uint_fast8_t *flags)
+{
+	int first = last;
+	*flags = 0;
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_DEC_BYTE)
+	//whitening_decode() needs the byte decoder for the manchester stage
+	if(first > 0 && codec[first].id == BYTECODEC_MANCHESTER_GE_THOMAS && codec[first-1].id == BYTECODEC_WHITENING) {
+		*flags |= WHITENING_MANCHESTER;
+		first--;
+	}
+#endif
+	if(codec[first].id != BYTECODEC_WHITENING || !codec[first].data || !bc_whitening_opt_ok(&codec[first]))
+		return(-1);
+	if(first > 0 && codec[first-1].id == BYTECODEC_CRC16) {
+		*flags |= WHITENING_CRC16;
+		first--;
+	}
+	return(*flags ? first : -1);
+}
+
+
+//! crc16 options of a fused group
+#define bc_group_crc_poly(codec) ((codec)->opt[0] ? (codec)->opt[0] : CRC16_POLY)
+#endif
+
+
+#ifdef CONFIG_REED_SOLOMON
+#define BC_MAX_ERASURES (RS_MAX_NSYM * 4) //!< manchester erasures passed to a fused reed-solomon decode
+
+//! reed-solomon tables of a codec, calculated in tmp if the codec has none
+static const rs_t *bc_rs(const bytecodec_t *codec, rs_t *tmp)
+{
+	if(codec->data)
+		return(codec->data);
+	if(rs_init(tmp, codec->opt[0]))
+		return(NULL);
+	return(tmp);
+}
+
+
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_DEC)
+//! decode manchester and reed-solomon in one go, invalid manchester bytes are erasures
+
+//! @param codec REED_SOLOMON codec followed by the manchester codec
+//! @param buf input/output data
+//! @param len length of input data
+//! @return length of output data, or -1 on error
+static int bc_rs_manchester_decode(const bytecodec_t *codec, uint8_t *buf, int len)
+{
+	int erasures[BC_MAX_ERASURES], amount;
+	const rs_t *rs;
+	rs_t tmp;
+	if((len & 1) || !(rs = bc_rs(&codec[0], &tmp)))
+		return(-1);
+	if(codec[1].id == BYTECODEC_MANCHESTER_IEEE802_3)
+		bc_invert(buf, len);
+	amount = manchester_decode_erasures(buf, len, erasures, BC_MAX_ERASURES);
+	return(rs_decode_buf(rs, buf, len >> 1, erasures, min(amount, BC_MAX_ERASURES)));
+}
+#endif
+#endif
+
+
+#if defined(CONFIG_MANCHESTER_FIXED) && defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC) && defined(CONFIG_MANCHESTER_DEC)
+//! check for a FIXED_LENGTH of 16, 32 or 64 bytes followed by manchester, coded by the unrolled coders
+static bool bc_fixed_group(const bytecodec_t *codec, int amount)
+{
+	if(amount < 2 || codec[0].id != BYTECODEC_FIXED_LENGTH)
+		return(false);
+	if(codec[0].opt[0] != 16 && codec[0].opt[0] != 32 && codec[0].opt[0] != 64)
+		return(false);
+	return(codec[1].id == BYTECODEC_MANCHESTER_GE_THOMAS || codec[1].id == BYTECODEC_MANCHESTER_IEEE802_3);
+}
+
+
+#ifndef __OPTIMIZE_SIZE__
+//! pad and manchester encode a fixed length frame
+
+//! not taken when optimized for size, the unrolled encoder is slower than the table one there
+//! @param codec FIXED_LENGTH codec followed by the manchester codec
+//! @param buf input/output data
+//! @param len length of input data
+//! @return length of output data
+static int bc_fixed_encode(const bytecodec_t *codec, uint8_t *buf, int len)
+{
+	bool ieee = codec[1].id == BYTECODEC_MANCHESTER_IEEE802_3;
+	if(len < (int)codec[0].opt[0])
+		memset(buf + len, 0, codec[0].opt[0] - len);
+	switch(codec[0].opt[0]) {
+	case 16:
+		manchester_encode_fixed(16, buf, buf, ieee);
+		break;
+	case 32:
+		manchester_encode_fixed(32, buf, buf, ieee);
+		break;
+	default:
+		manchester_encode_fixed(64, buf, buf, ieee);
+		break;
+	}
+	return(codec[0].opt[0] << 1);
+}
+#endif
+
+
+//! manchester decode a fixed length frame
+
+//! @param codec FIXED_LENGTH codec followed by the manchester codec
+//! @param buf input/output data, twice the fixed length
+//! @return length of output data, or -1 on error
+static int bc_fixed_decode(const bytecodec_t *codec, uint8_t *buf)
+{
+	bool ieee = codec[1].id == BYTECODEC_MANCHESTER_IEEE802_3;
+	int e;
+	switch(codec[0].opt[0]) {
+	case 16:
+		e = manchester_decode_fixed(16, buf, buf, ieee);
+		break;
+	case 32:
+		e = manchester_decode_fixed(32, buf, buf, ieee);
+		break;
+	default:
+		e = manchester_decode_fixed(64, buf, buf, ieee);
+		break;
+	}
+	return(e ? -1 : (int)codec[0].opt[0]);
+}
+#endif
+
+
+//! amount of codecs in chain, up to the first abort
+int bc_chain_amount(const bytecodec_chain_t *codec_chain)
+{
+	int i;
+	for(i=0;i<codec_chain->amount;i++) {
+		if(codec_chain->codec[i].id == BYTECODEC_ABORT)
 			break;
-	case ENCODED_LENGTH:
+	}
+	return(i);
+}
+
+
+//! size of the length field of an encoded length codec
+uint_fast8_t bc_len_field_bytes(const bytecodec_t *codec)
+{
 #ifdef CONFIG_BYTECODER_BIGLEN
-		bc_encode_len(buf, len, current_len, codec_chain->codec[i]->opt[0], codec_chain->codec[i]->opt[1], codec_chain->codec[i]->opt[2]);
+	return(codec->opt[1] ? codec->opt[1] : 1);
 #else
-		bc_encode_len(buf, len, current_len, codec_chain->codec[i]->opt[0]);
+	(void)codec;
+	return(1);
 #endif
-		break;
+}
+
+
+//! length of the output of a codec
+
+//! @param codec codec
+//! @param len length of the input data
+//! @return length of the encoded data
+int bc_encoded_len(const bytecodec_t *codec, int len)
+{
+	switch(codec->id) {
+	case BYTECODEC_SYNC_WORD:
+	case BYTECODEC_PREAMBLE:
+		return(len + codec->opt[1]);
+	case BYTECODEC_FIXED_LENGTH:
+		return(codec->opt[0]);
+	case BYTECODEC_ENCODED_LENGTH:
+		return(len + bc_len_field_bytes(codec));
 	case BYTECODEC_MANCHESTER_GE_THOMAS:
-		break;
+	case BYTECODEC_MANCHESTER_IEEE802_3:
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T0:
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T1:
+	case BYTECODEC_BMC:
+	case BYTECODEC_MILLER:
+		return(len << 1);
+	case BYTECODEC_4B5B:
+	case BYTECODEC_8B10B:
+		return(BLOCKCODE_ENC_LEN(len));
+	case BYTECODEC_CRC8:
+		return(len + 1);
+	case BYTECODEC_CRC16:
+		return(len + 2);
+	case BYTECODEC_HAMMING_8_4:
+		return(len << 1);
+#ifdef CONFIG_REED_SOLOMON
+	case BYTECODEC_REED_SOLOMON:
+		return(rs_encoded_len(codec->opt[0], len));
+#endif
+	case BYTECODEC_CONVOLUTIONAL:
+		return(CONV_ENC_LEN(len));
+	case BYTECODEC_INTERLEAVE_CONV:
+		return(len + INTERLEAVE_CONV_EXTRA(bc_interleave_opt(codec, 0)));
+	default:
+		return(len);
 	}
 }
 
 
-int bc_encode_chain(bytecodec_chain_t *codec_chain, uint8_t *buf, bc_len_t len)
+//! calculate the buffer requirements of a chain
+
+//! @param codec_chain chain to update
+//! @param max_len maximum length of unencoded data
+void bc_chain_plan(bytecodec_chain_t *codec_chain, int max_len)
 {
-	bc_len_t current_len=len;
-	uint_fast8_t i;
-	for(i=0;i<codec_chain->amount;i++)
-		bc_encode(codec_chain->codec[i], buf, len);
-	return(0);
+	int i, amount = bc_chain_amount(codec_chain);
+	int len = max_len, buf_len = max_len;
+	for(i=0;i<amount;i++) {
+		len = bc_encoded_len(&codec_chain->codec[i], len);
+		buf_len = max(buf_len, len);
+	}
+	codec_chain->enc_dest_buf = false;
+	codec_chain->dec_dest_buf = false;
+	codec_chain->enc_buf_len = buf_len;
+	codec_chain->dec_buf_len = buf_len;
 }
 
-int bytedecoder(bytecodec_chain_t codec_chain, uint8_t *buf, bc_len_t len)
+
+//! encode a buffer in place with a single codec
+
+//! @param codec codec
+//! @param buf input/output data (needs to be bc_encoded_len())
+//! @param len length of input data
+//! @return length of output data, or -1 on error
+int bc_encode(const bytecodec_t *codec, uint8_t *buf, int len)
 {
-	uint_fast8_t i;
-	for(i=0;i<codec_chain->amount;i++) {
+	int i;
+	switch(codec->id) {
+	case BYTECODEC_ABORT:
+		return(len);
+	case BYTECODEC_SYNC_WORD:
+		bc_prepend(buf, len, codec->opt[1]);
+		for(i=0;i<(int)codec->opt[1];i++)
+			buf[i] = READ_BYTE(codec->opt[0], codec->opt[1]-i-1);
+		return(len + codec->opt[1]);
+	case BYTECODEC_PREAMBLE:
+		bc_prepend(buf, len, codec->opt[1]);
+		memset(buf, codec->opt[0], codec->opt[1]);
+		return(len + codec->opt[1]);
+	case BYTECODEC_LTRIM:
+		return(len);
+	case BYTECODEC_FIXED_LENGTH:
+		if(len < (int)codec->opt[0])
+			memset(buf + len, 0, codec->opt[0] - len);
+		return(codec->opt[0]);
+	case BYTECODEC_ENCODED_LENGTH:
+		if(len < (int)codec->opt[0])
+			return(-1);
+		i = bc_len_field_bytes(codec);
+		//the length has to fit into the field
+		if(i < (int)sizeof(int) && ((len - (int)codec->opt[0]) >> (i << 3)))
+			return(-1);
+		memmove(buf + codec->opt[0] + i, buf + codec->opt[0], len - codec->opt[0]);
+#ifdef CONFIG_BYTECODER_BIGLEN
+		bc_encode_len(buf, len, len - codec->opt[0], codec->opt[0], i, codec->opt[2]);
+#else
+		bc_encode_len(buf, len, len - codec->opt[0], codec->opt[0]);
+#endif
+		return(len + i);
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC)
+	case BYTECODEC_MANCHESTER_GE_THOMAS:
+		manchester_encode_buf(buf, len);
+		return(len << 1);
+	case BYTECODEC_MANCHESTER_IEEE802_3:
+		manchester_encode_buf(buf, len);
+		bc_invert(buf, len << 1);
+		return(len << 1);
+#endif
+#if defined(CONFIG_DIFF_MANCHESTER) && defined(CONFIG_DIFF_MANCHESTER_ENC)
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T0:
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T1:
+		bc_prepend(buf, len, len);
+		if(codec->id == BYTECODEC_DIFFERENTIAL_MANCHESTER_T1)
+			bc_invert(buf + len, len);
+		differential_manchester_encode_buf(buf, codec->opt[0], buf + len, len);
+		return(len << 1);
+#endif
+#if defined(CONFIG_BMC) && defined(CONFIG_BMC_ENC)
+	case BYTECODEC_BMC:
+		bc_prepend(buf, len, len);
+		bmc_encode_buf(buf, codec->opt[0], buf + len, len);
+		return(len << 1);
+#endif
+#ifdef CONFIG_NRZI
+	case BYTECODEC_NRZI:
+		if(codec->opt[1])
+			bc_invert(buf, len);
+		nrzi_encode_buf(codec->opt[0], buf, len);
+		return(len);
+#endif
+#if defined(CONFIG_MILLER) && defined(CONFIG_MILLER_ENC)
+	case BYTECODEC_MILLER:
+		bc_prepend(buf, len, len);
+		miller_encode_buf(buf, codec->opt[0], buf + len, len);
+		return(len << 1);
+#endif
+#ifdef CONFIG_4B5B
+	case BYTECODEC_4B5B:
+		fourb_fiveb_encode_buf(buf, len);
+		return(BLOCKCODE_ENC_LEN(len));
+#endif
+#ifdef CONFIG_8B10B
+	case BYTECODEC_8B10B:
+		i = (len + 3) >> 2;
+		memmove(buf + i, buf, len);
+		eightb_tenb_encode_buf(buf, codec->opt[0], buf + i, len);
+		return(BLOCKCODE_ENC_LEN(len));
+#endif
+#ifdef CONFIG_WHITENING
+	case BYTECODEC_WHITENING:
+		return(bc_whiten(codec, buf, len));
+#endif
+	case BYTECODEC_CRC8:
+		buf[len] = crc8_update(codec->opt[1], codec->opt[0] ? codec->opt[0] : CRC8_POLY, buf, len);
+		return(len + 1);
+	case BYTECODEC_CRC16: {
+		uint_fast16_t crc = crc16_update(codec->opt[1], codec->opt[0] ? codec->opt[0] : CRC16_POLY, buf, len);
+		buf[len] = HIGH_BYTE(crc);
+		buf[len+1] = LOW_BYTE(crc);
+		return(len + 2);
+	}
+#ifdef CONFIG_HAMMING
+	case BYTECODEC_HAMMING_8_4:
+		hamming_encode_buf(buf, len);
+		return(len << 1);
+#endif
+#ifdef CONFIG_REED_SOLOMON
+	case BYTECODEC_REED_SOLOMON: {
+		rs_t tmp;
+		const rs_t *rs = bc_rs(codec, &tmp);
+		if(!rs)
+			return(-1);
+		return(rs_encode_buf(rs, buf, len));
+	}
+#endif
+#ifdef CONFIG_CONV
+	case BYTECODEC_CONVOLUTIONAL:
+		bc_prepend(buf, len, len + 2);
+		conv_encode_buf(buf, buf + len + 2, len);
+		return(CONV_ENC_LEN(len));
+#endif
+#ifdef CONFIG_INTERLEAVE
+	case BYTECODEC_INTERLEAVE_BLOCK:
+		return(interleave_block_buf(buf, buf, bc_interleave_opt(codec, 0), bc_interleave_opt(codec, 1), len, false));
+	case BYTECODEC_INTERLEAVE_CONV:
+		interleave_conv_encode(buf, buf, bc_interleave_opt(codec, 0), len);
+		return(len + INTERLEAVE_CONV_EXTRA(bc_interleave_opt(codec, 0)));
+#endif
+	default:
+		return(-1);
+	}
+}
+
+
+//! decode a buffer in place with a single codec
 
+//! @param codec codec
+//! @param buf input/output data
+//! @param len length of input data
+//! @return length of output data, or -1 on error
+int bc_decode(const bytecodec_t *codec, uint8_t *buf, int len)
+{
+	int i;
+	switch(codec->id) {
+	case BYTECODEC_ABORT:
+		return(len);
+	case BYTECODEC_SYNC_WORD: {
+		uint_fast8_t errors = 0;
+		if(len < (int)codec->opt[1])
+			return(-1);
+		for(i=0;i<(int)codec->opt[1];i++)
+			errors += count_set_bits(buf[i] ^ READ_BYTE(codec->opt[0], codec->opt[1]-i-1));
+		if(errors > codec->opt[2])
+			return(-1);
+	}
+	//fall through
+	case BYTECODEC_PREAMBLE:
+	case BYTECODEC_LTRIM:
+		i = (codec->id == BYTECODEC_LTRIM) ? codec->opt[0] : codec->opt[1];
+		if(len < i)
+			return(-1);
+		lshift_bytes(buf, len, i);
+		return(len - i);
+	case BYTECODEC_FIXED_LENGTH:
+		if(len < (int)codec->opt[0])
+			return(-1);
+		return(codec->opt[0]);
+	case BYTECODEC_ENCODED_LENGTH: {
+		bc_len_t encoded_len;
+		i = bc_len_field_bytes(codec);
+		if(len < (int)codec->opt[0] + i)
+			return(-1);
+#ifdef CONFIG_BYTECODER_BIGLEN
+		encoded_len = bc_decode_len(buf, len, codec->opt[0], i, codec->opt[2]);
+#else
+		encoded_len = bc_decode_len(buf, len, codec->opt[0]);
+#endif
+		if((int)(codec->opt[0] + i + encoded_len) > len)
+			return(-1);
+		memmove(buf + codec->opt[0], buf + codec->opt[0] + i, encoded_len);
+		return(codec->opt[0] + encoded_len);
 	}
-	return(0);
-}
\ No newline at end of file
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_DEC)
+	case BYTECODEC_MANCHESTER_GE_THOMAS:
+	case BYTECODEC_MANCHESTER_IEEE802_3:
+		if(len & 1)
+			return(-1);
+		if(codec->id == BYTECODEC_MANCHESTER_IEEE802_3)
+			bc_invert(buf, len);
+#ifdef CONFIG_MANCHESTER_ERROR_DETECTOR
+		if(!manchester_check_buf(buf, len))
+			return(-1);
+#endif
+		if(manchester_decode_buf(buf, len))
+			return(-1);
+		return(len >> 1);
+#endif
+#if defined(CONFIG_DIFF_MANCHESTER) && defined(CONFIG_DIFF_MANCHESTER_DEC)
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T0:
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T1:
+		if(len & 1)
+			return(-1);
+#ifdef CONFIG_MANCHESTER_ERROR_DETECTOR
+		if(!manchester_check_buf(buf, len))
+			return(-1);
+#endif
+		differential_manchester_decode_buf(codec->opt[0], buf, len);
+		if(codec->id == BYTECODEC_DIFFERENTIAL_MANCHESTER_T1)
+			bc_invert(buf, len >> 1);
+		return(len >> 1);
+#endif
+#if defined(CONFIG_BMC) && defined(CONFIG_BMC_DEC)
+	case BYTECODEC_BMC:
+		if(len & 1)
+			return(-1);
+#ifdef CONFIG_BMC_ERROR_DETECTOR
+		if(!bmc_check_buf(codec->opt[0], buf, len))
+			return(-1);
+#endif
+		bmc_decode_buf(buf, len);
+		return(len >> 1);
+#endif
+#ifdef CONFIG_NRZI
+	case BYTECODEC_NRZI:
+		nrzi_decode_buf(codec->opt[0], buf, len);
+		if(codec->opt[1])
+			bc_invert(buf, len);
+		return(len);
+#endif
+#if defined(CONFIG_MILLER) && defined(CONFIG_MILLER_DEC)
+	case BYTECODEC_MILLER:
+		if(len & 1)
+			return(-1);
+		if(miller_decode_buf(codec->opt[0], buf, len))
+			return(-1);
+		return(len >> 1);
+#endif
+#ifdef CONFIG_4B5B
+	case BYTECODEC_4B5B:
+		if(fourb_fiveb_decode_buf(buf, len))
+			return(-1);
+		return(BLOCKCODE_DEC_LEN(len));
+#endif
+#ifdef CONFIG_8B10B
+	case BYTECODEC_8B10B: {
+		bool rd = codec->opt[0];
+		if(eightb_tenb_decode_buf(&rd, buf, len))
+			return(-1);
+		return(BLOCKCODE_DEC_LEN(len));
+	}
+#endif
+#ifdef CONFIG_WHITENING
+	case BYTECODEC_WHITENING:
+		return(bc_whiten(codec, buf, len));
+#endif
+	case BYTECODEC_CRC8:
+		if(len < 1)
+			return(-1);
+		if(crc8_update(codec->opt[1], codec->opt[0] ? codec->opt[0] : CRC8_POLY, buf, len-1) != buf[len-1])
+			return(-1);
+		return(len - 1);
+	case BYTECODEC_CRC16: {
+		uint_fast16_t crc;
+		if(len < 2)
+			return(-1);
+		crc = crc16_update(codec->opt[1], codec->opt[0] ? codec->opt[0] : CRC16_POLY, buf, len-2);
+		if(HIGH_BYTE(crc) != buf[len-2] || LOW_BYTE(crc) != buf[len-1])
+			return(-1);
+		return(len - 2);
+	}
+#ifdef CONFIG_HAMMING
+	case BYTECODEC_HAMMING_8_4:
+		if(len & 1)
+			return(-1);
+		if(hamming_decode_buf(buf, len, NULL))
+			return(-1);
+		return(len >> 1);
+#endif
+#ifdef CONFIG_REED_SOLOMON
+	case BYTECODEC_REED_SOLOMON: {
+		rs_t tmp;
+		const rs_t *rs = bc_rs(codec, &tmp);
+		if(!rs)
+			return(-1);
+		return(rs_decode_buf(rs, buf, len, NULL, 0));
+	}
+#endif
+#ifdef CONFIG_CONV
+	case BYTECODEC_CONVOLUTIONAL:
+		if(len < 2 || (len & 1))
+			return(-1);
+		conv_decode_buf(buf, len);
+		return(CONV_DEC_LEN(len));
+#endif
+#ifdef CONFIG_INTERLEAVE
+	case BYTECODEC_INTERLEAVE_BLOCK:
+		return(interleave_block_buf(buf, buf, bc_interleave_opt(codec, 0), bc_interleave_opt(codec, 1), len, true));
+	case BYTECODEC_INTERLEAVE_CONV:
+		if(len < INTERLEAVE_CONV_EXTRA(bc_interleave_opt(codec, 0)))
+			return(-1);
+		interleave_conv_decode(buf, buf, bc_interleave_opt(codec, 0), len);
+		return(len - INTERLEAVE_CONV_EXTRA(bc_interleave_opt(codec, 0)));
+#endif
+	default:
+		return(-1);
+	}
+}
+
+
+//! encode a buffer in place with a list of codecs
+
+//! @param codec codecs in encoding order
+//! @param amount amount of codecs
+//! @param buf input/output data
+//! @param len length of input data
+//! @return length of output data, or -1 on error
+int bc_encode_codecs(const bytecodec_t *codec, int amount, uint8_t *buf, int len)
+{
+	int i=0;
+	while(i<amount && len>=0) {
+#ifdef CONFIG_WHITENING
+		uint_fast8_t flags;
+		int n = bc_whitening_group(codec + i, amount - i, &flags);
+		if(n) {
+			const bytecodec_t *w = (flags & WHITENING_CRC16) ? &codec[i+1] : &codec[i];
+			len = whitening_encode(w->data, buf, len, flags, bc_group_crc_poly(&codec[i]), codec[i].opt[1]);
+			i += n;
+			continue;
+		}
+#endif
+#if defined(CONFIG_MANCHESTER_FIXED) && defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC) && defined(CONFIG_MANCHESTER_DEC) && !defined(__OPTIMIZE_SIZE__)
+		if(bc_fixed_group(codec + i, amount - i)) {
+			len = bc_fixed_encode(codec + i, buf, len);
+			i += 2;
+			continue;
+		}
+#endif
+		len = bc_encode(&codec[i++], buf, len);
+	}
+	return(len);
+}
+
+
+//! decode a buffer in place with a list of codecs
+
+//! @param codec codecs in encoding order
+//! @param amount amount of codecs
+//! @param buf input/output data
+//! @param len length of input data
+//! @return length of output data, or -1 on error
+int bc_decode_codecs(const bytecodec_t *codec, int amount, uint8_t *buf, int len)
+{
+	int i=amount-1;
+	while(i>=0 && len>=0) {
+#ifdef CONFIG_WHITENING
+		uint_fast8_t flags;
+		int first = bc_whitening_group_back(codec, i, &flags);
+		if(first >= 0) {
+			const bytecodec_t *w = (flags & WHITENING_CRC16) ? &codec[first+1] : &codec[first];
+			len = whitening_decode(w->data, buf, len, flags, bc_group_crc_poly(&codec[first]), codec[first].opt[1]);
+			i = first - 1;
+			continue;
+		}
+#endif
+#if defined(CONFIG_REED_SOLOMON) && defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_DEC)
+		if(i > 0 && codec[i-1].id == BYTECODEC_REED_SOLOMON && (codec[i].id == BYTECODEC_MANCHESTER_GE_THOMAS || codec[i].id == BYTECODEC_MANCHESTER_IEEE802_3)) {
+			len = bc_rs_manchester_decode(&codec[i-1], buf, len);
+			i -= 2;
+			continue;
+		}
+#endif
+#if defined(CONFIG_MANCHESTER_FIXED) && defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC) && defined(CONFIG_MANCHESTER_DEC)
+		if(i > 0 && bc_fixed_group(codec + i - 1, 2) && len == (int)codec[i-1].opt[0] << 1) {
+			len = bc_fixed_decode(codec + i - 1, buf);
+			i -= 2;
+			continue;
+		}
+#endif
+		len = bc_decode(&codec[i--], buf, len);
+	}
+	return(len);
+}
+
+
+//! encode a buffer in place with a chain of codecs
+
+//! @param codec_chain chain
+//! @param buf input/output data (needs to be codec_chain->enc_buf_len)
+//! @param len length of input data
+//! @return length of output data, or -1 on error
+int bc_encode_chain(const bytecodec_chain_t *codec_chain, uint8_t *buf, int len)
+{
+	return(bc_encode_codecs(codec_chain->codec, bc_chain_amount(codec_chain), buf, len));
+}
+
+
+//! decode a buffer in place with a chain of codecs
+
+//! @param codec_chain chain
+//! @param buf input/output data
+//! @param len length of input data
+//! @return length of output data, or -1 on error
+int bc_decode_chain(const bytecodec_chain_t *codec_chain, uint8_t *buf, int len)
+{
+	return(bc_decode_codecs(codec_chain->codec, bc_chain_amount(codec_chain), buf, len));
+}
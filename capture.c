@@ -0,0 +1,478 @@
+//! Delta varint edge capture files
+
+//! @file capture.c
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "config.h"
+#ifdef CONFIG_CAPTURE
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#if defined(CONFIG_CAPTURE) && defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#include "helper.h"
+#include "capture.h"
+#include "capture_lookup.h"
+
+
+#ifdef CONFIG_CAPTURE
+#define CAPTURE_VERSION 1
+
+
+//! write a little endian field
+static void capture_put_le(uint8_t *p, uint64_t word, uint_fast8_t bytes)
+{
+	while(bytes--) {
+		*p++ = word & 0xff;
+		word >>= 8;
+	}
+}
+
+
+//! read a little endian field
+static uint64_t capture_le(const uint8_t *p, uint_fast8_t bytes)
+{
+	uint64_t out=0;
+	while(bytes--)
+		out = (out << 8) | p[bytes];
+	return(out);
+}
+
+
+//! start a capture file
+
+//! @param w writer
+//! @param filename file to create
+//! @param tick_rate ticks per second, only stored for the reader
+//! @param slot_ticks time covered by an entry of the seek table, e.g. a second
+//! @param level level of the line before the first edge
+//! @return 0 on success, -1 on error
+int capture_open(capture_writer_t *w, const char *filename, uint64_t tick_rate, uint64_t slot_ticks, bool level)
+{
+	uint8_t header[CAPTURE_HEADER] = {'E', 'D', 'G', 'C'};
+	memset(w, 0, sizeof(*w));
+	if(!slot_ticks)
+		return(-1);
+	w->file = fopen(filename, "wb");
+	if(!w->file)
+		return(-1);
+	capture_put_le(header + 4, CAPTURE_VERSION, 4);
+	capture_put_le(header + 8, tick_rate, 8);
+	capture_put_le(header + 16, slot_ticks, 8);
+	header[24] = level;
+	if(fwrite(header, 1, sizeof(header), w->file) != sizeof(header)) {
+		fclose(w->file);
+		w->file = NULL;
+		return(-1);
+	}
+	w->offset = CAPTURE_HEADER;
+	w->slot_ticks = slot_ticks;
+	return(0);
+}
+
+
+//! encode and write the collected block
+static int capture_flush(capture_writer_t *w)
+{
+	uint8_t *ctrl = w->buf + CAPTURE_BLOCK_HEADER, *data = ctrl + (w->count + 3) / 4;
+	uint_fast8_t n;
+	uint32_t i, v;
+	size_t size;
+	if(!w->count)
+		return(0);
+	memset(ctrl, 0, (w->count + 3) / 4);
+	for(i=0;i<w->count;i++) {
+		v = w->delta[i];
+		n = (v > 0xFFFFFF) ? 4 : ((v > 0xFFFF) ? 3 : ((v > 0xFF) ? 2 : 1));
+		ctrl[i >> 2] |= (n - 1) << (2 * (i & 3));
+		capture_put_le(data, v, n);
+		data += n;
+	}
+	size = data - w->buf;
+	capture_put_le(w->buf, w->count, 4);
+	capture_put_le(w->buf + 4, size - CAPTURE_BLOCK_HEADER, 4);
+	capture_put_le(w->buf + 8, w->first, 8);
+	capture_put_le(w->buf + 16, w->edges, 8);
+	if(fwrite(w->buf, 1, size, w->file) != size)
+		return(-1);
+	w->offset += size;
+	w->edges += w->count;
+	w->count = 0;
+	return(0);
+}
+
+
+//! point the slots up to the one of time at the block being collected
+static int capture_slot(capture_writer_t *w, uint64_t time)
+{
+	uint64_t s = (time - w->start) / w->slot_ticks, *slots;
+	while(w->num_slots <= s) {
+		if(w->num_slots == w->max_slots) {
+			slots = realloc(w->slots, (w->max_slots ? 2 * w->max_slots : 1024) * sizeof(*slots));
+			if(!slots)
+				return(-1);
+			w->slots = slots;
+			w->max_slots = w->max_slots ? 2 * w->max_slots : 1024;
+		}
+		w->slots[w->num_slots++] = w->offset;
+	}
+	return(0);
+}
+
+
+//! add edges
+
+//! a block ends after CAPTURE_BLOCK edges or before it would span 2^32 ticks
+//! @param w writer
+//! @param times time stamps of the edges in ticks, not decreasing
+//! @param len amount of edges
+//! @return 0 on success, -1 on error or a time stamp before the last one
+int capture_append(capture_writer_t *w, const uint64_t *times, long len)
+{
+	uint64_t t;
+	long i;
+	for(i=0;i<len;i++) {
+		t = times[i];
+		if(!w->edges && !w->count)
+			w->start = w->last = t;
+		if(t < w->last)
+			return(-1);
+		if(w->count == CAPTURE_BLOCK || (w->count && t - w->first > UINT32_MAX)) {
+			if(capture_flush(w))
+				return(-1);
+		}
+		if(!w->count)
+			w->first = w->last = t;
+		w->delta[w->count++] = t - w->last;
+		w->last = t;
+		if(capture_slot(w, t))
+			return(-1);
+	}
+	return(0);
+}
+
+
+//! write the last block, the slot table and the footer and close the file
+
+//! @return 0 on success, -1 on error
+int capture_close(capture_writer_t *w)
+{
+	uint8_t *footer = w->buf;
+	uint64_t i;
+	int e = capture_flush(w);
+	for(i=0;i<w->num_slots && !e;i++) {
+		capture_put_le(w->buf, w->slots[i], 8);
+		e = fwrite(w->buf, 1, 8, w->file) != 8;
+	}
+	memset(footer, 0, CAPTURE_FOOTER);
+	capture_put_le(footer, w->offset, 8);
+	capture_put_le(footer + 8, w->num_slots, 8);
+	capture_put_le(footer + 16, w->edges, 8);
+	capture_put_le(footer + 24, w->start, 8);
+	memcpy(footer + 32, "EDGX", 4);
+	if(!e)
+		e = fwrite(footer, 1, CAPTURE_FOOTER, w->file) != CAPTURE_FOOTER;
+	e |= fclose(w->file) != 0;
+	free(w->slots);
+	w->file = NULL;
+	w->slots = NULL;
+	return(e ? -1 : 0);
+}
+
+
+//! map a capture file read only
+
+//! @param c reader
+//! @param filename capture file
+//! @return 0 on success, -1 on error or an invalid file
+int capture_map_open(capture_map_t *c, const char *filename)
+{
+	const uint8_t *footer;
+	struct stat st;
+	void *map;
+	uint64_t slots;
+	int fd = open(filename, O_RDONLY);
+	memset(c, 0, sizeof(*c));
+	if(fd < 0)
+		return(-1);
+	if(fstat(fd, &st) || st.st_size < CAPTURE_HEADER + CAPTURE_FOOTER || (uint64_t)st.st_size > SIZE_MAX) {
+		close(fd);
+		return(-1);
+	}
+	map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd); //the mapping keeps the file
+	if(map == MAP_FAILED)
+		return(-1);
+	c->map = map;
+	c->map_len = (size_t)st.st_size;
+	footer = c->map + c->map_len - CAPTURE_FOOTER;
+	slots = capture_le(footer, 8);
+	c->num_slots = capture_le(footer + 8, 8);
+	c->edges = capture_le(footer + 16, 8);
+	c->start = capture_le(footer + 24, 8);
+	c->tick_rate = capture_le(c->map + 8, 8);
+	c->slot_ticks = capture_le(c->map + 16, 8);
+	c->level = c->map[24];
+	if(memcmp(c->map, "EDGC", 4) || capture_le(c->map + 4, 4) != CAPTURE_VERSION || memcmp(footer + 32, "EDGX", 4)
+	   || !c->slot_ticks || slots < CAPTURE_HEADER || slots > c->map_len - CAPTURE_FOOTER
+	   || c->num_slots != (c->map_len - CAPTURE_FOOTER - slots) / 8 || (c->map_len - CAPTURE_FOOTER - slots) % 8) {
+		capture_map_close(c);
+		return(-1);
+	}
+	c->slots = c->map + slots;
+	c->end = (size_t)slots;
+	return(0);
+}
+
+
+//! unmap a capture file
+void capture_map_close(capture_map_t *c)
+{
+	if(c->map)
+		munmap((void *)c->map, c->map_len);
+	c->map = NULL;
+	c->map_len = 0;
+}
+
+
+//! decode Stream VByte differences into time stamps
+
+//! with SSSE3 the data is read in 16 byte loads, up to 15 bytes behind the
+//! block, which the footer covers
+//! @param dest time stamps
+//! @param ctrl control bytes
+//! @param data data bytes
+//! @param count amount of values
+//! @param prev time stamp before the first value
+static void capture_vbyte_decode(uint32_t *dest, const uint8_t *ctrl, const uint8_t *data, uint32_t count, uint32_t prev)
+{
+	uint32_t i = 0, v;
+	uint_fast8_t n;
+#ifdef __SSSE3__
+	__m128i x, last = _mm_set1_epi32(prev);
+	for(;i+4<=count;i+=4) {
+		x = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)data), _mm_loadu_si128((const __m128i *)capture_vbyte_shuffle[ctrl[i >> 2]]));
+		data += capture_vbyte_len[ctrl[i >> 2]];
+		//prefix sum of the four differences
+		x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+		x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+		x = _mm_add_epi32(x, last);
+		_mm_storeu_si128((__m128i *)(dest + i), x);
+		last = _mm_shuffle_epi32(x, 0xFF);
+	}
+	prev = _mm_cvtsi128_si32(last);
+#endif
+	for(;i<count;i++) {
+		n = ((ctrl[i >> 2] >> (2 * (i & 3))) & 3) + 1;
+		for(v=0;n--;)
+			v = (v << 8) | data[n];
+		data += ((ctrl[i >> 2] >> (2 * (i & 3))) & 3) + 1;
+		prev += v;
+		dest[i] = prev;
+	}
+}
+
+
+//! decode the block at cur->next
+
+//! @return 0 on success, -1 at the end or on a broken block
+static int capture_block(capture_cursor_t *cur)
+{
+	const capture_map_t *c = cur->c;
+	const uint8_t *b = c->map + cur->next, *ctrl;
+	uint32_t count, size, data, i;
+	if(cur->next >= c->end || c->end - cur->next < CAPTURE_BLOCK_HEADER)
+		return(-1);
+	count = capture_le(b, 4);
+	size = capture_le(b + 4, 4);
+	if(!count || count > CAPTURE_BLOCK || size > c->end - cur->next - CAPTURE_BLOCK_HEADER || size < (count + 3) / 4)
+		return(-1);
+	ctrl = b + CAPTURE_BLOCK_HEADER;
+	for(i=0,data=0;i<count;i++)
+		data += ((ctrl[i >> 2] >> (2 * (i & 3))) & 3) + 1;
+	if(data > size - (count + 3) / 4)
+		return(-1);
+	cur->first = capture_le(b + 8, 8);
+	cur->first_edge = capture_le(b + 16, 8);
+	capture_vbyte_decode(cur->time, ctrl, ctrl + (count + 3) / 4, count, (uint32_t)cur->first);
+	cur->count = count;
+	cur->pos = 0;
+	cur->next += CAPTURE_BLOCK_HEADER + size;
+	return(0);
+}
+
+
+//! time of edge i of the decoded block, a block spans less than 2^32 ticks
+static uint64_t capture_edge_time(const capture_cursor_t *cur, uint32_t i)
+{
+	return(cur->first + (uint32_t)(cur->time[i] - cur->time[0]));
+}
+
+
+//! make sure an edge is decoded
+
+//! @return true if there is a next edge
+static bool capture_more(capture_cursor_t *cur)
+{
+	return(cur->pos < cur->count || !capture_block(cur));
+}
+
+
+//! position a cursor at the first edge at or after a time
+
+//! @param cur cursor
+//! @param c mapped capture file
+//! @param time ticks, as given to the writer
+//! @return 0 on success (also behind the last edge), -1 on a broken file
+int capture_seek(capture_cursor_t *cur, const capture_map_t *c, uint64_t time)
+{
+	uint64_t s;
+	uint32_t lo, hi, mid;
+	cur->c = c;
+	cur->next = c->end;
+	cur->first_edge = c->edges;
+	cur->count = 0;
+	cur->pos = 0;
+	cur->chip_started = false;
+	cur->chip_byte = 0;
+	cur->chip_bits = 0;
+	s = (time > c->start) ? (time - c->start) / c->slot_ticks : 0;
+	if(s >= c->num_slots)
+		return(0);
+	cur->next = capture_le(c->slots + 8 * s, 8);
+	if(cur->next < CAPTURE_HEADER || cur->next > c->end)
+		return(-1);
+	//the slot points at the block of its first edge, later blocks may follow within the slot
+	do {
+		if(cur->next == c->end) {
+			cur->pos = cur->count;
+			return(0);
+		}
+		if(capture_block(cur))
+			return(-1);
+	} while(capture_edge_time(cur, cur->count - 1) < time);
+	for(lo=0,hi=cur->count-1;lo<hi;) {
+		mid = (lo + hi) / 2;
+		if(capture_edge_time(cur, mid) < time)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	cur->pos = lo;
+	return(0);
+}
+
+
+//! time of the next edge
+
+//! @return ticks, UINT64_MAX behind the last edge
+uint64_t capture_time(capture_cursor_t *cur)
+{
+	if(!capture_more(cur))
+		return(UINT64_MAX);
+	return(capture_edge_time(cur, cur->pos));
+}
+
+
+//! level of the pulse the next edge starts, for pulse_init()
+bool capture_level(const capture_cursor_t *cur)
+{
+	return(cur->c->level ^ ((cur->first_edge + cur->pos + 1) & 1));
+}
+
+
+//! read edges
+
+//! @param cur cursor
+//! @param dest low 32 bits of the time stamps, for pulse_decode_edges()
+//! @param max size of dest
+//! @param until time of the first edge not to read, UINT64_MAX for all
+//! @return amount of edges
+long capture_read(capture_cursor_t *cur, uint32_t *dest, long max, uint64_t until)
+{
+	long n = 0, k;
+	while(n < max && capture_more(cur)) {
+		k = min((long)(cur->count - cur->pos), max - n);
+		//the edges are sorted, only the ones at the end can be too late
+		while(k && capture_edge_time(cur, cur->pos + k - 1) >= until)
+			k--;
+		if(!k)
+			break;
+		memcpy(dest + n, cur->time + cur->pos, k * sizeof(*dest));
+		cur->pos += k;
+		n += k;
+	}
+	return(n);
+}
+
+
+//! read edges as chips
+
+//! every pulse gives its duration in chips (rounded, up to CAPTURE_MAX_RUN)
+//! at its level, packed from bit 0 on, for manchester_decode_buf() and the
+//! other chip decoders; the first edge read after capture_seek() only
+//! starts a pulse
+//! @param cur cursor, keeps an incomplete byte
+//! @param dest chips
+//! @param max size of dest
+//! @param until time of the first edge not to read, UINT64_MAX for all
+//! @param chip_ticks chip duration in ticks
+//! @return amount of complete bytes
+long capture_chips(capture_cursor_t *cur, uint8_t *dest, long max, uint64_t until, uint32_t chip_ticks)
+{
+	uint32_t t, d, run;
+	bool level;
+	long out = 0;
+	if(!chip_ticks)
+		return(0);
+	while(out + CAPTURE_MAX_RUN / 8 <= max && capture_more(cur) && capture_edge_time(cur, cur->pos) < until) {
+		level = !capture_level(cur); //the pulse ending at this edge
+		t = cur->time[cur->pos++];
+		if(cur->chip_started) {
+			d = t - cur->chip_edge;
+			run = d / chip_ticks + (d % chip_ticks >= chip_ticks - chip_ticks / 2);
+			for(run=min(run, CAPTURE_MAX_RUN);run;run--) {
+				cur->chip_byte |= level << cur->chip_bits;
+				if(++cur->chip_bits == 8) {
+					dest[out++] = cur->chip_byte;
+					cur->chip_byte = 0;
+					cur->chip_bits = 0;
+				}
+			}
+		}
+		cur->chip_edge = t;
+		cur->chip_started = true;
+	}
+	return(out);
+}
+
+
+#ifdef CONFIG_PULSE
+//! decode edges with a pulse decoder
+
+//! edges are taken in batches of CAPTURE_BATCH while dest has room for them
+//! @param cur cursor
+//! @param p decoder, e.g. prepared with capture_level(cur)
+//! @param dest decoded bytes
+//! @param max size of dest
+//! @param until time of the first edge not to decode, UINT64_MAX for all
+//! @return amount of decoded bytes
+long capture_decode(capture_cursor_t *cur, pulse_t *p, uint8_t *dest, long max, uint64_t until)
+{
+	uint32_t batch[CAPTURE_BATCH];
+	long n, out = 0;
+	while(out + PULSE_OUT_MAX(CAPTURE_BATCH) <= max) {
+		n = capture_read(cur, batch, CAPTURE_BATCH, until);
+		if(!n)
+			break;
+		out += pulse_decode_edges(p, dest + out, batch, n);
+	}
+	return(out);
+}
+#endif
+#endif //CONFIG_CAPTURE
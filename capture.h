@@ -0,0 +1,105 @@
+//! Delta varint edge capture files
+
+//! @file capture.h
+//!
+//! Edges are sparse compared with samples, so long recordings are kept as
+//! edge time stamps instead of WAV files. The time stamps are 64 bit ticks,
+//! stored as differences in blocks of up to CAPTURE_BLOCK edges. The
+//! differences are Stream VByte varints: a control byte holds the lengths
+//! (1 - 4 bytes) of four values and the data bytes follow all control bytes,
+//! so four values are decoded with one table lookup and one shuffle (SSSE3).
+//!
+//! File layout, all fields little endian:
+//! - header: "EDGC", version, tick rate, slot duration in ticks, first level
+//! - blocks: edges, data bytes, time of the first edge, number of the first
+//!   edge, control bytes, data bytes; the first difference of a block is 0
+//! - slot table: one offset per slot of slot_ticks since the first edge,
+//!   the block which holds the first edge at or after the start of the slot
+//! - footer: offset and size of the slot table, edges, time of the first
+//!   edge, "EDGX"
+//!
+//! Seeking to a time is a division and a table read, followed by a walk
+//! over the blocks within the slot. The reader maps the file, so replaying a
+//! burst from a large archive only touches the pages of the blocks around it.
+//! The edges come out as 32 bit time stamps for pulse_decode_edges(), or as
+//! chips sampled at the edges for manchester_decode_buf() and the other chip
+//! decoders. The level of every pulse follows from the number of the edge.
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "config.h"
+#include "pulse.h"
+
+#define CAPTURE_BLOCK 1024        //!< edges per block, a multiple of 4
+#define CAPTURE_BLOCK_HEADER 24   //!< bytes before the control bytes of a block
+#define CAPTURE_BLOCK_MAX (CAPTURE_BLOCK_HEADER + CAPTURE_BLOCK / 4 + 4 * CAPTURE_BLOCK) //!< largest block in bytes
+#define CAPTURE_HEADER 32         //!< bytes of the file header
+#define CAPTURE_FOOTER 40         //!< bytes of the file footer, at least 16 so a block can be read with 16 byte loads
+#define CAPTURE_BATCH 64          //!< edges handed to the decoder at a time
+#define CAPTURE_MAX_RUN 16        //!< most chips taken from one pulse, longer ones are gaps
+
+typedef struct {
+	FILE *file;
+	uint64_t offset;                //!< file offset of the block being collected
+	uint64_t edges;                 //!< edges in the blocks written so far
+	uint64_t start;                 //!< time of the first edge
+	uint64_t first;                 //!< time of the first edge of the block
+	uint64_t last;                  //!< time of the last edge
+	uint64_t slot_ticks;
+	uint64_t *slots;                //!< slot table, grows with the recording
+	uint64_t num_slots;
+	uint64_t max_slots;             //!< allocated entries of slots
+	uint32_t count;                 //!< edges in delta
+	uint32_t delta[CAPTURE_BLOCK];
+	uint8_t buf[CAPTURE_BLOCK_MAX];
+} capture_writer_t;
+
+typedef struct {
+	const uint8_t *map;             //!< whole file
+	size_t map_len;
+	uint64_t tick_rate;             //!< ticks per second, as given to the writer
+	uint64_t slot_ticks;
+	uint64_t start;                 //!< time of the first edge
+	uint64_t edges;
+	uint64_t num_slots;
+	const uint8_t *slots;           //!< slot table in the file
+	size_t end;                     //!< offset behind the last block
+	bool level;                     //!< level before the first edge
+} capture_map_t;
+
+typedef struct {
+	const capture_map_t *c;
+	size_t next;                    //!< offset of the next block
+	uint64_t first;                 //!< time of the first edge of the block
+	uint64_t first_edge;            //!< number of the first edge of the block
+	uint32_t count;                 //!< edges in time
+	uint32_t pos;                   //!< next edge in time
+	uint32_t time[CAPTURE_BLOCK];   //!< decoded block, low 32 bits of the time stamps
+	uint32_t chip_edge;             //!< time stamp of the last edge, for the chips
+	bool chip_started;
+	uint8_t chip_byte;              //!< chips of an incomplete byte
+	uint_fast8_t chip_bits;
+} capture_cursor_t;
+
+#ifdef CONFIG_CAPTURE
+int capture_open(capture_writer_t *w, const char *filename, uint64_t tick_rate, uint64_t slot_ticks, bool level);
+int capture_append(capture_writer_t *w, const uint64_t *times, long len);
+int capture_close(capture_writer_t *w);
+int capture_map_open(capture_map_t *c, const char *filename);
+void capture_map_close(capture_map_t *c);
+int capture_seek(capture_cursor_t *cur, const capture_map_t *c, uint64_t time);
+uint64_t capture_time(capture_cursor_t *cur);
+bool capture_level(const capture_cursor_t *cur);
+long capture_read(capture_cursor_t *cur, uint32_t *dest, long max, uint64_t until);
+long capture_chips(capture_cursor_t *cur, uint8_t *dest, long max, uint64_t until, uint32_t chip_ticks);
+#ifdef CONFIG_PULSE
+long capture_decode(capture_cursor_t *cur, pulse_t *p, uint8_t *dest, long max, uint64_t until);
+#endif
+#endif
+
+#endif
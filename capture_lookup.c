@@ -0,0 +1,521 @@
+#include "capture_lookup.h"
+
+#ifdef CONFIG_CAPTURE
+const uint8_t capture_vbyte_len[256] = {
+4,
+5,
+6,
+7,
+5,
+6,
+7,
+8,
+6,
+7,
+8,
+9,
+7,
+8,
+9,
+10,
+5,
+6,
+7,
+8,
+6,
+7,
+8,
+9,
+7,
+8,
+9,
+10,
+8,
+9,
+10,
+11,
+6,
+7,
+8,
+9,
+7,
+8,
+9,
+10,
+8,
+9,
+10,
+11,
+9,
+10,
+11,
+12,
+7,
+8,
+9,
+10,
+8,
+9,
+10,
+11,
+9,
+10,
+11,
+12,
+10,
+11,
+12,
+13,
+5,
+6,
+7,
+8,
+6,
+7,
+8,
+9,
+7,
+8,
+9,
+10,
+8,
+9,
+10,
+11,
+6,
+7,
+8,
+9,
+7,
+8,
+9,
+10,
+8,
+9,
+10,
+11,
+9,
+10,
+11,
+12,
+7,
+8,
+9,
+10,
+8,
+9,
+10,
+11,
+9,
+10,
+11,
+12,
+10,
+11,
+12,
+13,
+8,
+9,
+10,
+11,
+9,
+10,
+11,
+12,
+10,
+11,
+12,
+13,
+11,
+12,
+13,
+14,
+6,
+7,
+8,
+9,
+7,
+8,
+9,
+10,
+8,
+9,
+10,
+11,
+9,
+10,
+11,
+12,
+7,
+8,
+9,
+10,
+8,
+9,
+10,
+11,
+9,
+10,
+11,
+12,
+10,
+11,
+12,
+13,
+8,
+9,
+10,
+11,
+9,
+10,
+11,
+12,
+10,
+11,
+12,
+13,
+11,
+12,
+13,
+14,
+9,
+10,
+11,
+12,
+10,
+11,
+12,
+13,
+11,
+12,
+13,
+14,
+12,
+13,
+14,
+15,
+7,
+8,
+9,
+10,
+8,
+9,
+10,
+11,
+9,
+10,
+11,
+12,
+10,
+11,
+12,
+13,
+8,
+9,
+10,
+11,
+9,
+10,
+11,
+12,
+10,
+11,
+12,
+13,
+11,
+12,
+13,
+14,
+9,
+10,
+11,
+12,
+10,
+11,
+12,
+13,
+11,
+12,
+13,
+14,
+12,
+13,
+14,
+15,
+10,
+11,
+12,
+13,
+11,
+12,
+13,
+14,
+12,
+13,
+14,
+15,
+13,
+14,
+15,
+16,
+};
+
+const uint8_t capture_vbyte_shuffle[256][16] = {
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x80,0x80,0x80,0x04,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x80,0x80,0x80,0x05,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x80,0x80,0x80,0x06,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x80,0x80,0x80,0x04,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x80,0x80,0x80,0x05,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x80,0x80,0x80,0x06,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x80,0x80,0x80,0x07,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x80,0x80,0x80,0x05,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x80,0x80,0x80,0x06,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x80,0x80,0x80,0x07,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x80,0x80,0x80,0x08,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x80,0x06,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x80,0x80,0x80,0x07,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x80,0x80,0x80,0x08,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x80,0x80,0x80,0x09,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x80,0x80,0x05,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x80,0x80,0x06,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x06,0x80,0x80,0x07,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x04,0x80,0x80,0x05,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x80,0x80,0x06,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x80,0x80,0x07,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x07,0x80,0x80,0x08,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x05,0x80,0x80,0x06,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x80,0x80,0x07,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x80,0x80,0x08,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x08,0x80,0x80,0x09,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x80,0x07,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x80,0x80,0x08,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x80,0x80,0x09,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x80,0x0A,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x05,0x80,0x06,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x06,0x80,0x07,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x06,0x07,0x80,0x08,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x04,0x05,0x80,0x06,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x06,0x80,0x07,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x07,0x80,0x08,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x07,0x08,0x80,0x09,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x05,0x06,0x80,0x07,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x07,0x80,0x08,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x08,0x80,0x09,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x08,0x09,0x80,0x0A,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x80,0x08,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x80,0x09,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x0A,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x80,0x0B,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x05,0x06,0x07,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x06,0x07,0x08,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x06,0x07,0x08,0x09,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x04,0x05,0x06,0x07,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x06,0x07,0x08,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x07,0x08,0x09,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x07,0x08,0x09,0x0A,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x05,0x06,0x07,0x08,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x07,0x08,0x09,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x08,0x09,0x0A,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x08,0x09,0x0A,0x0B,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x80,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x80,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x80,0x80,0x80,0x05,0x06,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x80,0x80,0x80,0x06,0x07,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x80,0x80,0x80,0x05,0x06,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x80,0x80,0x80,0x06,0x07,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x80,0x80,0x80,0x07,0x08,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x80,0x80,0x80,0x05,0x06,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x80,0x80,0x80,0x06,0x07,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x80,0x80,0x80,0x07,0x08,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x80,0x80,0x80,0x08,0x09,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x80,0x06,0x07,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x80,0x80,0x80,0x07,0x08,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x80,0x80,0x80,0x08,0x09,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x80,0x80,0x80,0x09,0x0A,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x80,0x80,0x06,0x07,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x06,0x80,0x80,0x07,0x08,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x80,0x80,0x06,0x07,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x80,0x80,0x07,0x08,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x07,0x80,0x80,0x08,0x09,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x05,0x80,0x80,0x06,0x07,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x80,0x80,0x07,0x08,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x80,0x80,0x08,0x09,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x08,0x80,0x80,0x09,0x0A,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x80,0x07,0x08,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x80,0x80,0x08,0x09,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x80,0x80,0x09,0x0A,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x80,0x0A,0x0B,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x06,0x80,0x07,0x08,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x06,0x07,0x80,0x08,0x09,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x06,0x80,0x07,0x08,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x07,0x80,0x08,0x09,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x07,0x08,0x80,0x09,0x0A,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x05,0x06,0x80,0x07,0x08,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x07,0x80,0x08,0x09,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x08,0x80,0x09,0x0A,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x08,0x09,0x80,0x0A,0x0B,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x80,0x08,0x09,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x80,0x09,0x0A,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x0A,0x0B,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x80,0x0B,0x0C,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x06,0x07,0x08,0x09,0x0A,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x07,0x08,0x09,0x0A,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x07,0x08,0x09,0x0A,0x0B,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x07,0x08,0x09,0x0A,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x08,0x09,0x0A,0x0B,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x80,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x80,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x80,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x80,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x05,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x06,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x80,0x80,0x80,0x05,0x06,0x07,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x80,0x80,0x80,0x06,0x07,0x08,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x06,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x80,0x80,0x80,0x05,0x06,0x07,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x80,0x80,0x80,0x06,0x07,0x08,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x80,0x80,0x80,0x07,0x08,0x09,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x80,0x80,0x80,0x05,0x06,0x07,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x80,0x80,0x80,0x06,0x07,0x08,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x80,0x80,0x80,0x07,0x08,0x09,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x80,0x80,0x80,0x08,0x09,0x0A,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x80,0x06,0x07,0x08,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x80,0x80,0x80,0x07,0x08,0x09,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x80,0x80,0x80,0x08,0x09,0x0A,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x80,0x80,0x80,0x09,0x0A,0x0B,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x06,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x07,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x80,0x80,0x06,0x07,0x08,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x06,0x80,0x80,0x07,0x08,0x09,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x07,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x80,0x80,0x06,0x07,0x08,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x80,0x80,0x07,0x08,0x09,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x07,0x80,0x80,0x08,0x09,0x0A,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x05,0x80,0x80,0x06,0x07,0x08,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x80,0x80,0x07,0x08,0x09,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x80,0x80,0x08,0x09,0x0A,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x08,0x80,0x80,0x09,0x0A,0x0B,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x80,0x07,0x08,0x09,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x80,0x80,0x08,0x09,0x0A,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x80,0x80,0x09,0x0A,0x0B,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x80,0x0A,0x0B,0x0C,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x07,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x08,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x06,0x80,0x07,0x08,0x09,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x06,0x07,0x80,0x08,0x09,0x0A,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x08,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x06,0x80,0x07,0x08,0x09,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x07,0x80,0x08,0x09,0x0A,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x07,0x08,0x80,0x09,0x0A,0x0B,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x05,0x06,0x80,0x07,0x08,0x09,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x07,0x80,0x08,0x09,0x0A,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x08,0x80,0x09,0x0A,0x0B,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x08,0x09,0x80,0x0A,0x0B,0x0C,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x80,0x08,0x09,0x0A,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x80,0x09,0x0A,0x0B,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x0A,0x0B,0x0C,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x80,0x0B,0x0C,0x0D,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x80,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x80,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x80,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x05,0x06,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x06,0x07,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x80,0x80,0x80,0x05,0x06,0x07,0x08,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x80,0x80,0x80,0x06,0x07,0x08,0x09,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x06,0x07,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x80,0x80,0x80,0x05,0x06,0x07,0x08,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x80,0x80,0x80,0x06,0x07,0x08,0x09,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x80,0x80,0x80,0x07,0x08,0x09,0x0A,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x80,0x80,0x80,0x05,0x06,0x07,0x08,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x80,0x80,0x80,0x06,0x07,0x08,0x09,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x80,0x80,0x80,0x07,0x08,0x09,0x0A,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x80,0x80,0x80,0x08,0x09,0x0A,0x0B,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x80,0x06,0x07,0x08,0x09,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x80,0x80,0x80,0x07,0x08,0x09,0x0A,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x80,0x80,0x80,0x08,0x09,0x0A,0x0B,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x80,0x80,0x80,0x09,0x0A,0x0B,0x0C,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x06,0x07,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x07,0x08,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x80,0x80,0x06,0x07,0x08,0x09,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x06,0x80,0x80,0x07,0x08,0x09,0x0A,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x07,0x08,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x80,0x80,0x06,0x07,0x08,0x09,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x80,0x80,0x07,0x08,0x09,0x0A,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x07,0x80,0x80,0x08,0x09,0x0A,0x0B,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x05,0x80,0x80,0x06,0x07,0x08,0x09,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x80,0x80,0x07,0x08,0x09,0x0A,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x80,0x80,0x08,0x09,0x0A,0x0B,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x08,0x80,0x80,0x09,0x0A,0x0B,0x0C,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x80,0x07,0x08,0x09,0x0A,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x80,0x80,0x08,0x09,0x0A,0x0B,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x80,0x80,0x09,0x0A,0x0B,0x0C,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x80,0x0A,0x0B,0x0C,0x0D,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x07,0x08,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x08,0x09,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x06,0x80,0x07,0x08,0x09,0x0A,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x06,0x07,0x80,0x08,0x09,0x0A,0x0B,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x08,0x09,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x06,0x80,0x07,0x08,0x09,0x0A,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x07,0x80,0x08,0x09,0x0A,0x0B,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x07,0x08,0x80,0x09,0x0A,0x0B,0x0C,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x05,0x06,0x80,0x07,0x08,0x09,0x0A,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x07,0x80,0x08,0x09,0x0A,0x0B,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x08,0x80,0x09,0x0A,0x0B,0x0C,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x08,0x09,0x80,0x0A,0x0B,0x0C,0x0D,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x80,0x08,0x09,0x0A,0x0B,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x80,0x09,0x0A,0x0B,0x0C,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x0A,0x0B,0x0C,0x0D,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x80,0x0B,0x0C,0x0D,0x0E,},
+{0x00,0x80,0x80,0x80,0x01,0x80,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,},
+{0x00,0x01,0x80,0x80,0x02,0x80,0x80,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,},
+{0x00,0x01,0x02,0x80,0x03,0x80,0x80,0x80,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,},
+{0x00,0x01,0x02,0x03,0x04,0x80,0x80,0x80,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x80,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x80,0x80,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x80,0x80,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x80,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x80,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x80,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x80,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,},
+{0x00,0x80,0x80,0x80,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,},
+{0x00,0x01,0x80,0x80,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,},
+{0x00,0x01,0x02,0x80,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,},
+{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,},
+};
+#endif
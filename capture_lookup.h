@@ -0,0 +1,7 @@
+#include <stdint.h>
+#include "config.h"
+
+#ifdef CONFIG_CAPTURE
+extern const uint8_t capture_vbyte_len[256];
+extern const uint8_t capture_vbyte_shuffle[256][16];
+#endif
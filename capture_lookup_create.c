@@ -0,0 +1,38 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "capture.h"
+
+int main(void)
+{
+	int c, j, k, pos;
+	FILE *fh, *fc;
+	fh = fopen("capture_lookup.h", "w");
+	fc = fopen("capture_lookup.c", "w");
+	fprintf(fh, "#include <stdint.h>\n#include \"config.h\"\n\n");
+	fprintf(fc, "#include \"capture_lookup.h\"\n\n");
+
+	//a control byte holds the lengths - 1 of four varints, two bits each, the first in bit 0
+	fprintf(fh, "#ifdef CONFIG_CAPTURE\nextern const uint8_t capture_vbyte_len[256];\nextern const uint8_t capture_vbyte_shuffle[256][16];\n#endif\n");
+	fprintf(fc, "#ifdef CONFIG_CAPTURE\nconst uint8_t capture_vbyte_len[256] = {\n");
+	for(c=0;c<256;c++) {
+		for(j=0,pos=0;j<4;j++)
+			pos += ((c >> (2*j)) & 3) + 1;
+		fprintf(fc, "%d,\n", pos);
+	}
+	//pshufb pattern moving the data bytes into four 32 bit lanes, 0x80 clears a byte
+	fprintf(fc, "};\n\nconst uint8_t capture_vbyte_shuffle[256][16] = {\n");
+	for(c=0;c<256;c++) {
+		fprintf(fc, "{");
+		for(j=0,pos=0;j<4;j++) {
+			for(k=0;k<4;k++)
+				fprintf(fc, "0x%02X,", (k <= ((c >> (2*j)) & 3)) ? pos + k : 0x80);
+			pos += ((c >> (2*j)) & 3) + 1;
+		}
+		fprintf(fc, "},\n");
+	}
+	fprintf(fc, "};\n#endif\n");
+
+	fclose(fh);
+	fclose(fc);
+	return(0);
+}
@@ -9,6 +9,7 @@
 #define CONFIG_MANCHESTER_DEC_NIBBLE
 #define CONFIG_MANCHESTER_DEC_BYTE
 #define CONFIG_MANCHESTER_DEC_HW
+#define CONFIG_MANCHESTER_FIXED
 
 #define CONFIG_MANCHESTER_ERROR_DETECTOR
 
@@ -19,4 +20,56 @@
 #define CONFIG_BMC
 #define CONFIG_BMC_ENC
 #define CONFIG_BMC_DEC
-#define CONFIG_BMC_ERROR_DETECTOR
\ No newline at end of file
+#define CONFIG_BMC_ERROR_DETECTOR
+
+#define CONFIG_CRC_LOOKUP
+
+#define CONFIG_WHITENING
+#define CONFIG_WHITENING_WORD
+
+#define CONFIG_4B5B
+#define CONFIG_4B5B_LOOKUP
+#define CONFIG_8B10B
+#define CONFIG_8B10B_LOOKUP
+
+#define CONFIG_NRZI
+
+#define CONFIG_MILLER
+#define CONFIG_MILLER_ENC
+#define CONFIG_MILLER_DEC
+
+#define CONFIG_HAMMING
+#define CONFIG_HAMMING_LOOKUP
+#define CONFIG_REED_SOLOMON
+
+#define CONFIG_CONV
+
+#define CONFIG_INTERLEAVE
+
+#define CONFIG_WAV_MAP
+
+#define CONFIG_PCM
+
+#define CONFIG_NCO
+
+#define CONFIG_FSK
+
+#define CONFIG_FIR
+
+#define CONFIG_SLICER
+
+#define CONFIG_PULSE
+
+#define CONFIG_EDGE
+
+#define CONFIG_CAPTURE
+
+#define CONFIG_PIPELINE
+
+#define CONFIG_BATCH
+
+#define CONFIG_ARENA
+
+#define CONFIG_SG
+
+#define CONFIG_BITS
@@ -0,0 +1,242 @@
+//! Convolutional code K=7 r=1/2 with Viterbi decoder
+
+//! @file conv.c
+
+
+#include <string.h>
+#include "config.h"
+#if defined(CONFIG_CONV) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "conv.h"
+#include "helper.h"
+
+
+#ifdef CONFIG_CONV
+#define CONV_RING (CONV_TRACEBACK * 4) //!< decisions kept, power of 2
+#define CONV_NORMALIZE 8               //!< steps between path metric normalisation
+
+
+//! decoder state
+typedef struct {
+	int16_t metric[CONV_STATES];     //!< path metrics
+	uint32_t dec[CONV_RING][2];      //!< decisions of the even and odd states, bit j is state 2j / 2j+1
+} conv_viterbi_t;
+
+
+//! parity of the 7 bit register
+#define conv_parity(x) conv_parity_fold((x) ^ ((x) >> 4))
+#define conv_parity_fold(x) (((x) ^ ((x) >> 2) ^ ((x) >> 1) ^ ((x) >> 3)) & 1)
+
+
+//! convolutional encode an array
+
+//! Tip: if buf = dest + len + 2 you can reuse the same buffer
+//! @param dest destination buffer (needs to be CONV_ENC_LEN(len))
+//! @param buf input data
+//! @param len length of buf
+void conv_encode_buf(uint8_t *dest, const uint8_t *buf, int len)
+{
+	uint_fast8_t reg=0, out=0;
+	int i, bits = (len << 3) + CONV_K - 1;
+	for(i=0;i<bits;i++) {
+		reg = ((reg << 1) | ((i < (len << 3)) ? READ_BIT(buf[i>>3], i & 7) : 0)) & 0x7f;
+		out |= conv_parity(reg & CONV_POLY_A) << ((i & 3) << 1);
+		out |= conv_parity(reg & CONV_POLY_B) << (((i & 3) << 1) + 1);
+		if((i & 3) == 3) {
+			dest[i>>2] = out;
+			out = 0;
+		}
+	}
+	dest[i>>2] = out;
+}
+
+
+//! expected code bits of the butterfly j (register 2j), as XOR masks for the metric
+static void conv_butterfly_masks(int16_t *mask_a, int16_t *mask_b)
+{
+	uint_fast8_t j;
+	for(j=0;j<CONV_STATES/2;j++) {
+		mask_a[j] = conv_parity((j << 1) & CONV_POLY_A) ? 0xff : 0;
+		mask_b[j] = conv_parity((j << 1) & CONV_POLY_B) ? 0xff : 0;
+	}
+}
+
+
+//! soft symbols of a step from soft symbols or hard bits
+#define conv_symbol(soft, hard, n) ((soft) ? (soft)[n] : (uint8_t)-READ_BIT((hard)[(n)>>3], (n) & 7))
+
+
+//! run trellis steps, add-compare-select over all states
+
+//! state j and j+32 go to state 2j (input 0) and 2j+1 (input 1), both polynomials
+//! have the first and last tap, so the branch metrics of a butterfly are a and 510 - a
+//! @param v decoder
+//! @param mask_a see conv_butterfly_masks()
+//! @param mask_b see conv_butterfly_masks()
+//! @param soft soft symbols, or NULL
+//! @param hard hard bits, if soft is NULL
+//! @param t first step
+//! @param end last step (exclusive)
+static void conv_run(conv_viterbi_t *v, const int16_t *mask_a, const int16_t *mask_b, const uint8_t *soft, const uint8_t *hard, int t, int end)
+{
+#ifdef __SSE2__
+	//the 64 metrics stay in 8 registers, states 8i to 8i+7
+	__m128i m0, m1, m2, m3, m4, m5, m6, m7, ce0, ce1, ce2, ce3, co0, co1, co2, co3;
+	const __m128i ma0 = _mm_loadu_si128((const __m128i *)mask_a), ma1 = _mm_loadu_si128((const __m128i *)(mask_a + 8));
+	const __m128i ma2 = _mm_loadu_si128((const __m128i *)(mask_a + 16)), ma3 = _mm_loadu_si128((const __m128i *)(mask_a + 24));
+	const __m128i mb0 = _mm_loadu_si128((const __m128i *)mask_b), mb1 = _mm_loadu_si128((const __m128i *)(mask_b + 8));
+	const __m128i mb2 = _mm_loadu_si128((const __m128i *)(mask_b + 16)), mb3 = _mm_loadu_si128((const __m128i *)(mask_b + 24));
+	const __m128i max = _mm_set1_epi16(510);
+	m0 = _mm_loadu_si128((const __m128i *)v->metric);
+	m1 = _mm_loadu_si128((const __m128i *)(v->metric + 8));
+	m2 = _mm_loadu_si128((const __m128i *)(v->metric + 16));
+	m3 = _mm_loadu_si128((const __m128i *)(v->metric + 24));
+	m4 = _mm_loadu_si128((const __m128i *)(v->metric + 32));
+	m5 = _mm_loadu_si128((const __m128i *)(v->metric + 40));
+	m6 = _mm_loadu_si128((const __m128i *)(v->metric + 48));
+	m7 = _mm_loadu_si128((const __m128i *)(v->metric + 56));
+	//butterflies of old states 8k to 8k+7 and 8k+32 to 8k+39, new states 16k to 16k+15 go to lo and hi
+#define CONV_BUTTERFLY(k, old_lo, old_hi, lo, hi) do { \
+		__m128i a = _mm_add_epi16(_mm_xor_si128(sym0, ma##k), _mm_xor_si128(sym1, mb##k)); \
+		__m128i na = _mm_sub_epi16(max, a); \
+		__m128i e0 = _mm_add_epi16(old_lo, a), e1 = _mm_add_epi16(old_hi, na); \
+		__m128i d0 = _mm_add_epi16(old_lo, na), d1 = _mm_add_epi16(old_hi, a); \
+		__m128i me = _mm_min_epi16(e0, e1), mo = _mm_min_epi16(d0, d1); \
+		ce##k = _mm_cmpgt_epi16(e0, e1); \
+		co##k = _mm_cmpgt_epi16(d0, d1); \
+		lo = _mm_unpacklo_epi16(me, mo); \
+		hi = _mm_unpackhi_epi16(me, mo); \
+	} while(0)
+	for(;t<end;t++) {
+		__m128i sym0 = _mm_set1_epi16(conv_symbol(soft, hard, t << 1));
+		__m128i sym1 = _mm_set1_epi16(conv_symbol(soft, hard, (t << 1) + 1));
+		__m128i n0, n1, n2, n3, n4, n5, n6, n7;
+		uint32_t *dec = v->dec[t & (CONV_RING - 1)];
+		CONV_BUTTERFLY(0, m0, m4, n0, n1);
+		CONV_BUTTERFLY(1, m1, m5, n2, n3);
+		CONV_BUTTERFLY(2, m2, m6, n4, n5);
+		CONV_BUTTERFLY(3, m3, m7, n6, n7);
+		dec[0] = (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(ce0, ce1)) | ((uint32_t)_mm_movemask_epi8(_mm_packs_epi16(ce2, ce3)) << 16);
+		dec[1] = (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(co0, co1)) | ((uint32_t)_mm_movemask_epi8(_mm_packs_epi16(co2, co3)) << 16);
+		if((t % CONV_NORMALIZE) == CONV_NORMALIZE - 1) {
+			__m128i base = _mm_set1_epi16((int16_t)_mm_cvtsi128_si32(n0));
+			n0 = _mm_sub_epi16(n0, base);
+			n1 = _mm_sub_epi16(n1, base);
+			n2 = _mm_sub_epi16(n2, base);
+			n3 = _mm_sub_epi16(n3, base);
+			n4 = _mm_sub_epi16(n4, base);
+			n5 = _mm_sub_epi16(n5, base);
+			n6 = _mm_sub_epi16(n6, base);
+			n7 = _mm_sub_epi16(n7, base);
+		}
+		m0 = n0; m1 = n1; m2 = n2; m3 = n3; m4 = n4; m5 = n5; m6 = n6; m7 = n7;
+	}
+#undef CONV_BUTTERFLY
+	_mm_storeu_si128((__m128i *)v->metric, m0);
+	_mm_storeu_si128((__m128i *)(v->metric + 8), m1);
+	_mm_storeu_si128((__m128i *)(v->metric + 16), m2);
+	_mm_storeu_si128((__m128i *)(v->metric + 24), m3);
+	_mm_storeu_si128((__m128i *)(v->metric + 32), m4);
+	_mm_storeu_si128((__m128i *)(v->metric + 40), m5);
+	_mm_storeu_si128((__m128i *)(v->metric + 48), m6);
+	_mm_storeu_si128((__m128i *)(v->metric + 56), m7);
+#else
+	int16_t n[CONV_STATES];
+	uint_fast8_t j;
+	for(;t<end;t++) {
+		uint_fast8_t s0 = conv_symbol(soft, hard, t << 1), s1 = conv_symbol(soft, hard, (t << 1) + 1);
+		uint32_t *dec = v->dec[t & (CONV_RING - 1)];
+		dec[0] = dec[1] = 0;
+		for(j=0;j<CONV_STATES/2;j++) {
+			int_fast16_t a = (s0 ^ mask_a[j]) + (s1 ^ mask_b[j]), na = 510 - a;
+			int_fast16_t e0 = v->metric[j] + a, e1 = v->metric[j+32] + na, d0 = v->metric[j] + na, d1 = v->metric[j+32] + a;
+			n[j<<1] = min(e0, e1);
+			n[(j<<1)+1] = min(d0, d1);
+			dec[0] |= (uint32_t)(e0 > e1) << j;
+			dec[1] |= (uint32_t)(d0 > d1) << j;
+		}
+		for(j=0;j<CONV_STATES;j++)
+			v->metric[j] = ((t % CONV_NORMALIZE) == CONV_NORMALIZE - 1) ? n[j] - n[0] : n[j];
+	}
+#endif
+}
+
+
+//! trace back and write the decoded bits
+
+//! @param v decoder
+//! @param dest output data
+//! @param state state after step end - 1
+//! @param end step to start at (exclusive)
+//! @param first oldest step to trace back to
+//! @param out_from steps from here to end - 1 are not written
+static void conv_traceback(const conv_viterbi_t *v, uint8_t *dest, uint_fast8_t state, int end, int first, int out_from)
+{
+	int t;
+	for(t=end-1;t>=out_from;t--) {
+		const uint32_t *dec = v->dec[t & (CONV_RING - 1)];
+		state = (state >> 1) | (((dec[state & 1] >> (state >> 1)) & 1) << 5);
+	}
+	for(;t>=first;t--) {
+		const uint32_t *dec = v->dec[t & (CONV_RING - 1)];
+		dest[t>>3] = (dest[t>>3] & ~BIT(t & 7)) | ((state & 1) << (t & 7));
+		state = (state >> 1) | (((dec[state & 1] >> (state >> 1)) & 1) << 5);
+	}
+}
+
+
+//! viterbi decode from soft symbols or hard bits
+
+//! @param dest output data (len bytes), can be the same as the input
+//! @param soft soft symbols, or NULL
+//! @param hard hard bits (CONV_ENC_LEN(len) bytes), if soft is NULL
+//! @param len length of dest
+static void conv_decode(uint8_t *dest, const uint8_t *soft, const uint8_t *hard, int len)
+{
+	conv_viterbi_t v;
+	int16_t mask_a[CONV_STATES/2], mask_b[CONV_STATES/2];
+	int t=0, steps = (len << 3) + CONV_K - 1, done=0;
+	uint_fast8_t i, best;
+
+	conv_butterfly_masks(mask_a, mask_b);
+	for(i=0;i<CONV_STATES;i++)
+		v.metric[i] = i ? 1000 : 0; //encoder starts in state 0
+	//when the ring is full decide all but the newest CONV_TRACEBACK bits from the best state
+	while(steps - done > CONV_RING) {
+		int end = done + CONV_RING;
+		conv_run(&v, mask_a, mask_b, soft, hard, t, end);
+		t = end;
+		for(i=1,best=0;i<CONV_STATES;i++) {
+			if(v.metric[i] < v.metric[best])
+				best = i;
+		}
+		conv_traceback(&v, dest, best, t, done, t - CONV_TRACEBACK);
+		done = t - CONV_TRACEBACK;
+	}
+	conv_run(&v, mask_a, mask_b, soft, hard, t, steps);
+	conv_traceback(&v, dest, 0, steps, done, len << 3); //terminated in state 0
+}
+
+
+//! viterbi decode soft symbols
+
+//! @param dest output data (len bytes), can be the same buffer as soft
+//! @param soft soft symbols, 2 per bit (CONV_ENC_LEN(len) * 8 - 4)
+//! @param len length of dest
+void conv_decode_soft(uint8_t *dest, const uint8_t *soft, int len)
+{
+	conv_decode(dest, soft, NULL, len);
+}
+
+
+//! viterbi decode hard bits
+
+//! the buffer is decoded in place
+//! @param buf input/output data
+//! @param len length of input data (CONV_ENC_LEN() of the output)
+void conv_decode_buf(uint8_t *buf, int len)
+{
+	conv_decode(buf, NULL, buf, CONV_DEC_LEN(len));
+}
+#endif //CONFIG_CONV
@@ -0,0 +1,41 @@
+//! Convolutional code K=7 r=1/2 with Viterbi decoder
+
+//! @file conv.h
+//!
+//! The NASA/CCSDS code with the polynomials 171 and 133 (octal), as used by
+//! most long range links. Every data bit gives two code bits (polynomial A
+//! first), the frame is terminated with 6 zero bits, so len bytes are encoded
+//! to 2 * len + 2 bytes (the last 4 bits are padding).
+//! The register has the newest bit in bit 0, so the polynomials are 0x4F and 0x6D.
+//!
+//! The Viterbi decoder keeps all 64 path metrics in 16 bit, the
+//! add-compare-select runs as 4 butterfly vectors with SSE2 when available.
+//! Decisions are kept in a ring and traced back CONV_TRACEBACK bits behind,
+//! so frames of any length are decoded with a fixed amount of memory.
+//!
+//! Soft symbols are one byte per code bit, 0 = certain 0, 255 = certain 1,
+//! 128 = unknown (erasure, punctured).
+
+#ifndef CONV_H
+#define CONV_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+#define CONV_POLY_A 0x4F   //!< 171 octal, newest bit in bit 0
+#define CONV_POLY_B 0x6D   //!< 133 octal, newest bit in bit 0
+#define CONV_K 7           //!< constraint length
+#define CONV_STATES 64
+#define CONV_TRACEBACK 64  //!< decoding depth, decisions are made this many bits behind
+
+#define CONV_ENC_LEN(len) (((len) << 1) + 2) //!< encoded length of len bytes
+#define CONV_DEC_LEN(len) (((len) - 2) >> 1) //!< decoded length of len bytes
+
+#ifdef CONFIG_CONV
+void conv_encode_buf(uint8_t *dest, const uint8_t *buf, int len);
+void conv_decode_soft(uint8_t *dest, const uint8_t *soft, int len);
+void conv_decode_buf(uint8_t *buf, int len);
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+//! CRC8/CRC16 (MSB first, no reflection)
+
+//! @file crc.c
+
+
+#include "crc.h"
+
+
+#ifdef CONFIG_CRC_LOOKUP
+static const uint8_t crc8_lookup[16] = {
+	0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15,
+	0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D
+};
+
+static const uint16_t crc16_lookup[16] = {
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+#endif
+
+
+//! update a crc8 with an array
+
+//! @param crc previous crc (or init value)
+//! @param poly polynomial without the x^8 term
+//! @param buf input data
+//! @param len length of buf
+uint_fast8_t crc8_update(uint_fast8_t crc, uint_fast8_t poly, const uint8_t *buf, int len)
+{
+	int i;
+	uint_fast8_t j;
+#ifdef CONFIG_CRC_LOOKUP
+	if(poly == CRC8_POLY) {
+		for(i=0;i<len;i++) {
+			crc ^= buf[i];
+			crc = (crc << 4) ^ crc8_lookup[crc >> 4];
+			crc = ((crc << 4) ^ crc8_lookup[(crc >> 4) & 0x0f]) & 0xff;
+		}
+		return(crc);
+	}
+#endif
+	for(i=0;i<len;i++) {
+		crc ^= buf[i];
+		for(j=0;j<8;j++)
+			crc = ((crc & 0x80) ? ((crc << 1) ^ poly) : (crc << 1)) & 0xff;
+	}
+	return(crc);
+}
+
+
+//! update a crc16 with an array
+
+//! @param crc previous crc (or init value)
+//! @param poly polynomial without the x^16 term
+//! @param buf input data
+//! @param len length of buf
+uint_fast16_t crc16_update(uint_fast16_t crc, uint_fast16_t poly, const uint8_t *buf, int len)
+{
+	int i;
+	uint_fast8_t j;
+#ifdef CONFIG_CRC_LOOKUP
+	if(poly == CRC16_POLY) {
+		for(i=0;i<len;i++) {
+			crc = ((crc << 4) ^ crc16_lookup[(crc >> 12) ^ (buf[i] >> 4)]) & 0xffff;
+			crc = ((crc << 4) ^ crc16_lookup[(crc >> 12) ^ (buf[i] & 0x0f)]) & 0xffff;
+		}
+		return(crc);
+	}
+#endif
+	for(i=0;i<len;i++) {
+		crc ^= buf[i] << 8;
+		for(j=0;j<8;j++)
+			crc = ((crc & 0x8000) ? ((crc << 1) ^ poly) : (crc << 1)) & 0xffff;
+	}
+	return(crc);
+}
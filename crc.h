@@ -0,0 +1,22 @@
+//! CRC8/CRC16 (MSB first, no reflection)
+
+//! @file crc.h
+//!
+//! The default polynomials have a 16 entry nibble lookup table (CONFIG_CRC_LOOKUP),
+//! other polynomials are calculated bitwise
+
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+#include "config.h"
+
+#define CRC8_POLY  0x07   //!< CRC-8 (ATM)
+#define CRC16_POLY 0x1021 //!< CRC-16-CCITT
+#define CRC8_INIT  0x00
+#define CRC16_INIT 0xFFFF
+
+uint_fast8_t crc8_update(uint_fast8_t crc, uint_fast8_t poly, const uint8_t *buf, int len);
+uint_fast16_t crc16_update(uint_fast16_t crc, uint_fast16_t poly, const uint8_t *buf, int len);
+
+#endif
@@ -0,0 +1,285 @@
+//! Streaming deframer, continuous chip stream to frames
+
+//! @file deframer.c
+
+
+#include <string.h>
+#include "deframer.h"
+#include "helper.h"
+
+
+//! check if a codec can decode the start of a frame on its own
+
+//! @retval 1 line code, decodes any prefix
+//! @retval 0 trailer (crc), leaves the prefix untouched
+//! @retval -1 not supported between the length and the sync word
+static int deframer_prefix_codec(const bytecodec_t *codec)
+{
+	switch(codec->id) {
+	case BYTECODEC_MANCHESTER_GE_THOMAS:
+	case BYTECODEC_MANCHESTER_IEEE802_3:
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T0:
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T1:
+	case BYTECODEC_BMC:
+	case BYTECODEC_NRZI:
+	case BYTECODEC_MILLER:
+	case BYTECODEC_HAMMING_8_4:
+	case BYTECODEC_4B5B:
+	case BYTECODEC_8B10B:
+	case BYTECODEC_WHITENING:
+		return(1);
+	case BYTECODEC_CRC8:
+	case BYTECODEC_CRC16:
+	case BYTECODEC_REED_SOLOMON: //systematic, the data comes first
+		return(0);
+	default:
+		return(-1);
+	}
+}
+
+
+//! prepare a deframer for a chain
+
+//! @param d deframer
+//! @param chain chain in encoding order, must contain a BYTECODEC_SYNC_WORD
+//! @param buf buffer for the on air frame (chain->dec_buf_len + 1)
+//! @param out buffer for the decoded frame (same size as buf)
+//! @param buf_len length of buf and out
+//! @param cb called for every valid frame
+//! @param ctx passed to cb
+//! @retval 0 ok
+//! @retval -1 chain can not be deframed, or buf_len can not hold a frame
+int deframer_init(deframer_t *d, const bytecodec_chain_t *chain, uint8_t *buf, uint8_t *out, int buf_len, deframer_cb_t cb, void *ctx)
+{
+	int i, amount = bc_chain_amount(chain);
+	const bytecodec_t *sync;
+
+	memset(d, 0, sizeof(*d));
+	d->chain = chain;
+	d->buf = buf;
+	d->out = out;
+	d->buf_len = buf_len;
+	d->cb = cb;
+	d->ctx = ctx;
+
+	for(d->body=0;d->body<amount;d->body++) {
+		if(chain->codec[d->body].id == BYTECODEC_SYNC_WORD)
+			break;
+	}
+	if(d->body == amount)
+		return(-1);
+	sync = &chain->codec[d->body];
+	if(sync->opt[1] < 1 || sync->opt[1] > 4)
+		return(-1);
+	d->sync_bits = sync->opt[1] << 3;
+	d->sync_mask = (d->sync_bits == 32) ? 0xffffffff : (((uint32_t)1 << d->sync_bits) - 1);
+	d->sync_errors = sync->opt[2];
+	for(i=0;i<(int)sync->opt[1];i++)
+		d->sync |= (uint32_t)READ_BYTE(sync->opt[0], sync->opt[1]-i-1) << (i << 3);
+
+	for(d->len_codec=d->body-1;d->len_codec>=0;d->len_codec--) {
+		if(chain->codec[d->len_codec].id == BYTECODEC_ENCODED_LENGTH || chain->codec[d->len_codec].id == BYTECODEC_FIXED_LENGTH)
+			break;
+	}
+	if(d->len_codec < 0)
+		return(-1);
+	if(chain->codec[d->len_codec].id == BYTECODEC_FIXED_LENGTH) {
+		d->fixed_len = chain->codec[d->len_codec].opt[0];
+		for(i=d->len_codec+1;i<d->body;i++)
+			d->fixed_len = bc_encoded_len(&chain->codec[i], d->fixed_len);
+	} else {
+		d->hdr_len = chain->codec[d->len_codec].opt[0] + bc_len_field_bytes(&chain->codec[d->len_codec]);
+		for(i=d->len_codec+1;i<d->body;i++) {
+			int r = deframer_prefix_codec(&chain->codec[i]);
+			if(r < 0)
+				return(-1);
+			if(r)
+				d->hdr_len = bc_encoded_len(&chain->codec[i], d->hdr_len);
+		}
+		if(d->hdr_len > DEFRAMER_HDR_MAX)
+			return(-1);
+	}
+	if(d->fixed_len >= buf_len || d->hdr_len >= buf_len)
+		return(-1);
+	return(0);
+}
+
+
+//! forget the stream, keeps the statistics
+void deframer_reset(deframer_t *d)
+{
+	d->window = 0;
+	d->collecting = false;
+	d->candidates = 0;
+}
+
+
+//! append up to 8 chips to the collected frame
+
+//! @param v chips, bits above n have to be zero
+static void deframer_append(deframer_t *d, uint_fast8_t v, uint_fast8_t n)
+{
+	int i = d->bits >> 3;
+	uint_fast8_t s = d->bits & 7;
+	if(s) {
+		d->buf[i] |= v << s;
+		if(s + n > 8)
+			d->buf[i+1] = v >> (8 - s);
+	} else {
+		d->buf[i] = v;
+	}
+	d->bits += n;
+}
+
+
+//! decode the length field from the start of the collected frame
+
+//! @return on air length of the frame in bytes, or -1 on error
+static int deframer_header(deframer_t *d)
+{
+	uint8_t tmp[DEFRAMER_HDR_MAX];
+	const bytecodec_t *codec = d->chain->codec;
+	int i, len = d->hdr_len;
+	bc_len_t encoded_len;
+
+	memcpy(tmp, d->buf, len);
+	for(i=d->body-1;i>d->len_codec && len>=0;i--) {
+		if(deframer_prefix_codec(&codec[i]) > 0)
+			len = bc_decode(&codec[i], tmp, len);
+	}
+	if(len < 0)
+		return(-1);
+#ifdef CONFIG_BYTECODER_BIGLEN
+	encoded_len = bc_decode_len(tmp, len, codec[d->len_codec].opt[0], bc_len_field_bytes(&codec[d->len_codec]), codec[d->len_codec].opt[2]);
+#else
+	encoded_len = bc_decode_len(tmp, len, codec[d->len_codec].opt[0]);
+#endif
+	len = codec[d->len_codec].opt[0] + bc_len_field_bytes(&codec[d->len_codec]) + encoded_len;
+	for(i=d->len_codec+1;i<d->body;i++)
+		len = bc_encoded_len(&codec[i], len);
+	if(len < d->hdr_len || len >= d->buf_len)
+		return(-1);
+	return(len);
+}
+
+
+//! restart collecting at the first sync word found after start
+
+//! @param end drop candidates before this stream position
+static void deframer_restart(deframer_t *d, uint64_t end)
+{
+	uint_fast8_t i;
+	int shift;
+	while(d->candidates && d->candidate[0] < end) {
+		d->candidates--;
+		for(i=0;i<d->candidates;i++)
+			d->candidate[i] = d->candidate[i+1];
+	}
+	if(!d->candidates) {
+		d->collecting = false;
+		return;
+	}
+	shift = d->candidate[0] - d->start;
+	lshift_bytes(d->buf, (d->bits + 7) >> 3, shift >> 3);
+	d->bits -= shift & ~7;
+	lshift_bits(d->buf, (d->bits + 7) >> 3, shift & 7);
+	d->bits -= shift & 7;
+	d->start = d->candidate[0];
+	d->need = d->fixed_len;
+	d->candidates--;
+	for(i=0;i<d->candidates;i++)
+		d->candidate[i] = d->candidate[i+1];
+}
+
+
+//! decode the collected frame and pass it on
+
+//! @param chunk current chunk, for zero copy references
+//! @param chunk_pos stream position of chunk
+//! @param chunk_len length of chunk
+static void deframer_complete(deframer_t *d, const uint8_t *chunk, uint64_t chunk_pos, size_t chunk_len)
+{
+	deframer_frame_t frame;
+	uint64_t end = d->start + ((uint64_t)d->need << 3);
+	int len = d->need;
+
+	memcpy(d->out, d->buf, len);
+	len = bc_decode_codecs(d->chain->codec, d->body, d->out, len);
+	if(len < 0) {
+		d->failures++;
+		deframer_restart(d, d->start + 1);
+		return;
+	}
+	frame.data = d->out;
+	frame.len = len;
+	frame.raw_len = d->need;
+	frame.bit_offset = d->start;
+	if(d->start >= chunk_pos && end <= chunk_pos + ((uint64_t)chunk_len << 3)) {
+		frame.raw = chunk + ((d->start - chunk_pos) >> 3);
+		frame.raw_bit = (d->start - chunk_pos) & 7;
+	} else {
+		frame.raw = NULL;
+		frame.raw_bit = 0;
+	}
+	d->frames++;
+	if(d->cb)
+		d->cb(d->ctx, &frame);
+	deframer_restart(d, end);
+}
+
+
+//! feed a chunk of the chip stream
+
+//! valid frames are passed to the callback before this returns
+//! @param d deframer
+//! @param chunk chips, first chip is the LSB of chunk[0]
+//! @param len length of chunk
+void deframer_push(deframer_t *d, const uint8_t *chunk, size_t len)
+{
+	uint64_t chunk_pos = d->pos;
+	size_t n;
+	for(n=0;n<len;n++) {
+		uint_fast8_t b = chunk[n], j, found = 0;
+		d->window = (d->window >> 8) | ((uint64_t)b << 56);
+		for(j=0;j<8;j++) {
+			uint32_t v = (d->window >> (57 + j - d->sync_bits)) & d->sync_mask;
+			if(v == d->sync || (d->sync_errors && count_set_bits(v ^ d->sync) <= d->sync_errors))
+				SET_BIT(found, j);
+		}
+
+		if(d->collecting) {
+			deframer_append(d, b, 8);
+		} else if(found) {
+			for(j=0;!READ_BIT(found, j);j++);
+			CLR_BITS(found, BIT(j));
+			d->collecting = true;
+			d->start = d->pos + j + 1;
+			d->bits = 0;
+			d->need = d->fixed_len;
+			d->candidates = 0;
+			if(j < 7)
+				deframer_append(d, b >> (j + 1), 7 - j);
+		}
+		for(j=0;found && j<8;j++) {
+			if(READ_BIT(found, j) && d->candidates < DEFRAMER_CANDIDATES)
+				d->candidate[d->candidates++] = d->pos + j + 1;
+			CLR_BITS(found, BIT(j));
+		}
+		d->pos += 8;
+
+		while(d->collecting) {
+			if(!d->need && d->bits >= (d->hdr_len << 3)) {
+				d->need = deframer_header(d);
+				if(d->need < 0) {
+					d->need = 0;
+					d->failures++;
+					deframer_restart(d, d->start + 1);
+				}
+			} else if(d->need && d->bits >= (d->need << 3)) {
+				deframer_complete(d, chunk, chunk_pos, len);
+			} else {
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,89 @@
+//! Streaming deframer, continuous chip stream to frames
+
+//! @file deframer.h
+//!
+//! The deframer hunts for the sync word of a bytecodec chain in an unaligned
+//! chip stream (first chip is the LSB of the first byte, like the rest of the
+//! codecs), collects the frame, and runs the decode chain on it.
+//! The stream can be pushed in chunks of any size.
+//!
+//! The chain is given in encoding order, everything before the first
+//! BYTECODEC_SYNC_WORD is the frame body, everything after it is ignored
+//! (preamble). The body needs a BYTECODEC_FIXED_LENGTH or a
+//! BYTECODEC_ENCODED_LENGTH codec, codecs after it can only be line codes,
+//! whitening or CRCs, so the length can be decoded from the start of the frame.
+//!
+//! The sync hunter keeps running while a frame is collected, every sync word
+//! inside the frame is kept as a candidate. When a frame fails (invalid length,
+//! line code or CRC error) the deframer restarts at the next candidate from its
+//! own buffer, so a false sync does not hide a frame that starts inside it.
+//!
+//! Throughput target: 100 MB/s (800 Mchip/s) of stream on a single x86-64
+//! core. The hunter is one shift and 8 masked compares per byte, the collector
+//! a shift and two stores. With a 16 bit sync word, the deframer_push entries
+//! of make bench measured about 100 MB/s of noise with -O2 and 60 MB/s with the
+//! -Os of the Makefile for an exact sync, 33 and 19 MB/s with one sync bit
+//! error allowed, which counts the bits of every compare that misses.
+//! Frame decoding (line code, crc) comes on top of that and dominates on busy
+//! channels.
+
+#ifndef DEFRAMER_H
+#define DEFRAMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "bytecoder.h"
+
+#define DEFRAMER_CANDIDATES 4 //!< sync words remembered while collecting a frame
+#define DEFRAMER_HDR_MAX 32   //!< maximum on air bytes needed to decode the length
+
+
+typedef struct {
+	const uint8_t *data;    //!< decoded frame, valid during the callback
+	int len;                //!< length of data
+	const uint8_t *raw;     //!< on air frame inside the pushed chunk (zero copy), NULL if it spans chunks
+	uint_fast8_t raw_bit;   //!< bit offset of the first chip in raw[0]
+	int raw_len;            //!< on air length in bytes (without sync word)
+	uint64_t bit_offset;    //!< stream position of the first chip after the sync word
+} deframer_frame_t;
+
+
+typedef void (*deframer_cb_t)(void *ctx, const deframer_frame_t *frame);
+
+
+typedef struct {
+	const bytecodec_chain_t *chain;
+	int body;        //!< amount of codecs in the frame body
+	int len_codec;   //!< index of the codec giving the frame length
+	int hdr_len;     //!< on air bytes needed to decode the length
+	int fixed_len;   //!< on air length of fixed length frames, 0 if encoded
+	uint32_t sync;   //!< sync word in stream order
+	uint32_t sync_mask;
+	uint_fast8_t sync_bits;
+	uint_fast8_t sync_errors; //!< accepted bit errors in the sync word
+	uint8_t *buf;    //!< collected on air frame
+	uint8_t *out;    //!< decoded frame
+	int buf_len;
+	deframer_cb_t cb;
+	void *ctx;
+
+	uint64_t window; //!< last 64 chips, newest in the MSB
+	uint64_t pos;    //!< chips consumed
+	uint64_t start;  //!< stream position of the frame being collected
+	bool collecting;
+	int bits;        //!< chips collected
+	int need;        //!< on air length of the frame in bytes, 0 if unknown
+	uint64_t candidate[DEFRAMER_CANDIDATES];
+	uint_fast8_t candidates;
+
+	unsigned long frames;   //!< valid frames
+	unsigned long failures; //!< frames failing length, line code or crc check
+} deframer_t;
+
+
+int deframer_init(deframer_t *d, const bytecodec_chain_t *chain, uint8_t *buf, uint8_t *out, int buf_len, deframer_cb_t cb, void *ctx);
+void deframer_reset(deframer_t *d);
+void deframer_push(deframer_t *d, const uint8_t *chunk, size_t len);
+
+#endif
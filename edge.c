@@ -0,0 +1,119 @@
+//! Edge capture ring
+
+//! @file edge.c
+
+
+#include "config.h"
+#include "edge.h"
+
+
+#ifdef CONFIG_EDGE
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#define edge_acquire(x) atomic_load_explicit(&(x), memory_order_acquire)     //!< index written by the other side
+#define edge_relaxed(x) atomic_load_explicit(&(x), memory_order_relaxed)     //!< index written by this side
+#define edge_release(x, v) atomic_store_explicit(&(x), (v), memory_order_release)
+#else
+#define edge_barrier() __asm volatile("" ::: "memory")
+#define edge_acquire(x) ({ edge_index_t v_ = (x); edge_barrier(); v_; })
+#define edge_relaxed(x) (x)
+#define edge_release(x, v) do { edge_barrier(); (x) = (v); } while(0)
+#endif
+
+
+//! empty a ring
+void edge_ring_init(edge_ring_t *r)
+{
+	edge_release(r->head, 0);
+	edge_release(r->tail, 0);
+	edge_release(r->overflows, 0);
+	r->dropped = 0;
+}
+
+
+//! add an edge, called by the producer (interrupt) only
+
+//! @param r ring
+//! @param time time stamp of the edge in ticks
+//! @retval true stored
+//! @retval false ring full, the edge is dropped
+bool edge_ring_push(edge_ring_t *r, uint32_t time)
+{
+	edge_index_t head = edge_relaxed(r->head);
+	if((edge_index_t)(head - edge_acquire(r->tail)) >= EDGE_RING_LEN) {
+		//only the parity and not 0 matter to the decoder
+		r->dropped = (r->dropped < 254) ? r->dropped + 1 : r->dropped ^ 1;
+		edge_release(r->overflows, edge_relaxed(r->overflows) + 1);
+		return(false);
+	}
+	r->time[head & (EDGE_RING_LEN - 1)] = time;
+	r->lost[head & (EDGE_RING_LEN - 1)] = r->dropped;
+	r->dropped = 0;
+	edge_release(r->head, head + 1);
+	return(true);
+}
+
+
+//! amount of edges waiting, for the consumer
+uint_fast16_t edge_ring_count(edge_ring_t *r)
+{
+	return((edge_index_t)(edge_acquire(r->head) - edge_relaxed(r->tail)));
+}
+
+
+//! take edges out of the ring, called by the consumer only
+
+//! @param r ring
+//! @param dest time stamps
+//! @param max maximum amount of edges
+//! @return amount of edges
+uint_fast16_t edge_ring_read(edge_ring_t *r, uint32_t *dest, uint_fast16_t max)
+{
+	edge_index_t tail = edge_relaxed(r->tail);
+	uint_fast16_t n = (edge_index_t)(edge_acquire(r->head) - tail), i;
+	if(n > max)
+		n = max;
+	for(i=0;i<n;i++)
+		dest[i] = r->time[(edge_index_t)(tail + i) & (EDGE_RING_LEN - 1)];
+	edge_release(r->tail, tail + n);
+	return(n);
+}
+
+
+#ifdef CONFIG_PULSE
+//! drain the ring into a pulse decoder
+
+//! edges are taken in batches of EDGE_BATCH while dest has room for them
+//! @param r ring
+//! @param p decoder, gets the lost edges at the place they were dropped
+//! @param dest decoded bytes
+//! @param max size of dest
+//! @return amount of decoded bytes
+long edge_ring_decode(edge_ring_t *r, pulse_t *p, uint8_t *dest, long max)
+{
+	uint32_t batch[EDGE_BATCH];
+	edge_index_t tail;
+	uint_fast16_t n, i;
+	long out = 0;
+	while(out + PULSE_OUT_MAX(EDGE_BATCH) <= max) {
+		tail = edge_relaxed(r->tail);
+		n = (edge_index_t)(edge_acquire(r->head) - tail);
+		if(!n)
+			break;
+		if(n > EDGE_BATCH)
+			n = EDGE_BATCH;
+		if(r->lost[tail & (EDGE_RING_LEN - 1)])
+			pulse_lost(p, r->lost[tail & (EDGE_RING_LEN - 1)]);
+		//a batch ends in front of the next edge with drops before it
+		for(i=0;i<n;i++) {
+			edge_index_t k = (edge_index_t)(tail + i) & (EDGE_RING_LEN - 1);
+			if(i && r->lost[k])
+				break;
+			batch[i] = r->time[k];
+		}
+		edge_release(r->tail, tail + i);
+		out += pulse_decode_edges(p, dest + out, batch, i);
+	}
+	return(out);
+}
+#endif
+#endif //CONFIG_EDGE
@@ -0,0 +1,78 @@
+//! Edge capture ring
+
+//! @file edge.h
+//!
+//! Time stamps of pin edges go from an interrupt (or a capture thread on a
+//! host) to the decoding loop through a lock free single producer, single
+//! consumer ring. The producer only writes head, the consumer only writes
+//! tail, both are free running counters, so the ring needs no lock and no
+//! interrupts have to be disabled while draining it.
+//!
+//! With C11 atomics the indices are exchanged with release/acquire order,
+//! which is what a consumer on another core needs. Without them (small MCUs,
+//! interrupt and main loop on one core) they are volatile and a compiler
+//! barrier keeps the time stamps written before the index. The indices have
+//! the width of the CPU word, 8 bit on AVR and 16 bit on MSP430, so they are
+//! read and written in one instruction and need no atomic library calls.
+//!
+//! A full ring drops the new edge and counts it in overflows. The next edge
+//! which is stored carries the amount of edges dropped right in front of it
+//! (lost[], written with the time stamp before head), so every drop stays at
+//! its place however far the consumer is behind. edge_ring_decode() tells the
+//! decoder about the lost edges before that edge, which keeps the level of
+//! the pulses right and makes it synchronize again.
+
+#ifndef EDGE_H
+#define EDGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "pulse.h"
+
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define EDGE_ATOMIC _Atomic
+#else
+#define EDGE_ATOMIC volatile
+#endif
+
+#ifdef __AVR__
+#ifndef EDGE_RING_LEN
+#define EDGE_RING_LEN 64      //!< edges in the ring, a power of 2 (up to 128 on AVR)
+#endif
+typedef uint8_t edge_index_t;
+#elif defined(__MSP430__)
+#ifndef EDGE_RING_LEN
+#define EDGE_RING_LEN 256     //!< edges in the ring, a power of 2 (up to 32768 on MSP430)
+#endif
+typedef uint16_t edge_index_t;
+#else
+#ifndef EDGE_RING_LEN
+#define EDGE_RING_LEN 1024    //!< edges in the ring, a power of 2
+#endif
+typedef uint32_t edge_index_t;
+#endif
+
+#define EDGE_BATCH 64         //!< edges handed to the decoder at a time
+
+typedef struct {
+	EDGE_ATOMIC edge_index_t head;      //!< edges written, producer only
+	EDGE_ATOMIC edge_index_t tail;      //!< edges read, consumer only
+	EDGE_ATOMIC edge_index_t overflows; //!< edges dropped, producer only
+	uint8_t dropped;                    //!< edges dropped since the last stored one (parity kept above 253), producer only
+	uint32_t time[EDGE_RING_LEN];       //!< time stamps in ticks
+	uint8_t lost[EDGE_RING_LEN];        //!< edges dropped right before the edge, see dropped
+} edge_ring_t;
+
+#ifdef CONFIG_EDGE
+void edge_ring_init(edge_ring_t *r);
+bool edge_ring_push(edge_ring_t *r, uint32_t time);
+uint_fast16_t edge_ring_count(edge_ring_t *r);
+uint_fast16_t edge_ring_read(edge_ring_t *r, uint32_t *dest, uint_fast16_t max);
+#ifdef CONFIG_PULSE
+long edge_ring_decode(edge_ring_t *r, pulse_t *p, uint8_t *dest, long max);
+#endif
+#endif
+
+#endif
@@ -0,0 +1,386 @@
+//! Forward error correction, Hamming(8,4) and Reed-Solomon
+
+//! @file fec.c
+
+
+#include <string.h>
+#include "config.h"
+#if defined(CONFIG_REED_SOLOMON) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "fec.h"
+#if defined(CONFIG_HAMMING_LOOKUP) || defined(CONFIG_REED_SOLOMON)
+#include "fec_lookup.h"
+#endif
+
+
+#ifdef CONFIG_HAMMING
+//! hamming(8,4) encode a nibble
+
+//! @return code byte, data in bits 0-3
+uint_fast8_t hamming_encode_nibble(uint_fast8_t nibble)
+{
+#ifdef CONFIG_HAMMING_LOOKUP
+	return(hamming_enc_lookup[nibble & 0x0f]);
+#else
+	uint_fast8_t d0 = READ_BIT(nibble, 0), d1 = READ_BIT(nibble, 1), d2 = READ_BIT(nibble, 2), d3 = READ_BIT(nibble, 3);
+	uint_fast8_t out = (nibble & 0x0f) | ((d0 ^ d1 ^ d3) << 4) | ((d0 ^ d2 ^ d3) << 5) | ((d1 ^ d2 ^ d3) << 6);
+	return(out | ((count_set_bits(out) & 1) << 7));
+#endif
+}
+
+
+//! hamming(8,4) decode a code byte
+
+//! @return nibble, with HAMMING_CORRECTED or HAMMING_UNCORRECTABLE set
+uint_fast8_t hamming_decode_byte(uint_fast8_t in)
+{
+#ifdef CONFIG_HAMMING_LOOKUP
+	return(hamming_dec_lookup[in]);
+#else
+	uint_fast8_t i, best=0, distance=8;
+	for(i=0;i<16;i++) {
+		uint_fast8_t d = count_set_bits(in ^ hamming_encode_nibble(i));
+		if(d < distance) {
+			distance = d;
+			best = i;
+		}
+	}
+	if(distance == 0)
+		return(best);
+	if(distance == 1)
+		return(best | HAMMING_CORRECTED);
+	return(HAMMING_UNCORRECTABLE);
+#endif
+}
+
+
+//! hamming(8,4) encode an array, low nibble first
+
+//! the buffer is encoded in place, therefore the buffer needs to be len * 2
+//! @param buf input/output data
+//! @param len length of input data
+void hamming_encode_buf(uint8_t *buf, int len)
+{
+	int i;
+	for(i=len-1;i>=0;i--) {
+		uint_fast8_t tmp = buf[i];
+		buf[(i<<1)+1] = hamming_encode_nibble(tmp >> 4);
+		buf[i<<1] = hamming_encode_nibble(tmp);
+	}
+}
+
+
+//! hamming(8,4) decode an array
+
+//! the buffer is decoded in place to len / 2 bytes
+//! @param buf input/output data
+//! @param len length of input data
+//! @param corrected corrected bit errors are added here, can be NULL
+//! @return amount of uncorrectable code bytes, 0 = ok
+int hamming_decode_buf(uint8_t *buf, int len, int *corrected)
+{
+	int i, errors=0, fixed=0;
+	for(i=0;i+1<len;i+=2) {
+		uint_fast8_t lo = hamming_decode_byte(buf[i]), hi = hamming_decode_byte(buf[i+1]);
+		fixed += READ_BIT(lo, 4) + READ_BIT(hi, 4);
+		errors += READ_BIT(lo, 5) + READ_BIT(hi, 5);
+		buf[i>>1] = (lo & 0x0f) | (hi << 4);
+	}
+	if(corrected)
+		*corrected += fixed;
+	return(errors);
+}
+#endif //CONFIG_HAMMING
+
+
+#ifdef CONFIG_REED_SOLOMON
+//! multiply in GF(256)
+uint_fast8_t gf_mul(uint_fast8_t a, uint_fast8_t b)
+{
+	if(!a || !b)
+		return(0);
+	return(gf_exp[gf_log[a] + gf_log[b]]);
+}
+
+
+//! divide in GF(256), b must not be 0
+uint_fast8_t gf_div(uint_fast8_t a, uint_fast8_t b)
+{
+	if(!a)
+		return(0);
+	return(gf_exp[gf_log[a] + 255 - gf_log[b]]);
+}
+
+
+//! alpha^n for any n >= 0
+#define gf_pow_alpha(n) (gf_exp[(n) % 255])
+
+
+//! evaluate a polynomial (p[i] is the coefficient of x^i) at alpha^n
+static uint_fast8_t gf_poly_eval(const uint8_t *p, int degree, int n)
+{
+	uint_fast8_t out=0;
+	int i;
+	for(i=degree;i>=0;i--) {
+		out = gf_mul(out, gf_pow_alpha(n)) ^ p[i];
+	}
+	return(out);
+}
+
+
+//! prepare the generator polynomial
+
+//! @param rs codec to fill
+//! @param nsym parity bytes per block (1 - RS_MAX_NSYM)
+//! @retval 0 ok
+//! @retval -1 unsupported amount of parity bytes
+int rs_init(rs_t *rs, uint_fast8_t nsym)
+{
+	uint_fast8_t i, j;
+	if(!nsym || nsym > RS_MAX_NSYM)
+		return(-1);
+	rs->nsym = nsym;
+	memset(rs->gen, 0, sizeof(rs->gen));
+	rs->gen[0] = 1;
+	for(i=0;i<nsym;i++) { //multiply by (x + alpha^i)
+		for(j=i+1;j>0;j--)
+			rs->gen[j] = rs->gen[j-1] ^ gf_mul(rs->gen[j], gf_exp[i]);
+		rs->gen[0] = gf_mul(rs->gen[0], gf_exp[i]);
+	}
+	return(0);
+}
+
+
+//! length of a frame with parity bytes
+int rs_encoded_len(uint_fast8_t nsym, int len)
+{
+	int k = RS_BLOCK_LEN - nsym;
+	return(len + ((len + k - 1) / k) * nsym);
+}
+
+
+//! length of a frame without parity bytes, -1 if len is not a valid frame length
+int rs_decoded_len(uint_fast8_t nsym, int len)
+{
+	int blocks = (len + RS_BLOCK_LEN - 1) / RS_BLOCK_LEN;
+	if(len - (blocks - 1) * RS_BLOCK_LEN <= nsym && len)
+		return(-1);
+	return(len - blocks * nsym);
+}
+
+
+//! calculate the parity bytes of a block
+
+//! @param rs codec
+//! @param msg data
+//! @param len length of msg (up to RS_BLOCK_LEN - nsym)
+//! @param parity nsym parity bytes, sent after the data
+void rs_encode_block(const rs_t *rs, const uint8_t *msg, int len, uint8_t *parity)
+{
+	uint8_t rem[RS_MAX_NSYM];
+	uint_fast8_t glog[RS_MAX_NSYM];
+	int nsym = rs->nsym, i, j;
+	memset(rem, 0, nsym);
+	for(j=0;j<nsym;j++)
+		glog[j] = gf_log[rs->gen[j]];
+	for(i=0;i<len;i++) {
+		uint_fast8_t fb = msg[i] ^ rem[nsym-1];
+		if(fb) {
+			uint_fast16_t lf = gf_log[fb];
+			for(j=nsym-1;j>0;j--)
+				rem[j] = rem[j-1] ^ (rs->gen[j] ? gf_exp[lf + glog[j]] : 0);
+			rem[0] = rs->gen[0] ? gf_exp[lf + glog[0]] : 0;
+		} else {
+			memmove(rem + 1, rem, nsym - 1);
+			rem[0] = 0;
+		}
+	}
+	for(j=0;j<nsym;j++)
+		parity[j] = rem[nsym-1-j];
+}
+
+
+//! calculate the syndromes of a block
+
+//! synd[i] is the received block evaluated at alpha^i
+//! @param nsym amount of syndromes
+//! @param buf block, first byte is the highest power
+//! @param len length of buf
+//! @param synd nsym syndromes
+//! @return true if any syndrome is not 0 (block has errors)
+bool rs_syndromes(uint_fast8_t nsym, const uint8_t *buf, int len, uint8_t *synd)
+{
+	uint_fast8_t i=0, any=0;
+	int j;
+#ifdef __SSE2__
+	//16 syndromes at a time, s = s * alpha^i + buf[j], the multiplication by
+	//the lane constant is bit sliced: XOR of alpha^(i+b) for every set bit b of s
+	for(;i+16<=nsym;i+=16) {
+		__m128i s = _mm_setzero_si128(), m[8], bit[8], acc;
+		uint8_t tmp[16];
+		uint_fast8_t b, l;
+		for(b=0;b<8;b++) {
+			for(l=0;l<16;l++)
+				tmp[l] = gf_exp[i + l + b];
+			m[b] = _mm_loadu_si128((const __m128i *)tmp);
+			bit[b] = _mm_set1_epi8(1 << b);
+		}
+		for(j=0;j<len;j++) {
+			acc = _mm_set1_epi8(buf[j]);
+			for(b=0;b<8;b++)
+				acc = _mm_xor_si128(acc, _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(s, bit[b]), bit[b]), m[b]));
+			s = acc;
+		}
+		_mm_storeu_si128((__m128i *)(synd + i), s);
+	}
+#endif
+	for(;i<nsym;i++) {
+		uint_fast8_t s=0;
+		for(j=0;j<len;j++)
+			s = (s ? gf_exp[gf_log[s] + i] : 0) ^ buf[j];
+		synd[i] = s;
+	}
+	for(i=0;i<nsym;i++)
+		any |= synd[i];
+	return(any != 0);
+}
+
+
+//! correct a block
+
+//! Berlekamp-Massey, initialised with the erasure locator, Chien search and Forney
+//! @param rs codec
+//! @param buf block (data and parity), corrected in place
+//! @param len length of buf (nsym + 1 to RS_BLOCK_LEN)
+//! @param erasures positions of known bad bytes in buf, can be NULL
+//! @param erasure_amount amount of erasures
+//! @return amount of corrected bytes, or -1 if the block can not be corrected
+int rs_decode_block(const rs_t *rs, uint8_t *buf, int len, const int *erasures, int erasure_amount)
+{
+	uint8_t synd[RS_MAX_NSYM], lambda[RS_MAX_NSYM+2], b[RS_MAX_NSYM+2], t[RS_MAX_NSYM+2], omega[RS_MAX_NSYM];
+	int nsym = rs->nsym, e = erasure_amount, l, r, i, j, pos[RS_MAX_NSYM], roots=0;
+
+	if(len <= nsym || len > RS_BLOCK_LEN || e > nsym)
+		return(-1);
+	if(!rs_syndromes(nsym, buf, len, synd))
+		return(0);
+
+	//erasure locator, prod(1 + X x)
+	memset(lambda, 0, sizeof(lambda));
+	lambda[0] = 1;
+	for(i=0;i<e;i++) {
+		uint_fast8_t x;
+		if(erasures[i] < 0 || erasures[i] >= len)
+			return(-1);
+		x = gf_exp[len - 1 - erasures[i]];
+		for(j=i+1;j>0;j--)
+			lambda[j] ^= gf_mul(lambda[j-1], x);
+	}
+	memcpy(b, lambda, sizeof(b));
+
+	//berlekamp-massey
+	l = e;
+	for(r=e+1;r<=nsym;r++) {
+		uint_fast8_t delta=0;
+		for(j=0;j<=l && j<r;j++)
+			delta ^= gf_mul(lambda[j], synd[r-1-j]);
+		if(!delta) {
+			memmove(b + 1, b, nsym + 1);
+			b[0] = 0;
+			continue;
+		}
+		memcpy(t, lambda, sizeof(t));
+		for(j=1;j<=nsym+1;j++)
+			lambda[j] ^= gf_mul(delta, b[j-1]);
+		if(2 * l <= r - 1 + e) {
+			for(j=0;j<=nsym+1;j++)
+				b[j] = gf_div(t[j], delta);
+			l = r + e - l;
+		} else {
+			memmove(b + 1, b, nsym + 1);
+			b[0] = 0;
+		}
+	}
+	if(2 * l - e > nsym)
+		return(-1);
+
+	//chien search, lambda(X^-1) = 0
+	for(i=0;i<len;i++) {
+		if(!gf_poly_eval(lambda, l, 255 - (len - 1 - i))) {
+			if(roots == l)
+				return(-1);
+			pos[roots++] = i;
+		}
+	}
+	if(roots != l)
+		return(-1);
+
+	//forney, magnitude = X omega(X^-1) / lambda'(X^-1)
+	for(i=0;i<nsym;i++) {
+		omega[i] = 0;
+		for(j=0;j<=i && j<=l;j++)
+			omega[i] ^= gf_mul(lambda[j], synd[i-j]);
+	}
+	for(i=0;i<l;i++) {
+		int n = 255 - (len - 1 - pos[i]);
+		uint_fast8_t num = gf_poly_eval(omega, nsym - 1, n), den=0;
+		for(j=1;j<=l;j+=2)
+			den ^= gf_mul(lambda[j], gf_pow_alpha(n * (j - 1)));
+		if(!den)
+			return(-1);
+		buf[pos[i]] ^= gf_mul(gf_div(num, den), gf_exp[len - 1 - pos[i]]);
+	}
+	return(l);
+}
+
+
+//! add parity bytes to a frame
+
+//! the frame is cut into blocks of up to RS_BLOCK_LEN - nsym data bytes,
+//! the buffer is encoded in place, therefore it needs to be rs_encoded_len()
+//! @param rs codec
+//! @param buf input/output data
+//! @param len length of input data
+//! @return length of output data
+int rs_encode_buf(const rs_t *rs, uint8_t *buf, int len)
+{
+	int k = RS_BLOCK_LEN - rs->nsym, blocks = (len + k - 1) / k, i;
+	for(i=blocks-1;i>=0;i--) { //last block first, blocks move up
+		int n = min(k, len - i * k);
+		uint8_t *block = buf + i * RS_BLOCK_LEN;
+		memmove(block, buf + i * k, n);
+		rs_encode_block(rs, block, n, block + n);
+	}
+	return(len + blocks * rs->nsym);
+}
+
+
+//! correct a frame and remove the parity bytes
+
+//! the buffer is decoded in place
+//! @param rs codec
+//! @param buf input/output data
+//! @param len length of input data
+//! @param erasures positions of known bad bytes in buf (ascending), can be NULL
+//! @param erasure_amount amount of erasures
+//! @return length of output data, or -1 if a block can not be corrected
+int rs_decode_buf(const rs_t *rs, uint8_t *buf, int len, const int *erasures, int erasure_amount)
+{
+	int out_len = rs_decoded_len(rs->nsym, len), i, e=0, block_e[RS_MAX_NSYM];
+	if(out_len < 0)
+		return(-1);
+	for(i=0;i*RS_BLOCK_LEN<len;i++) {
+		int start = i * RS_BLOCK_LEN, n = min(RS_BLOCK_LEN, len - start), amount=0;
+		for(;e<erasure_amount && erasures[e] < start + n;e++) {
+			if(amount == rs->nsym)
+				return(-1);
+			block_e[amount++] = erasures[e] - start;
+		}
+		if(rs_decode_block(rs, buf + start, n, block_e, amount) < 0)
+			return(-1);
+		memmove(buf + i * (RS_BLOCK_LEN - rs->nsym), buf + start, n - rs->nsym);
+	}
+	return(out_len);
+}
+#endif //CONFIG_REED_SOLOMON
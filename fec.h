@@ -0,0 +1,60 @@
+//! Forward error correction, Hamming(8,4) and Reed-Solomon
+
+//! @file fec.h
+//!
+//! Hamming(8,4) is the extended Hamming(7,4) code, one nibble per code byte
+//! (data in bits 0-3, parity in bits 4-6, overall parity in bit 7). It corrects
+//! a single and detects a double bit error per code byte. The decoder is a 256
+//! entry lookup table (CONFIG_HAMMING_LOOKUP) generated by fec_lookup_create.
+//!
+//! Reed-Solomon works on GF(256) with the polynomial 0x11D and first
+//! consecutive root alpha^0, the same code as the common software decoders.
+//! A frame is cut into blocks of up to 255 bytes, each with nsym parity bytes
+//! after its data, so it corrects up to nsym / 2 errors per block, or nsym
+//! erasures (known bad positions), or any mix where 2 * errors + erasures <= nsym.
+//! Syndromes are calculated 16 at a time with SSE2 when available.
+//! The log/antilog tables are generated by fec_lookup_create.
+
+#ifndef FEC_H
+#define FEC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "helper.h"
+
+#define HAMMING_CORRECTED     BIT(4) //!< decode table entry: single bit error corrected
+#define HAMMING_UNCORRECTABLE BIT(5) //!< decode table entry: double bit error
+
+#define RS_POLY 0x11D
+#define RS_MAX_NSYM 64    //!< maximum parity bytes per block
+#define RS_BLOCK_LEN 255  //!< maximum block length (data + parity)
+
+//hamming
+#ifdef CONFIG_HAMMING
+uint_fast8_t hamming_encode_nibble(uint_fast8_t nibble);
+uint_fast8_t hamming_decode_byte(uint_fast8_t in);
+void hamming_encode_buf(uint8_t *buf, int len);
+int hamming_decode_buf(uint8_t *buf, int len, int *corrected);
+#endif
+
+//reed-solomon
+#ifdef CONFIG_REED_SOLOMON
+typedef struct {
+	uint_fast8_t nsym;               //!< parity bytes per block
+	uint8_t gen[RS_MAX_NSYM + 1];    //!< generator polynomial, gen[i] is the coefficient of x^i
+} rs_t;
+
+uint_fast8_t gf_mul(uint_fast8_t a, uint_fast8_t b);
+uint_fast8_t gf_div(uint_fast8_t a, uint_fast8_t b);
+int rs_init(rs_t *rs, uint_fast8_t nsym);
+int rs_encoded_len(uint_fast8_t nsym, int len);
+int rs_decoded_len(uint_fast8_t nsym, int len);
+void rs_encode_block(const rs_t *rs, const uint8_t *msg, int len, uint8_t *parity);
+bool rs_syndromes(uint_fast8_t nsym, const uint8_t *buf, int len, uint8_t *synd);
+int rs_decode_block(const rs_t *rs, uint8_t *buf, int len, const int *erasures, int erasure_amount);
+int rs_encode_buf(const rs_t *rs, uint8_t *buf, int len);
+int rs_decode_buf(const rs_t *rs, uint8_t *buf, int len, const int *erasures, int erasure_amount);
+#endif
+
+#endif
@@ -0,0 +1,12 @@
+#include <stdint.h>
+#include "config.h"
+
+#ifdef CONFIG_HAMMING_LOOKUP
+extern const uint8_t hamming_enc_lookup[16];
+extern const uint8_t hamming_dec_lookup[256];
+#endif
+
+#ifdef CONFIG_REED_SOLOMON
+extern const uint8_t gf_exp[512];
+extern const uint8_t gf_log[256];
+#endif
@@ -0,0 +1,50 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fec.h"
+#if defined(CONFIG_HAMMING_LOOKUP)
+#error need SW routines to generate lookup table
+#endif
+
+int main(void)
+{
+	int i, x;
+	uint8_t gf_log[256] = {0};
+	FILE *fh, *fc;
+	fh = fopen("fec_lookup.h", "w");
+	fc = fopen("fec_lookup.c", "w");
+	fprintf(fh, "#include <stdint.h>\n#include \"config.h\"\n\n");
+	fprintf(fc, "#include \"fec_lookup.h\"\n\n");
+
+	fprintf(fh, "#ifdef CONFIG_HAMMING_LOOKUP\nextern const uint8_t hamming_enc_lookup[16];\nextern const uint8_t hamming_dec_lookup[256];\n#endif\n\n");
+	fprintf(fc, "#ifdef CONFIG_HAMMING_LOOKUP\nconst uint8_t hamming_enc_lookup[16] = {\n");
+	for(i=0;i<16;i++) {
+		fprintf(fc, "0x%02X,\n", (unsigned int)hamming_encode_nibble(i));
+	}
+	fprintf(fc, "};\n\nconst uint8_t hamming_dec_lookup[256] = {\n");
+	for(i=0;i<256;i++) {
+		fprintf(fc, "0x%02X,\n", (unsigned int)hamming_decode_byte(i));
+	}
+	fprintf(fc, "};\n#endif\n\n");
+
+	//alpha = 2, the table is doubled so the sum of two logs needs no modulo
+	fprintf(fh, "#ifdef CONFIG_REED_SOLOMON\nextern const uint8_t gf_exp[512];\nextern const uint8_t gf_log[256];\n#endif\n");
+	fprintf(fc, "#ifdef CONFIG_REED_SOLOMON\nconst uint8_t gf_exp[512] = {\n");
+	for(i=0,x=1;i<512;i++) {
+		fprintf(fc, "0x%02X,\n", x);
+		if(i < 255)
+			gf_log[x] = i;
+		x <<= 1;
+		if(x & 0x100)
+			x ^= RS_POLY;
+	}
+	fprintf(fc, "};\n\nconst uint8_t gf_log[256] = {\n");
+	for(i=0;i<256;i++) {
+		fprintf(fc, "0x%02X,\n", gf_log[i]);
+	}
+	fprintf(fc, "};\n#endif\n");
+
+	fclose(fh);
+	fclose(fc);
+	return(0);
+}
@@ -0,0 +1,197 @@
+//! FIR filter and decimator
+
+//! @file fir.c
+
+
+#include <string.h>
+#include <math.h>
+#include "config.h"
+#if defined(CONFIG_FIR) && defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(CONFIG_FIR) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "fir.h"
+
+
+#ifdef CONFIG_FIR
+//! design low pass taps (Blackman windowed sinc)
+
+//! @param taps output
+//! @param num_taps amount of taps (1 - FIR_MAX_TAPS), odd for a symmetric filter with an integer delay
+//! @param cutoff -6 dB frequency in Hz
+//! @param sample_rate samples per second
+//! @return 0 on success, -1 on invalid parameters
+int fir_lowpass(float *taps, uint_fast16_t num_taps, double cutoff, double sample_rate)
+{
+	double fc = cutoff / sample_rate, m = num_taps - 1, x, sum = 0, h[FIR_MAX_TAPS];
+	uint_fast16_t i;
+	if(!num_taps || num_taps > FIR_MAX_TAPS || fc <= 0 || fc >= 0.5)
+		return(-1);
+	for(i=0;i<num_taps;i++) {
+		x = i - m / 2;
+		h[i] = x ? sin(2 * M_PI * fc * x) / (M_PI * x) : 2 * fc;
+		if(num_taps > 1)
+			h[i] *= 0.42 - 0.5 * cos(2 * M_PI * i / m) + 0.08 * cos(4 * M_PI * i / m);
+		sum += h[i];
+	}
+	//unity gain at DC
+	for(i=0;i<num_taps;i++)
+		taps[i] = h[i] / sum;
+	return(0);
+}
+
+
+//! prepare a filter
+
+//! @param f filter, use one per stream (float or int16)
+//! @param taps taps, first tap for the newest sample
+//! @param num_taps amount of taps (1 - FIR_MAX_TAPS)
+//! @param decimation output every decimation-th sample (1 - FIR_BLOCK)
+//! @return 0 on success, -1 on invalid parameters
+int fir_init(fir_t *f, const float *taps, uint_fast16_t num_taps, uint_fast16_t decimation)
+{
+	uint_fast16_t i, len = (num_taps + FIR_ALIGN - 1) & ~(FIR_ALIGN - 1);
+	float t;
+	long q;
+	if(!num_taps || len > FIR_MAX_TAPS || !decimation || decimation > FIR_BLOCK)
+		return(-1);
+	f->num_taps = len;
+	f->decimation = decimation;
+	for(i=0;i<len;i++) {
+		t = (len - 1 - i < num_taps) ? taps[len - 1 - i] : 0;
+		f->taps[i] = t;
+		q = lrintf(t * 32768.0f);
+		f->taps16[i] = (q > 32767) ? 32767 : ((q < -32768) ? -32768 : q);
+	}
+	fir_reset(f);
+	return(0);
+}
+
+
+//! clear the history of a filter
+void fir_reset(fir_t *f)
+{
+	memset(f->hist, 0, sizeof(f->hist));
+	memset(f->hist16, 0, sizeof(f->hist16));
+	f->skip = 0;
+}
+
+
+//! dot product of float vectors, len is a multiple of FIR_ALIGN
+static float fir_dot(const float *a, const float *b, uint_fast16_t len)
+{
+	uint_fast16_t i;
+#if defined(__AVX2__)
+	__m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+	__m128 s;
+	for(i=0;i<len;i+=16) {
+#ifdef __FMA__
+		acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+		acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+#else
+		acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+		acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+#endif
+	}
+	acc0 = _mm256_add_ps(acc0, acc1);
+	s = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+	s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+	return(_mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1))));
+#elif defined(__SSE2__)
+	__m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+	for(i=0;i<len;i+=8) {
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+		acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+	}
+	acc0 = _mm_add_ps(acc0, acc1);
+	acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+	return(_mm_cvtss_f32(_mm_add_ss(acc0, _mm_shuffle_ps(acc0, acc0, 1))));
+#else
+	float sum = 0;
+	for(i=0;i<len;i++)
+		sum += a[i] * b[i];
+	return(sum);
+#endif
+}
+
+
+//! dot product of int16 vectors, len is a multiple of FIR_ALIGN
+static int32_t fir_dot16(const int16_t *a, const int16_t *b, uint_fast16_t len)
+{
+	uint_fast16_t i;
+#if defined(__AVX2__)
+	__m256i acc = _mm256_setzero_si256();
+	__m128i s;
+	for(i=0;i<len;i+=16)
+		acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(a + i)), _mm256_loadu_si256((const __m256i *)(b + i))));
+	s = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+#elif defined(__SSE2__)
+	__m128i s = _mm_setzero_si128();
+	for(i=0;i<len;i+=8)
+		s = _mm_add_epi32(s, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i))));
+#else
+	int32_t sum = 0;
+	for(i=0;i<len;i++)
+		sum += (int32_t)a[i] * b[i];
+	return(sum);
+#endif
+#if defined(__AVX2__) || defined(__SSE2__)
+	s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4e));
+	s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xb1));
+	return(_mm_cvtsi128_si32(s));
+#endif
+}
+
+
+//! filter and decimate float samples
+
+//! @param f filter, the history is updated
+//! @param dest output, up to FIR_OUT_MAX(len, decimation) samples
+//! @param src input
+//! @param len amount of input samples
+//! @return amount of output samples
+long fir_float(fir_t *f, float *dest, const float *src, long len)
+{
+	uint_fast16_t old = f->num_taps - 1;
+	long done = 0, out = 0, n, i;
+	while(done < len) {
+		n = (len - done < FIR_BLOCK) ? len - done : FIR_BLOCK;
+		memcpy(f->hist + old, src + done, n * sizeof(float));
+		//the window of input sample i starts at hist + i
+		for(i=f->skip;i<n;i+=f->decimation)
+			dest[out++] = fir_dot(f->taps, f->hist + i, f->num_taps);
+		f->skip = i - n;
+		memmove(f->hist, f->hist + n, old * sizeof(float));
+		done += n;
+	}
+	return(out);
+}
+
+
+//! filter and decimate int16 samples
+
+//! @param f filter, the history is updated
+//! @param dest output, up to FIR_OUT_MAX(len, decimation) samples
+//! @param src input
+//! @param len amount of input samples
+//! @return amount of output samples
+long fir_int16(fir_t *f, int16_t *dest, const int16_t *src, long len)
+{
+	uint_fast16_t old = f->num_taps - 1;
+	long done = 0, out = 0, n, i;
+	int32_t y;
+	while(done < len) {
+		n = (len - done < FIR_BLOCK) ? len - done : FIR_BLOCK;
+		memcpy(f->hist16 + old, src + done, n * sizeof(int16_t));
+		for(i=f->skip;i<n;i+=f->decimation) {
+			y = (fir_dot16(f->taps16, f->hist16 + i, f->num_taps) + (1 << 14)) >> 15;
+			dest[out++] = (y > 32767) ? 32767 : ((y < -32768) ? -32768 : y);
+		}
+		f->skip = i - n;
+		memmove(f->hist16, f->hist16 + n, old * sizeof(int16_t));
+		done += n;
+	}
+	return(out);
+}
+#endif //CONFIG_FIR
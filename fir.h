@@ -0,0 +1,49 @@
+//! FIR filter and decimator
+
+//! @file fir.h
+//!
+//! Low pass filtering and decimation of int16 and float samples in front of
+//! a sample domain decoder. Only every decimation-th output is computed, which
+//! costs the same as a polyphase decimator. Samples are processed in blocks
+//! of any length, the filter keeps its history between calls, so a stream can
+//! be fed in pieces of any size and gives the same output as in one piece.
+//!
+//! The taps are stored reversed and zero padded to FIR_ALIGN, so an output is
+//! one dot product over contiguous history. The dot product uses AVX2 (and
+//! FMA) when the compiler targets it (e.g. -march=native), else SSE2.
+//! int16 samples use Q15 taps with a 32 bit accumulator, so the sum of the
+//! absolute taps must stay below 2.
+//!
+//! fir_lowpass() designs the taps as a Blackman windowed sinc.
+
+#ifndef FIR_H
+#define FIR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+#define FIR_MAX_TAPS 256  //!< maximum taps, after padding
+#define FIR_ALIGN 16      //!< taps are padded to a multiple of this
+#define FIR_BLOCK 1024    //!< input samples per pass over the history buffer
+#define FIR_OUT_MAX(len, decimation) (((len) + (decimation) - 1) / (decimation)) //!< maximum outputs of len input samples
+
+typedef struct {
+	uint_fast16_t num_taps;                   //!< padded to FIR_ALIGN
+	uint_fast16_t decimation;
+	uint_fast16_t skip;                       //!< input samples up to the next output
+	float taps[FIR_MAX_TAPS];                 //!< reversed, the last tap is for the newest sample
+	int16_t taps16[FIR_MAX_TAPS];             //!< reversed Q15
+	float hist[FIR_MAX_TAPS + FIR_BLOCK];     //!< num_taps - 1 old samples followed by the block
+	int16_t hist16[FIR_MAX_TAPS + FIR_BLOCK];
+} fir_t;
+
+#ifdef CONFIG_FIR
+int fir_lowpass(float *taps, uint_fast16_t num_taps, double cutoff, double sample_rate);
+int fir_init(fir_t *f, const float *taps, uint_fast16_t num_taps, uint_fast16_t decimation);
+void fir_reset(fir_t *f);
+long fir_float(fir_t *f, float *dest, const float *src, long len);
+long fir_int16(fir_t *f, int16_t *dest, const int16_t *src, long len);
+#endif
+
+#endif
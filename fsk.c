@@ -0,0 +1,233 @@
+//! OOK, 2-FSK and GFSK modulator
+
+//! @file fsk.c
+
+
+#include <string.h>
+#include <math.h>
+#include "config.h"
+#include "fsk.h"
+#include "helper.h"
+
+
+#ifdef CONFIG_FSK
+//! prepare a modulator
+
+//! @param f modulator
+//! @param mode modulation
+//! @param samples_per_bit samples per bit (1 - FSK_MAX_SPB)
+//! @param bt bandwidth time product of the gaussian filter (typ. 0.5), 0 = no shaping (not for GFSK)
+//! @param deviation frequency deviation in Hz (FSK, GFSK)
+//! @param carrier carrier frequency in Hz, 0 for baseband
+//! @param sample_rate samples per second
+//! @param amplitude peak value, full scale is 1.0
+//! @return 0 on success, -1 on invalid parameters
+int fsk_init(fsk_t *f, fsk_mode_t mode, uint_fast16_t samples_per_bit, double bt, double deviation, double carrier, double sample_rate, float amplitude)
+{
+	double k = M_PI * bt * sqrt(2 / log(2)); //erf() scale of the gaussian filter
+	double dev = deviation / sample_rate * 4294967296.0;
+	double g[3], t, e;
+	uint_fast16_t j;
+	uint_fast8_t p;
+	if(!samples_per_bit || samples_per_bit > FSK_MAX_SPB || sample_rate <= 0 || bt < 0 || (mode == FSK_GFSK && bt == 0) || fabs(deviation) >= sample_rate / 2)
+		return(-1);
+	f->mode = mode;
+	f->samples_per_bit = samples_per_bit;
+	f->amplitude = amplitude;
+	nco_init(&f->nco, carrier, sample_rate);
+	for(j=0;j<samples_per_bit;j++) {
+		t = (j + 0.5) / samples_per_bit - 0.5; //in bits from the middle of the bit
+		if(mode == FSK_2FSK || bt == 0) {
+			g[0] = 0;
+			g[1] = 1;
+			g[2] = 0;
+		} else {
+			//rectangular pulse through the gaussian filter, of the previous, current and next bit
+			g[0] = erf(k * (t + 1.5)) - erf(k * (t + 0.5));
+			g[1] = erf(k * (t + 0.5)) - erf(k * (t - 0.5));
+			g[2] = erf(k * (t - 0.5)) - erf(k * (t - 1.5));
+		}
+		for(p=0;p<8;p++) {
+			//normalized, so a run of equal bits is exactly at full deviation
+			e = ((p & 1) * g[0] + ((p >> 1) & 1) * g[1] + ((p >> 2) & 1) * g[2]) / (g[0] + g[1] + g[2]);
+			f->env[p][j] = e;
+			f->inc[p][j] = f->nco.inc;
+			if(mode != FSK_OOK)
+				f->inc[p][j] += (uint32_t)(int32_t)llround(dev * (2 * e - 1));
+		}
+	}
+	return(0);
+}
+
+
+//! amount of samples of a payload
+
+//! @param f modulator
+//! @param len payload length
+long fsk_samples(const fsk_t *f, int len)
+{
+	return((long)len * 8 * f->samples_per_bit);
+}
+
+
+//! render the next bits of a payload
+
+//! renders whole bits, up to FSK_BLOCK samples
+//! @param f modulator, the phase is advanced
+//! @param buf payload
+//! @param bits bits in buf
+//! @param bit next bit, advanced
+//! @param i_buf cosine output, NULL if not needed
+//! @param q_buf sine output
+//! @return amount of samples
+static int fsk_render(fsk_t *f, const uint8_t *buf, long bits, long *bit, float *i_buf, float *q_buf)
+{
+	uint32_t phase[FSK_BLOCK], ph = f->nco.phase;
+	float env[FSK_BLOCK];
+	uint_fast16_t spb = f->samples_per_bit, j;
+	uint_fast8_t p;
+	bool ook = f->mode == FSK_OOK;
+	int n=0, k;
+	for(;*bit<bits && n+(int)spb<=FSK_BLOCK;(*bit)++) {
+		long i = *bit;
+		p = READ_BIT(buf[i>>3], i & 7) << 1;
+		if(i > 0)
+			p |= READ_BIT(buf[(i-1)>>3], (i-1) & 7);
+		if(i + 1 < bits)
+			p |= READ_BIT(buf[(i+1)>>3], (i+1) & 7) << 2;
+		for(j=0;j<spb;j++) {
+			phase[n+j] = ph;
+			ph += f->inc[p][j];
+		}
+		if(ook)
+			memcpy(env + n, f->env[p], spb * sizeof(float));
+		n += spb;
+	}
+	f->nco.phase = ph;
+	nco_sin_buf(q_buf, phase, n, f->amplitude);
+	if(i_buf) {
+		for(k=0;k<n;k++)
+			phase[k] += NCO_QUARTER;
+		nco_sin_buf(i_buf, phase, n, f->amplitude);
+	}
+	if(ook) {
+		for(k=0;k<n;k++)
+			q_buf[k] *= env[k];
+		if(i_buf)
+			for(k=0;k<n;k++)
+				i_buf[k] *= env[k];
+	}
+	return(n);
+}
+
+
+//! store a rendered block
+
+//! @param dest output, I and Q interleaved if i_buf is given
+//! @param i_buf cosine, NULL for real samples
+//! @param q_buf sine
+//! @param n amount of samples
+//! @param int16 int16 output, else float
+static void fsk_store(void *dest, const float *i_buf, const float *q_buf, int n, bool int16)
+{
+	int16_t *d16 = dest;
+	float *df = dest;
+	int k;
+	if(!i_buf && !int16)
+		memcpy(df, q_buf, n * sizeof(float));
+	else if(!i_buf)
+		for(k=0;k<n;k++)
+			d16[k] = (int16_t)lrintf(q_buf[k] * 32767.0f);
+	else if(!int16)
+		for(k=0;k<n;k++) {
+			df[2*k] = i_buf[k];
+			df[2*k+1] = q_buf[k];
+		}
+	else
+		for(k=0;k<n;k++) {
+			d16[2*k] = (int16_t)lrintf(i_buf[k] * 32767.0f);
+			d16[2*k+1] = (int16_t)lrintf(q_buf[k] * 32767.0f);
+		}
+}
+
+
+//! modulate a payload
+
+//! @param f modulator
+//! @param dest output, NULL if w is given
+//! @param w writer the samples are appended to, or NULL
+//! @param buf payload
+//! @param len length of buf
+//! @param iq complex baseband (I and Q interleaved), else real samples
+//! @param int16 int16 samples, else float
+//! @return amount of samples, -1 on write error
+static long fsk_run(fsk_t *f, void *dest, wav_writer_t *w, const uint8_t *buf, int len, bool iq, bool int16)
+{
+	float i_buf[FSK_BLOCK], q_buf[FSK_BLOCK], block[FSK_BLOCK * 2];
+	size_t size = (iq ? 2 : 1) * (int16 ? sizeof(int16_t) : sizeof(float));
+	long bit = 0, bits = (long)len * 8, done = 0;
+	int n;
+	while(bit < bits) {
+		n = fsk_render(f, buf, bits, &bit, iq ? i_buf : NULL, q_buf);
+		fsk_store(w ? (void *)block : (uint8_t *)dest + done * size, iq ? i_buf : NULL, q_buf, n, int16);
+		if(w && wav_append(w, block, n))
+			return(-1);
+		done += n;
+	}
+	return(done);
+}
+
+
+//! modulate a payload to float samples on the carrier
+
+//! @param f modulator, the phase is advanced
+//! @param dest output (fsk_samples() samples)
+//! @param buf payload
+//! @param len length of buf
+//! @return amount of samples
+long fsk_modulate_float(fsk_t *f, float *dest, const uint8_t *buf, int len)
+{
+	return(fsk_run(f, dest, NULL, buf, len, false, false));
+}
+
+
+//! modulate a payload to int16 samples on the carrier
+
+//! @param f modulator, the phase is advanced
+//! @param dest output (fsk_samples() samples)
+//! @param buf payload
+//! @param len length of buf
+//! @return amount of samples
+long fsk_modulate_int16(fsk_t *f, int16_t *dest, const uint8_t *buf, int len)
+{
+	return(fsk_run(f, dest, NULL, buf, len, false, true));
+}
+
+
+//! modulate a payload to complex samples
+
+//! @param f modulator, the phase is advanced
+//! @param dest output, I and Q interleaved (2 * fsk_samples() floats)
+//! @param buf payload
+//! @param len length of buf
+//! @return amount of complex samples
+long fsk_modulate_iq(fsk_t *f, float *dest, const uint8_t *buf, int len)
+{
+	return(fsk_run(f, dest, NULL, buf, len, true, false));
+}
+
+
+//! modulate a payload and append it to a WAV file
+
+//! @param f modulator, the phase is advanced
+//! @param w WAV_INT16 or WAV_FLOAT32 writer, mono for real samples, stereo for I and Q
+//! @param buf payload
+//! @param len length of buf
+//! @return 0 on success, -1 on error
+int fsk_modulate_wav(fsk_t *f, wav_writer_t *w, const uint8_t *buf, int len)
+{
+	if(w->num_channels < 1 || w->num_channels > 2 || (w->format != WAV_INT16 && w->format != WAV_FLOAT32))
+		return(-1);
+	return(fsk_run(f, NULL, w, buf, len, w->num_channels == 2, w->format == WAV_INT16) < 0 ? -1 : 0);
+}
+#endif //CONFIG_FSK
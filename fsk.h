@@ -0,0 +1,53 @@
+//! OOK, 2-FSK and GFSK modulator
+
+//! @file fsk.h
+//!
+//! Turns bytecoder output (bits LSB first) into audio samples on a carrier or
+//! into complex baseband (carrier 0, interleaved I and Q), for load tests of a
+//! receive chain with long signals.
+//!
+//! A bit is shaped by the gaussian filtered pulse of its neighbours, so the
+//! shape of a bit only depends on the previous, current and next bit.
+//! fsk_init() renders these 8 patterns once: the phase increment per sample
+//! for (G)FSK and the envelope for OOK. Modulation then only adds up the
+//! increments of the table and takes the sine from the NCO table, a block of
+//! FSK_BLOCK samples at a time. The phase is continuous over all calls, the
+//! bits before and after a payload are taken as 0.
+
+#ifndef FSK_H
+#define FSK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "nco.h"
+#include "make_wav.h"
+
+#define FSK_MAX_SPB 128   //!< maximum samples per bit
+#define FSK_BLOCK 1024    //!< samples rendered at a time, at least FSK_MAX_SPB
+
+typedef enum {
+	FSK_OOK,   //!< carrier on for 1, off for 0, gaussian shaped envelope if bt > 0
+	FSK_2FSK,  //!< carrier + deviation for 1, carrier - deviation for 0, hard switched
+	FSK_GFSK   //!< 2-FSK with the frequency shaped by a gaussian filter
+} fsk_mode_t;
+
+typedef struct {
+	fsk_mode_t mode;
+	uint_fast16_t samples_per_bit;
+	float amplitude;                    //!< peak value, full scale is 1.0
+	nco_t nco;                          //!< phase of the next sample and carrier increment
+	uint32_t inc[8][FSK_MAX_SPB];       //!< phase increment, index is next bit * 4 + bit * 2 + previous bit
+	float env[8][FSK_MAX_SPB];          //!< OOK envelope 0.0 - 1.0
+} fsk_t;
+
+#ifdef CONFIG_FSK
+int fsk_init(fsk_t *f, fsk_mode_t mode, uint_fast16_t samples_per_bit, double bt, double deviation, double carrier, double sample_rate, float amplitude);
+long fsk_samples(const fsk_t *f, int len);
+long fsk_modulate_float(fsk_t *f, float *dest, const uint8_t *buf, int len);
+long fsk_modulate_int16(fsk_t *f, int16_t *dest, const uint8_t *buf, int len);
+long fsk_modulate_iq(fsk_t *f, float *dest, const uint8_t *buf, int len);
+int fsk_modulate_wav(fsk_t *f, wav_writer_t *w, const uint8_t *buf, int len);
+#endif
+
+#endif
@@ -1,6 +1,58 @@
 #include "helper.h"
 #include <stdio.h>
 
+//! amount of set bits (population count)
+uint_fast8_t count_set_bits(uint_fast32_t v)
+{
+#ifdef __GNUC__
+	return(__builtin_popcountl(v));
+#else
+	uint_fast8_t out=0;
+	for(;v;v&=v-1)
+		out++;
+	return(out);
+#endif
+}
+
+
+//! running XOR, bit n of the output is the XOR of bits 0 to n of the input
+uint64_t prefix_xor(uint64_t x)
+{
+	x ^= x << 1;
+	x ^= x << 2;
+	x ^= x << 4;
+	x ^= x << 8;
+	x ^= x << 16;
+	x ^= x << 32;
+	return(x);
+}
+
+
+//! put the 32 input bits on the even bits of the output
+uint64_t spread_bits(uint64_t x)
+{
+	x &= 0x00000000FFFFFFFFull;
+	x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+	x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+	x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+	x = (x | (x << 2)) & 0x3333333333333333ull;
+	x = (x | (x << 1)) & 0x5555555555555555ull;
+	return(x);
+}
+
+
+//! collect the even bits of the input
+uint32_t compress_bits(uint64_t x)
+{
+	x &= 0x5555555555555555ull;
+	x = (x | (x >> 1)) & 0x3333333333333333ull;
+	x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+	x = (x | (x >> 4)) & 0x00FF00FF00FF00FFull;
+	x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+	x = (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+	return(x);
+}
+
 char *int_to_binary_string(int num, uint_fast8_t len)
 {
 	static char str[33];
@@ -68,6 +68,10 @@
 #endif
 
 
+uint_fast8_t count_set_bits(uint_fast32_t v);
+uint64_t prefix_xor(uint64_t x);
+uint64_t spread_bits(uint64_t x);
+uint32_t compress_bits(uint64_t x);
 char *int_to_binary_string(int num, uint_fast8_t len);
 char *int_to_binary_string_l2r(int num, uint_fast8_t len);
 char *int_to_binary_level_string_l2r(int num, uint_fast8_t len);
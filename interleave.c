@@ -0,0 +1,221 @@
+//! Bit interleaver, block and convolutional
+
+//! @file interleave.c
+
+
+#include <string.h>
+#include "interleave.h"
+#include "helper.h"
+
+
+#ifdef CONFIG_INTERLEAVE
+#define INTERLEAVE_BYTE_LANES 0x0101010101010101ULL //!< bit 0 of every byte
+
+
+//! load 8 bytes, first byte in the LSB
+static uint64_t interleave_load(const uint8_t *buf)
+{
+	uint64_t out=0;
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	memcpy(&out, buf, 8);
+#else
+	uint_fast8_t i;
+	for(i=0;i<8;i++)
+		out |= (uint64_t)buf[i] << (i << 3);
+#endif
+	return(out);
+}
+
+
+//! store 8 bytes, first byte from the LSB
+static void interleave_store(uint8_t *buf, uint64_t w)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	memcpy(buf, &w, 8);
+#else
+	uint_fast8_t i;
+	for(i=0;i<8;i++)
+		buf[i] = READ_BYTE(w, i);
+#endif
+}
+
+
+//! transpose an 8x8 bit matrix, bit k of byte i goes to bit i of byte k
+static uint64_t interleave_transpose8(uint64_t x)
+{
+	uint64_t t;
+	t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+	x ^= t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+	x ^= t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+	x ^= t ^ (t << 28);
+	return(x);
+}
+
+
+//! transpose one 8x8 bit tile
+
+//! @param dest first byte of the tile in the destination
+//! @param src first byte of the tile in the source
+//! @param dest_stride bytes per row of the destination
+//! @param src_stride bytes per row of the source
+static void interleave_tile(uint8_t *dest, const uint8_t *src, int dest_stride, int src_stride)
+{
+	uint64_t x=0;
+	uint_fast8_t i;
+	for(i=0;i<8;i++)
+		x |= (uint64_t)src[i*src_stride] << (i << 3);
+	x = interleave_transpose8(x);
+	for(i=0;i<8;i++)
+		dest[i*dest_stride] = READ_BYTE(x, i);
+}
+
+
+//! transpose a bit matrix
+
+//! src has rows rows of cols bits, dest gets cols rows of rows bits,
+//! so bit r * cols + c goes to bit c * rows + r
+//! @param dest destination (rows * cols / 8 bytes), not the same as src
+//! @param src source
+//! @param rows rows of src, multiple of 8
+//! @param cols columns of src, multiple of 8
+void interleave_transpose(uint8_t *dest, const uint8_t *src, int rows, int cols)
+{
+	int row_tiles = rows >> 3, col_tiles = cols >> 3;
+	int a, b, ta, tb;
+	//groups of tiles, so the source and destination rows of a group stay in the cache
+	for(tb=0;tb<col_tiles;tb+=INTERLEAVE_TILE) {
+		for(ta=0;ta<row_tiles;ta+=INTERLEAVE_TILE) {
+			for(b=tb;b<min(tb + INTERLEAVE_TILE, col_tiles);b++) {
+				for(a=ta;a<min(ta + INTERLEAVE_TILE, row_tiles);a++)
+					interleave_tile(dest + ((b * row_tiles) << 3) + a, src + ((a * col_tiles) << 3) + b, row_tiles, col_tiles);
+			}
+		}
+	}
+}
+
+
+//! transpose a bit matrix bit by bit, for column counts which are not a multiple of 8
+
+//! @see interleave_transpose()
+static void interleave_transpose_bits(uint8_t *dest, const uint8_t *src, int rows, int cols)
+{
+	int r, c;
+	memset(dest, 0, (rows * cols) >> 3);
+	for(r=0;r<rows;r++) {
+		for(c=0;c<cols;c++) {
+			int s = r * cols + c, d = c * rows + r;
+			dest[d>>3] |= READ_BIT(src[s>>3], s & 7) << (d & 7);
+		}
+	}
+}
+
+
+//! block interleave/deinterleave a frame
+
+//! @param dest destination (len bytes), can be the same as src
+//! @param src source
+//! @param rows rows of the matrix, multiple of 8
+//! @param cols columns of the matrix, multiple of 8
+//! @param len length of src
+//! @param inverse false to interleave, true to deinterleave
+//! @return len, or -1 if the dimensions are not supported
+int interleave_block_buf(uint8_t *dest, const uint8_t *src, int rows, int cols, int len, bool inverse)
+{
+	uint8_t tmp[INTERLEAVE_MAX_BLOCK];
+	int block = (rows >> 3) * cols, i;
+	if(rows <= 0 || cols <= 0 || (rows & 7) || (cols & 7))
+		return(-1);
+	if(dest == src && block > INTERLEAVE_MAX_BLOCK)
+		return(-1);
+	for(i=0;i<len;i+=block) {
+		const uint8_t *s = src + i;
+		int c = cols, n = block;
+		if(len - i < block) {
+			//last block, same rows, fewer columns
+			c = (len - i) / (rows >> 3);
+			n = (rows >> 3) * c;
+			if(dest != src)
+				memcpy(dest + i + n, src + i + n, len - i - n);
+		}
+		if(dest == src) {
+			memcpy(tmp, s, n);
+			s = tmp;
+		}
+		if(c & 7)
+			interleave_transpose_bits(dest + i, s, inverse ? c : rows, inverse ? rows : c);
+		else
+			interleave_transpose(dest + i, s, inverse ? c : rows, inverse ? rows : c);
+	}
+	return(len);
+}
+
+
+//! gather one byte of the convolutional interleaver, bit j from byte i - j * delay
+
+//! @param src source
+//! @param i destination byte
+//! @param delay delay step in bytes
+//! @param len length of src, bytes outside are 0
+static uint_fast8_t interleave_conv_byte(const uint8_t *src, int i, int delay, int len)
+{
+	uint_fast8_t out=0, j;
+	for(j=0;j<8;j++,i-=delay) {
+		if(i >= 0 && i < len)
+			out |= src[i] & BIT(j);
+	}
+	return(out);
+}
+
+
+//! convolutional interleave a frame
+
+//! the destination is written from the end, so it can be the same as src
+//! @param dest destination (len + INTERLEAVE_CONV_EXTRA(delay) bytes)
+//! @param src source
+//! @param delay delay step of the branches in bytes
+//! @param len length of src
+void interleave_conv_encode(uint8_t *dest, const uint8_t *src, int delay, int len)
+{
+	int i = len + INTERLEAVE_CONV_EXTRA(delay) - 1;
+	uint_fast8_t j;
+	for(;i>=len;i--)
+		dest[i] = interleave_conv_byte(src, i, delay, len);
+	//64 bits at a time while every branch is inside the frame
+	for(;i-7>=INTERLEAVE_CONV_EXTRA(delay);i-=8) {
+		uint64_t w=0;
+		for(j=0;j<8;j++)
+			w |= interleave_load(src + i - 7 - j * delay) & (INTERLEAVE_BYTE_LANES << j);
+		interleave_store(dest + i - 7, w);
+	}
+	for(;i>=0;i--)
+		dest[i] = interleave_conv_byte(src, i, delay, len);
+}
+
+
+//! convolutional deinterleave a frame
+
+//! the destination is written from the start, so it can be the same as src
+//! @param dest destination (len - INTERLEAVE_CONV_EXTRA(delay) bytes)
+//! @param src source
+//! @param delay delay step of the branches in bytes
+//! @param len length of src
+void interleave_conv_decode(uint8_t *dest, const uint8_t *src, int delay, int len)
+{
+	int i, out_len = len - INTERLEAVE_CONV_EXTRA(delay);
+	uint_fast8_t j;
+	for(i=0;i+8<=out_len;i+=8) {
+		uint64_t w=0;
+		for(j=0;j<8;j++)
+			w |= interleave_load(src + i + j * delay) & (INTERLEAVE_BYTE_LANES << j);
+		interleave_store(dest + i, w);
+	}
+	for(;i<out_len;i++) {
+		uint_fast8_t out=0;
+		for(j=0;j<8;j++)
+			out |= src[i + j * delay] & BIT(j);
+		dest[i] = out;
+	}
+}
+#endif //CONFIG_INTERLEAVE
@@ -0,0 +1,40 @@
+//! Bit interleaver, block and convolutional
+
+//! @file interleave.h
+//!
+//! Interleaving spreads a burst of channel errors over the frame, so the
+//! FEC stage in front of it sees single bit errors instead.
+//!
+//! The block interleaver writes a block into a bit matrix row by row and
+//! reads it column by column, a burst of up to rows bits hits every row at
+//! most once. rows and cols are multiples of 8, so the transpose is done as
+//! 8x8 bit tiles, in cache sized groups of INTERLEAVE_TILE x INTERLEAVE_TILE tiles.
+//! A frame is cut into blocks of rows * cols / 8 bytes, the last shorter block
+//! keeps the rows and uses fewer columns, bytes not filling a column are sent as is.
+//!
+//! The convolutional interleaver has 8 branches, bit j of every byte goes
+//! through branch j which delays it by j * delay bytes, so neighbouring
+//! channel bits end up delay bytes apart. The frame is flushed, it grows by
+//! INTERLEAVE_CONV_EXTRA(delay) bytes. Both directions run 64 bits at a time
+//! and work in place.
+
+#ifndef INTERLEAVE_H
+#define INTERLEAVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+#define INTERLEAVE_MAX_BLOCK 1024 //!< maximum block size in bytes when interleaving in place
+#define INTERLEAVE_TILE 8         //!< 8x8 bit tiles transposed per group side (64x64 bits)
+
+#define INTERLEAVE_CONV_EXTRA(delay) (7 * (delay)) //!< bytes added by the convolutional interleaver
+
+#ifdef CONFIG_INTERLEAVE
+void interleave_transpose(uint8_t *dest, const uint8_t *src, int rows, int cols);
+int interleave_block_buf(uint8_t *dest, const uint8_t *src, int rows, int cols, int len, bool inverse);
+void interleave_conv_encode(uint8_t *dest, const uint8_t *src, int delay, int len);
+void interleave_conv_decode(uint8_t *dest, const uint8_t *src, int delay, int len);
+#endif
+
+#endif
@@ -5,69 +5,230 @@
  * Fri Jun 18 16:36:23 PDT 2010 Kevin Karplus
  * Creative Commons license Attribution-NonCommercial
  *  <span class="skimlinks-unlinked">http://creativecommons.org/licenses/by-nc/3.0</span>/
+ *
+ * Streaming writer: the header is written with placeholder sizes and
+ * patched by wav_close(), so recordings of unknown length stream to disk
+ * in constant memory.  A JUNK chunk reserves room for the ds64 chunk, files
+ * whose RIFF size does not fit 32 bits are turned into RF64 at close.
  */
 
 #include <stdio.h>
-#include <assert.h>
+#include <string.h>
 
 #include "make_wav.h"
 
-void write_little_endian(unsigned int word, int num_bytes, FILE *wav_file)
+#define WAV_BUF_BYTES 16384     /* bytes formatted per fwrite on big endian hosts */
+#define WAV_JUNK_OFFSET 12      /* JUNK chunk, becomes ds64 for RF64 */
+#define WAV_DS64_SIZE 28        /* riff size, data size, sample count (64 bits each), table length */
+#define WAV_FMT_OFFSET (WAV_JUNK_OFFSET + 8 + WAV_DS64_SIZE)
+#define WAV_SIZE_UNKNOWN 0xFFFFFFFFUL   /* 32-bit size fields of RF64 files */
+
+#define WAVE_FORMAT_PCM 1
+#define WAVE_FORMAT_IEEE_FLOAT 3
+#define WAVE_FORMAT_EXTENSIBLE 0xFFFE
+
+/* store word as num_bytes little endian bytes at buf */
+static void put_little_endian(unsigned char *buf, unsigned long long word, int num_bytes)
 {
-	unsigned buf;
 	while(num_bytes>0) {
-		buf = word & 0xff;
-		fwrite(&buf, 1,1, wav_file);
+		*buf++ = word & 0xff;
 		num_bytes--;
 		word >>= 8;
 	}
 }
 
+/* overwrite num_bytes little endian bytes at offset of the file */
+static int patch_little_endian(FILE *wav_file, long offset, unsigned long long word, int num_bytes)
+{
+	unsigned char buf[8];
+	put_little_endian(buf, word, num_bytes);
+	if(fseek(wav_file, offset, SEEK_SET) || fwrite(buf, 1, num_bytes, wav_file) != (size_t)num_bytes)
+		return -1;
+	return 0;
+}
+
 /* information about the WAV file format from
-http://ccrma.stanford.edu/courses/422/projects/WaveFormat */
+http://ccrma.stanford.edu/courses/422/projects/WaveFormat
+WAVE_FORMAT_EXTENSIBLE and RF64 from the Microsoft and EBU Tech 3306 specs */
 
-void write_wav(char * filename, unsigned long num_samples, short int *data, int s_rate)
+int wav_open(wav_writer_t *w, const char *filename, int s_rate, unsigned int num_channels, wav_format_t format)
 {
-	FILE* wav_file;
+	unsigned char header[WAV_FMT_OFFSET + 8 + 40 + 12 + 8];
 	unsigned int sample_rate;
-	unsigned int num_channels;
-	unsigned int bytes_per_sample;
-	unsigned int byte_rate;
-	unsigned long i;    /* counter for samples */
+	unsigned int format_tag;
+	unsigned int fmt_size;
+	int pos;
 
-	num_channels = 1;   /* monoaural */
-	bytes_per_sample = 2;
+	if(num_channels<1 || num_channels>0xFFFF)
+		return -1;
 
 	if(s_rate<=0)
 		sample_rate = 44100;
 	else
 		sample_rate = (unsigned int) s_rate;
 
-	byte_rate = sample_rate*num_channels*bytes_per_sample;
-
-	wav_file = fopen(filename, "w");
-	assert(wav_file);   /* make sure it opened */
-
-	/* write RIFF header */
-	fwrite("RIFF", 1, 4, wav_file);
-	write_little_endian(36 + bytes_per_sample* num_samples*num_channels, 4, wav_file);
-	fwrite("WAVE", 1, 4, wav_file);
-
-	/* write fmt  subchunk */
-	fwrite("fmt ", 1, 4, wav_file);
-	write_little_endian(16, 4, wav_file);   /* SubChunk1Size is 16 */
-	write_little_endian(1, 2, wav_file);    /* PCM is format 1 */
-	write_little_endian(num_channels, 2, wav_file);
-	write_little_endian(sample_rate, 4, wav_file);
-	write_little_endian(byte_rate, 4, wav_file);
-	write_little_endian(num_channels*bytes_per_sample, 2, wav_file);  /* block align */
-	write_little_endian(8*bytes_per_sample, 2, wav_file);  /* bits/sample */
-
-	/* write data subchunk */
-	fwrite("data", 1, 4, wav_file);
-	write_little_endian(bytes_per_sample* num_samples*num_channels, 4, wav_file);
-	for (i=0; i< num_samples; i++)
-		write_little_endian((unsigned int)(data[i]),bytes_per_sample, wav_file);
-
-	fclose(wav_file);
+	w->num_channels = num_channels;
+	w->format = format;
+	switch(format) {
+	case WAV_UINT8:
+		w->bytes_per_sample = 1;
+		format_tag = WAVE_FORMAT_PCM;
+		break;
+	case WAV_FLOAT32:
+		w->bytes_per_sample = 4;
+		format_tag = WAVE_FORMAT_IEEE_FLOAT;
+		break;
+	case WAV_INT16:
+	default:
+		w->bytes_per_sample = 2;
+		format_tag = WAVE_FORMAT_PCM;
+		break;
+	}
+	/* block align is 16 bits, the byte rate 32 bits */
+	if(num_channels*w->bytes_per_sample > 0xFFFF
+	   || (unsigned long long)sample_rate*num_channels*w->bytes_per_sample > 0xFFFFFFFFULL)
+		return -1;
+	w->data_size = 0;
+	w->rf64_limit = 0xFFFFFFFFULL;
+
+	/* plain PCM header for mono/stereo integer samples, extensible otherwise */
+	fmt_size = (format_tag == WAVE_FORMAT_PCM && num_channels <= 2) ? 16 : 40;
+
+	/* RIFF header, the size is patched at close */
+	memcpy(header, "RIFFxxxxWAVE", 12);
+
+	/* JUNK chunk reserving the ds64 chunk */
+	memcpy(header + WAV_JUNK_OFFSET, "JUNK", 4);
+	put_little_endian(header + WAV_JUNK_OFFSET + 4, WAV_DS64_SIZE, 4);
+	memset(header + WAV_JUNK_OFFSET + 8, 0, WAV_DS64_SIZE);
+
+	/* fmt  subchunk */
+	pos = WAV_FMT_OFFSET;
+	memcpy(header + pos, "fmt ", 4);
+	put_little_endian(header + pos + 4, fmt_size, 4);
+	put_little_endian(header + pos + 8, fmt_size == 40 ? WAVE_FORMAT_EXTENSIBLE : format_tag, 2);
+	put_little_endian(header + pos + 10, num_channels, 2);
+	put_little_endian(header + pos + 12, sample_rate, 4);
+	put_little_endian(header + pos + 16, sample_rate*num_channels*w->bytes_per_sample, 4);   /* byte rate */
+	put_little_endian(header + pos + 20, num_channels*w->bytes_per_sample, 2);  /* block align */
+	put_little_endian(header + pos + 22, 8*w->bytes_per_sample, 2);  /* bits/sample */
+	if(fmt_size == 40) {
+		put_little_endian(header + pos + 24, 22, 2);    /* extension size */
+		put_little_endian(header + pos + 26, 8*w->bytes_per_sample, 2);  /* valid bits/sample */
+		put_little_endian(header + pos + 28, num_channels == 1 ? 0x4 : num_channels == 2 ? 0x3 : 0, 4);   /* speaker mask */
+		/* sub format GUID, format tag followed by the KSDATAFORMAT_SUBTYPE tail */
+		put_little_endian(header + pos + 32, format_tag, 4);
+		memcpy(header + pos + 36, "\x00\x00\x10\x00\x80\x00\x00\xAA\x00\x38\x9B\x71", 12);
+	}
+	pos += 8 + fmt_size;
+
+	/* fact subchunk for non-PCM data, the sample count is patched at close */
+	w->fact_offset = 0;
+	if(format_tag != WAVE_FORMAT_PCM) {
+		memcpy(header + pos, "fact", 4);
+		put_little_endian(header + pos + 4, 4, 4);
+		put_little_endian(header + pos + 8, 0, 4);
+		w->fact_offset = pos + 8;
+		pos += 12;
+	}
+
+	/* data subchunk */
+	memcpy(header + pos, "data", 4);
+	put_little_endian(header + pos + 4, 0, 4);
+	w->data_offset = pos + 4;
+	w->header_size = pos + 8;
+	put_little_endian(header + 4, w->header_size - 8, 4);
+
+	w->file = fopen(filename, "wb");
+	if(!w->file)
+		return -1;
+	if(fwrite(header, 1, w->header_size, w->file) != (size_t)w->header_size) {
+		fclose(w->file);
+		w->file = NULL;
+		return -1;
+	}
+	return 0;
+}
+
+int wav_append(wav_writer_t *w, const void *samples, unsigned long num_frames)
+{
+	unsigned long num_samples = num_frames*w->num_channels;
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	/* the array already has the file layout */
+	if(fwrite(samples, w->bytes_per_sample, num_samples, w->file) != num_samples)
+		return -1;
+#else
+	unsigned char buf[WAV_BUF_BYTES];
+	const unsigned char *in = samples;
+	unsigned long i, n;
+	unsigned short half;
+	unsigned int word;
+
+	while(num_samples>0) {
+		n = num_samples < WAV_BUF_BYTES/4 ? num_samples : WAV_BUF_BYTES/4;
+		for (i=0; i<n; i++) {
+			if(w->bytes_per_sample == 2) {
+				memcpy(&half, in + 2*i, 2);
+				put_little_endian(buf + 2*i, half, 2);
+			} else if(w->bytes_per_sample == 4) {
+				memcpy(&word, in + 4*i, 4);
+				put_little_endian(buf + 4*i, word, 4);
+			} else
+				buf[i] = in[i];
+		}
+		if(fwrite(buf, w->bytes_per_sample, n, w->file) != n)
+			return -1;
+		in += n*w->bytes_per_sample;
+		num_samples -= n;
+	}
+#endif
+	w->data_size += (unsigned long long)num_frames*w->num_channels*w->bytes_per_sample;
+	return 0;
+}
+
+int wav_close(wav_writer_t *w)
+{
+	unsigned long long riff_size, frames;
+	int err = 0;
+
+	if(!w->file)
+		return -1;
+	frames = w->data_size/(w->num_channels*w->bytes_per_sample);
+	/* chunks are word aligned */
+	if(w->data_size & 1)
+		err = fputc(0, w->file) == EOF;
+	riff_size = w->header_size - 8 + w->data_size + (w->data_size & 1);
+
+	if(!err && riff_size <= w->rf64_limit) {
+		err = patch_little_endian(w->file, 4, riff_size, 4)
+			|| patch_little_endian(w->file, w->data_offset, w->data_size, 4)
+			|| (w->fact_offset && patch_little_endian(w->file, w->fact_offset, frames, 4));
+	} else if(!err) {
+		/* RF64, the sizes go into the ds64 chunk */
+		err = fseek(w->file, 0, SEEK_SET) || fwrite("RF64", 1, 4, w->file) != 4
+			|| patch_little_endian(w->file, 4, WAV_SIZE_UNKNOWN, 4)
+			|| fseek(w->file, WAV_JUNK_OFFSET, SEEK_SET) || fwrite("ds64", 1, 4, w->file) != 4
+			|| patch_little_endian(w->file, WAV_JUNK_OFFSET + 8, riff_size, 8)
+			|| patch_little_endian(w->file, WAV_JUNK_OFFSET + 16, w->data_size, 8)
+			|| patch_little_endian(w->file, WAV_JUNK_OFFSET + 24, frames, 8)
+			|| patch_little_endian(w->file, w->data_offset, WAV_SIZE_UNKNOWN, 4)
+			|| (w->fact_offset && patch_little_endian(w->file, w->fact_offset, WAV_SIZE_UNKNOWN, 4));
+	}
+	if(fclose(w->file))
+		err = 1;
+	w->file = NULL;
+	return err ? -1 : 0;
+}
+
+int write_wav(const char * filename, unsigned long num_samples, const short int *data, int s_rate)
+{
+	wav_writer_t w;
+
+	if(wav_open(&w, filename, s_rate, 1, WAV_INT16))   /* monoaural */
+		return -1;
+	if(wav_append(&w, data, num_samples)) {
+		wav_close(&w);
+		return -1;
+	}
+	return wav_close(&w);
 }
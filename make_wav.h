@@ -5,10 +5,51 @@
 #ifndef MAKE_WAV_H
 #define MAKE_WAV_H
 
-void write_wav(char * filename, unsigned long num_samples, short int *data, int s_rate);
+#include <stdio.h>
+
+typedef enum {
+	WAV_INT16,      /* signed 16-bit (short int) */
+	WAV_UINT8,      /* unsigned 8-bit, 128 is silence */
+	WAV_FLOAT32     /* IEEE float, -1.0 to 1.0 */
+} wav_format_t;
+
+typedef struct {
+	FILE *file;
+	wav_format_t format;
+	unsigned int num_channels;
+	unsigned int bytes_per_sample;
+	unsigned long long data_size;   /* bytes of samples written */
+	long header_size;
+	long data_offset;       /* data chunk size field */
+	long fact_offset;       /* fact chunk sample count field, 0 if none */
+	unsigned long long rf64_limit;  /* RIFF sizes above are written as RF64, set by wav_open */
+} wav_writer_t;
+
+int write_wav(const char * filename, unsigned long num_samples, const short int *data, int s_rate);
     /* open a file named filename, write signed 16-bit values as a
         monoaural WAV file at the specified sampling rate
         and close the file
+        returns 0 on success, -1 if the file could not be written
+    */
+
+int wav_open(wav_writer_t *w, const char *filename, int s_rate, unsigned int num_channels, wav_format_t format);
+    /* create a WAV file for streaming, samples are added with wav_append
+        and the file is finished with wav_close
+        multichannel and float files get a WAVE_FORMAT_EXTENSIBLE header
+        returns 0 on success, -1 on error or if a frame is over 65535 bytes
+        or the byte rate over 32 bits
+    */
+
+int wav_append(wav_writer_t *w, const void *samples, unsigned long num_frames);
+    /* write num_frames frames of interleaved samples (num_channels samples
+        each, in the type of the format)
+        returns 0 on success, -1 on error
+    */
+
+int wav_close(wav_writer_t *w);
+    /* patch the sizes into the header and close the file,
+        files over 4 GB are written as RF64
+        returns 0 on success, -1 on error
     */
 
 #endif
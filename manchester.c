@@ -5,9 +5,10 @@
 //!
 //! Encoding has lookup table support, with either 16 entries (16b) or 256 entries (512b)
 //! Hardware enc/dec support on Si1024 (8051)
-//! Also included are algorithms for differential manchester and Biphase Mark Code
+//! Also included are algorithms for differential manchester, Biphase Mark Code, NRZI and Miller
 
 
+#include <string.h>
 #include "manchester.h"
 #if defined(CONFIG_MANCHESTER_ENC_NIBBLE_LOOKUP) || defined(CONFIG_MANCHESTER_ENC_BYTE_LOOKUP)
 #include "manchester_lookup.h"
@@ -89,19 +90,33 @@ uint_fast16_t manchester_encode_byte(uint_fast8_t byte)
 //! @param len length of input data
 //! @todo implement DMA based HW encoding on Si102x
 void manchester_encode_buf(uint8_t *buf, int len)
+{
+	manchester_encode_to(buf, buf, len);
+}
+
+
+//! manchester encode an array into another buffer according to G.E. Thomas convention
+
+//! invert output for IEEE802.3 convention
+//! encodes back to front, so dest may be buf
+//! @param dest destination buffer (needs to be len * 2)
+//! @param buf input data
+//! @param len length of input data
+void manchester_encode_to(uint8_t *dest, const uint8_t *buf, int len)
 {
 	int i;
 #if defined(CONFIG_MANCHESTER_ENC_BYTE)
 	for(i=len-1;i>=0;i--) {
 		uint_fast16_t tmp;
 		tmp = manchester_encode_byte(buf[i]);
-		buf[(i<<1)+1] = tmp>>8;
-		buf[(i<<1)] = tmp & 0x00ff;
+		dest[(i<<1)+1] = tmp>>8;
+		dest[(i<<1)] = tmp & 0x00ff;
 	}
 #elif defined(CONFIG_MANCHESTER_ENC_NIBBLE)
 	for(i=len-1;i>=0;i--) {
-		buf[(i<<1)+1] = manchester_encode_nibble(buf[i]>>4);
-		buf[(i<<1)] = manchester_encode_nibble(buf[i]);
+		uint_fast8_t tmp = buf[i];
+		dest[(i<<1)+1] = manchester_encode_nibble(tmp>>4);
+		dest[(i<<1)] = manchester_encode_nibble(LOW_NIBBLE(tmp));
 	}
 #else
 #error need byte encoder
@@ -195,6 +210,35 @@ int manchester_decode_buf(uint8_t *buf, int len)
 #endif
 	return(0);
 }
+
+
+//! manchester decode an array and report the invalid bytes
+
+//! invert input for IEEE802.3 convention
+//! the buffer is decoded in place, a byte with an invalid pair is decoded
+//! from the first chip of each pair, its position can be used as an erasure
+//! @param buf input/output data
+//! @param len length of input data
+//! @param erasures positions of invalid bytes in the decoded data
+//! @param max size of erasures
+//! @return amount of invalid bytes, only the first max are stored
+int manchester_decode_erasures(uint8_t *buf, int len, int *erasures, int max)
+{
+	int i, amount=0;
+	for(i=0;i+1<len;i+=2) {
+		uint_fast16_t in = buf[i] | (buf[i+1] << 8), x = in & 0x5555;
+		if(((in ^ (in >> 1)) & 0x5555) != 0x5555) {
+			if(amount < max)
+				erasures[amount] = i >> 1;
+			amount++;
+		}
+		x = (x | (x >> 1)) & 0x3333;
+		x = (x | (x >> 2)) & 0x0F0F;
+		x = (x | (x >> 4)) & 0x00FF;
+		buf[i>>1] = x;
+	}
+	return(amount);
+}
 #endif //CONFIG_MANCHESTER_ENC
 #endif //CONFIG_MANCHESTER
 
@@ -424,6 +468,235 @@ void bmc_decode_buf(uint8_t *buf, int len)
 #endif //CONFIG_BMC
 
 
+#if defined(CONFIG_NRZI) || defined(CONFIG_MILLER) || defined(CONFIG_MANCHESTER_FIXED)
+//! load up to 8 bytes, first byte in the LSB
+static uint64_t load_word(const uint8_t *buf, uint_fast8_t n)
+{
+	uint64_t out=0;
+	uint_fast8_t i;
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	if(n == 8) {
+		memcpy(&out, buf, 8);
+		return(out);
+	}
+#endif
+	for(i=0;i<n;i++)
+		out |= (uint64_t)buf[i] << (i << 3);
+	return(out);
+}
+
+
+//! store up to 8 bytes, first byte from the LSB
+static void store_word(uint8_t *buf, uint64_t w, uint_fast8_t n)
+{
+	uint_fast8_t i;
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	if(n == 8) {
+		memcpy(buf, &w, 8);
+		return;
+	}
+#endif
+	for(i=0;i<n;i++)
+		buf[i] = READ_BYTE(w, i);
+}
+#endif
+
+
+#if defined(CONFIG_MANCHESTER_FIXED) && defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC) && defined(CONFIG_MANCHESTER_DEC)
+#if defined(__clang__)
+#define MANCHESTER_UNROLL _Pragma("clang loop unroll(full)")
+#elif defined(__GNUC__) && (__GNUC__ >= 8)
+#define MANCHESTER_UNROLL _Pragma("GCC unroll 128")
+#else
+#define MANCHESTER_UNROLL
+#endif
+
+//! encoder and decoder of a frame of n bytes
+
+//! the length is a constant, the loops are unrolled and there is no tail
+//! 32 bits are coded at a time, the masks of the bit spreading are the only table
+//! encode: dest may be buf (encoded back to front), needs n * 2 bytes
+//! decode: dest may be buf, returns -1 on invalid chips
+#define MANCHESTER_FIXED(n) \
+void manchester_encode_##n(uint8_t *dest, const uint8_t *buf, bool ieee) \
+{ \
+	uint64_t inv = 0 - (uint64_t)ieee, w; \
+	int i; \
+	MANCHESTER_UNROLL \
+	for(i=(n)-4;i>=0;i-=4) { \
+		w = spread_bits(load_word(buf + i, 4)); \
+		store_word(dest + (i << 1), (w | ((w ^ 0x5555555555555555ull) << 1)) ^ inv, 8); \
+	} \
+} \
+int manchester_decode_##n(uint8_t *dest, const uint8_t *buf, bool ieee) \
+{ \
+	uint64_t inv = 0 - (uint64_t)ieee, bad = 0, w; \
+	int i; \
+	MANCHESTER_UNROLL \
+	for(i=0;i<(n)*2;i+=8) { \
+		w = load_word(buf + i, 8) ^ inv; \
+		bad |= ((w ^ (w >> 1)) & 0x5555555555555555ull) ^ 0x5555555555555555ull; \
+		store_word(dest + (i >> 1), compress_bits(w), 4); \
+	} \
+	return(bad ? -1 : 0); \
+}
+
+MANCHESTER_FIXED(16)
+MANCHESTER_FIXED(32)
+MANCHESTER_FIXED(64)
+#endif //CONFIG_MANCHESTER_FIXED
+
+
+#ifdef CONFIG_NRZI
+//! NRZI encode a byte, transition on 1
+
+//! @param prev level before the byte
+uint_fast8_t nrzi_encode_byte(bool prev, uint_fast8_t in)
+{
+	return(LOW_BYTE(prefix_xor(in) ^ (0 - (uint_fast8_t)prev)));
+}
+
+
+//! NRZI decode a byte, transition = 1
+
+//! @param prev level before the byte
+uint_fast8_t nrzi_decode_byte(bool prev, uint_fast8_t in)
+{
+	return(LOW_BYTE(in ^ ((in << 1) | prev)));
+}
+
+
+//! NRZI encode an array, transition on 1
+
+//! the buffer is encoded in place, 64 bits at a time
+//! invert the input for transition on 0 (NRZ-S, USB)
+//! @param prev level before the sequence
+//! @param buf input/output data
+//! @param len length of buf
+//! @return level after the sequence
+bool nrzi_encode_buf(bool prev, uint8_t *buf, int len)
+{
+	int i;
+	for(i=0;i<len;i+=8) {
+		uint_fast8_t n = min(8, len - i);
+		uint64_t w = prefix_xor(load_word(buf + i, n)) ^ (0 - (uint64_t)prev);
+		store_word(buf + i, w, n);
+		prev = (w >> ((n << 3) - 1)) & 1;
+	}
+	return(prev);
+}
+
+
+//! NRZI decode an array, transition = 1
+
+//! the buffer is decoded in place, 64 bits at a time
+//! @param prev level before the sequence
+//! @param buf input/output data
+//! @param len length of buf
+//! @return level after the sequence
+bool nrzi_decode_buf(bool prev, uint8_t *buf, int len)
+{
+	int i;
+	for(i=0;i<len;i+=8) {
+		uint_fast8_t n = min(8, len - i);
+		uint64_t w = load_word(buf + i, n);
+		store_word(buf + i, w ^ ((w << 1) | prev), n);
+		prev = (w >> ((n << 3) - 1)) & 1;
+	}
+	return(prev);
+}
+#endif //CONFIG_NRZI
+
+
+#ifdef CONFIG_MILLER
+#define MILLER_EVEN 0x5555555555555555ull
+
+
+//! miller encode up to 4 bytes
+
+//! The level toggles on every rising edge of the IEEE802.3 manchester code
+//! of the data, which is in the middle of a 1 and between two 0.
+//! @param prev level before the bits, updated
+//! @param last previous data bit, updated
+//! @param in data
+//! @param n amount of bytes (1-4)
+//! @return 16 * n chips
+static uint64_t miller_encode_word(bool *prev, bool *last, uint64_t in, uint_fast8_t n)
+{
+	uint64_t mask = (n == 4) ? ~(uint64_t)0 : ((uint64_t)1 << (n << 4)) - 1;
+	uint64_t s = spread_bits(in);
+	uint64_t m = ((s << 1) | (~s & MILLER_EVEN)) & mask;
+	uint64_t out = (prefix_xor(m & ~((m << 1) | *last)) ^ (0 - (uint64_t)*prev)) & mask;
+	*last = (m >> ((n << 4) - 1)) & 1;
+	*prev = (out >> ((n << 4) - 1)) & 1;
+	return(out);
+}
+
+
+#ifdef CONFIG_MILLER_ENC
+//! miller (delay modulation) encode a byte
+
+//! for encoders which keep their own state between bytes
+//! @param prev level before the byte, updated
+//! @param last previous data bit, updated (1 at the start of a sequence)
+//! @param in data
+//! @return 16 chips
+uint_fast16_t miller_encode_byte(bool *prev, bool *last, uint_fast8_t in)
+{
+	return((uint_fast16_t)miller_encode_word(prev, last, in, 1));
+}
+
+
+//! miller (delay modulation) encode an array
+
+//! the bit before the sequence is taken as 1, so a sequence never starts with a transition
+//! Tip: if buf = dest + len you can reuse the same buffer
+//! @param dest destination buffer (needs to be len * 2)
+//! @param prev level before the sequence
+//! @param buf input data
+//! @param len length of buf
+void miller_encode_buf(uint8_t *dest, bool prev, const uint8_t *buf, int len)
+{
+	bool last = 1;
+	int i;
+	for(i=0;i<len;i+=4) {
+		uint_fast8_t n = min(4, len - i);
+		uint64_t w = miller_encode_word(&prev, &last, load_word(buf + i, n), n);
+		store_word(dest + (i << 1), w, n << 1);
+	}
+}
+#endif //CONFIG_MILLER_ENC
+
+
+#ifdef CONFIG_MILLER_DEC
+//! miller decode an array
+
+//! the buffer is decoded in place, a 1 is a transition in the middle of the bit
+//! the chips are checked by encoding the decoded data again
+//! @param prev level before the sequence
+//! @param buf input/output data
+//! @param len length of input data
+//! @return amount of chips violating the code, 0 = ok
+int miller_decode_buf(bool prev, uint8_t *buf, int len)
+{
+	bool last = 1;
+	int i, errors=0;
+	for(i=0;i<len;i+=8) {
+		uint_fast8_t n = min(8, len - i) >> 1;
+		uint64_t w = load_word(buf + i, n << 1), data, diff;
+		if(!n)
+			break;
+		data = compress_bits(w ^ (w >> 1));
+		diff = miller_encode_word(&prev, &last, data, n) ^ w;
+		errors += count_set_bits(diff & 0xffffffff) + count_set_bits(diff >> 32);
+		store_word(buf + (i >> 1), data, n);
+	}
+	return(errors);
+}
+#endif //CONFIG_MILLER_DEC
+#endif //CONFIG_MILLER
+
+
 //! decode a sequence of bits into transitions where transition=1
 
 //! @param prev last bit of previous sequence
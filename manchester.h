@@ -5,7 +5,8 @@
 //!
 //! Encoding has lookup table support, with either 16 entries (16b) or 256 entries (512b)
 //! Hardware enc/dec support on Si1024 (8051)
-//! Also included are algorithms for differential manchester and Biphase Mark Code
+//! Also included are algorithms for differential manchester, Biphase Mark Code, NRZI and Miller
+//! NRZI and Miller work on 64 bits at a time (running XOR), never bit by bit
 
 #ifndef MANCHESTER_H
 #define MANCHESTER_H
@@ -54,6 +55,15 @@
 #define bmc_check_bit(prev, b) (prev ^ READ_BIT((b), 0))
 #define bmc_decode_bit(b) (READ_BIT((b),0) ^ READ_BIT((b),1))
 
+//! encode a NRZI bit where transition=1
+
+//! @param prev level of the previous bit
+#define nrzi_encode_bit(prev, b) ((prev) ^ (b))
+#define nrzi_decode_bit(prev, b) ((prev) ^ (b))
+
+//! decode a miller sequence, transition in the middle of the bit=1
+#define miller_decode_bit(b) (READ_BIT((b),0) ^ READ_BIT((b),1))
+
 //manchester
 #ifdef CONFIG_MANCHESTER
 #ifdef CONFIG_MANCHESTER_ENC
@@ -64,6 +74,7 @@ uint_fast8_t manchester_encode_nibble(uint_fast8_t nibble);
 uint_fast16_t manchester_encode_byte(uint_fast8_t byte);
 #endif
 void manchester_encode_buf(uint8_t *buf, int len);
+void manchester_encode_to(uint8_t *dest, const uint8_t *buf, int len);
 #endif
 #ifdef CONFIG_MANCHESTER_DEC
 #ifdef CONFIG_MANCHESTER_DEC_NIBBLE
@@ -73,7 +84,24 @@ int_fast8_t manchester_decode_nibble(uint_fast8_t in);
 int_fast16_t manchester_decode_byte(uint_fast16_t in);
 #endif
 int manchester_decode_buf(uint8_t *buf, int len);
+int manchester_decode_erasures(uint8_t *buf, int len, int *erasures, int max);
+#endif
 #endif
+
+//fixed frame sizes, unrolled
+#if defined(CONFIG_MANCHESTER_FIXED) && defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC) && defined(CONFIG_MANCHESTER_DEC)
+void manchester_encode_16(uint8_t *dest, const uint8_t *buf, bool ieee);
+void manchester_encode_32(uint8_t *dest, const uint8_t *buf, bool ieee);
+void manchester_encode_64(uint8_t *dest, const uint8_t *buf, bool ieee);
+int manchester_decode_16(uint8_t *dest, const uint8_t *buf, bool ieee);
+int manchester_decode_32(uint8_t *dest, const uint8_t *buf, bool ieee);
+int manchester_decode_64(uint8_t *dest, const uint8_t *buf, bool ieee);
+
+//! manchester encode a frame of a constant size (16, 32 or 64 bytes)
+#define manchester_encode_fixed(n, dest, buf, ieee) manchester_encode_##n((dest), (buf), (ieee))
+
+//! manchester decode a frame of a constant size (16, 32 or 64 bytes)
+#define manchester_decode_fixed(n, dest, buf, ieee) manchester_decode_##n((dest), (buf), (ieee))
 #endif
 
 #if defined(CONFIG_MANCHESTER_ERROR_DETECTOR) && (defined(CONFIG_MANCHESTER) || defined(CONFIG_DIFF_MANCHESTER))
@@ -109,6 +137,25 @@ void bmc_decode_buf(uint8_t *buf, int len);
 #endif
 #endif
 
+//nrzi
+#ifdef CONFIG_NRZI
+uint_fast8_t nrzi_encode_byte(bool prev, uint_fast8_t in);
+uint_fast8_t nrzi_decode_byte(bool prev, uint_fast8_t in);
+bool nrzi_encode_buf(bool prev, uint8_t *buf, int len);
+bool nrzi_decode_buf(bool prev, uint8_t *buf, int len);
+#endif
+
+//miller
+#ifdef CONFIG_MILLER
+#ifdef CONFIG_MILLER_ENC
+uint_fast16_t miller_encode_byte(bool *prev, bool *last, uint_fast8_t in);
+void miller_encode_buf(uint8_t *dest, bool prev, const uint8_t *buf, int len);
+#endif
+#ifdef CONFIG_MILLER_DEC
+int miller_decode_buf(bool prev, uint8_t *buf, int len);
+#endif
+#endif
+
 uint_fast8_t find_transitions_in_byte(bool prev, uint_fast8_t in);
 
 #endif
@@ -0,0 +1,154 @@
+//! Numerically controlled oscillator
+
+//! @file nco.c
+
+
+#include <math.h>
+#include "config.h"
+#if defined(CONFIG_NCO) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "nco.h"
+#include "nco_lookup.h"
+
+
+#ifdef CONFIG_NCO
+#define NCO_FRAC_MASK ((1UL << NCO_FRAC_BITS) - 1)
+#define NCO_FRAC_SCALE (1.0f / (1UL << NCO_FRAC_BITS))
+
+
+//! phase increment of a frequency
+
+//! @param freq frequency in Hz, negative frequencies run backwards
+//! @param sample_rate samples per second
+uint32_t nco_inc(double freq, double sample_rate)
+{
+	double turns = freq / sample_rate;
+	turns -= floor(turns);
+	return((uint32_t)llround(turns * 4294967296.0));
+}
+
+
+//! set an oscillator to a frequency, starting at phase 0
+
+//! @param n oscillator
+//! @param freq frequency in Hz
+//! @param sample_rate samples per second
+void nco_init(nco_t *n, double freq, double sample_rate)
+{
+	n->phase = 0;
+	n->inc = nco_inc(freq, sample_rate);
+}
+
+
+//! sine of a phase
+
+//! @param phase 2^32 is one turn
+//! @return -1.0 to 1.0
+float nco_sin(uint32_t phase)
+{
+	uint32_t u = phase & (NCO_QUARTER - 1), i;
+	float s;
+	if(phase & NCO_QUARTER)
+		u ^= NCO_QUARTER - 1; //falling quarter, mirrored
+	i = u >> NCO_FRAC_BITS;
+	s = nco_sine[i] + (nco_sine[i+1] - nco_sine[i]) * ((u & NCO_FRAC_MASK) * NCO_FRAC_SCALE);
+	return((phase & 0x80000000UL) ? -s : s);
+}
+
+
+#ifdef __SSE2__
+//! sine of 4 phases, see nco_sin()
+static __m128 nco_sin4(__m128i phase)
+{
+	__m128i u = _mm_and_si128(phase, _mm_set1_epi32(NCO_QUARTER - 1));
+	__m128i mirror = _mm_srai_epi32(_mm_slli_epi32(phase, 1), 31);
+	__m128i idx;
+	__m128 frac, a, b;
+	uint32_t i[4];
+	u = _mm_xor_si128(u, _mm_and_si128(mirror, _mm_set1_epi32(NCO_QUARTER - 1)));
+	idx = _mm_srli_epi32(u, NCO_FRAC_BITS);
+	frac = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(u, _mm_set1_epi32(NCO_FRAC_MASK))), _mm_set1_ps(NCO_FRAC_SCALE));
+	_mm_storeu_si128((__m128i *)i, idx);
+	a = _mm_set_ps(nco_sine[i[3]], nco_sine[i[2]], nco_sine[i[1]], nco_sine[i[0]]);
+	b = _mm_set_ps(nco_sine[i[3]+1], nco_sine[i[2]+1], nco_sine[i[1]+1], nco_sine[i[0]+1]);
+	a = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), frac));
+	//bit 31 of the phase is the sign
+	return(_mm_xor_ps(a, _mm_castsi128_ps(_mm_and_si128(phase, _mm_set1_epi32(INT32_MIN)))));
+}
+#endif
+
+
+//! generate a block of float samples
+
+//! @param n oscillator, the phase is advanced
+//! @param dest output
+//! @param len amount of samples
+//! @param amplitude peak value
+void nco_float(nco_t *n, float *dest, int len, float amplitude)
+{
+	int i=0;
+#ifdef __SSE2__
+	__m128i phase = _mm_add_epi32(_mm_set1_epi32(n->phase), _mm_set_epi32(3 * n->inc, 2 * n->inc, n->inc, 0));
+	__m128i step = _mm_set1_epi32(4 * n->inc);
+	__m128 amp = _mm_set1_ps(amplitude);
+	for(;i+4<=len;i+=4) {
+		_mm_storeu_ps(dest + i, _mm_mul_ps(nco_sin4(phase), amp));
+		phase = _mm_add_epi32(phase, step);
+	}
+	n->phase += i * n->inc;
+#endif
+	for(;i<len;i++) {
+		dest[i] = nco_sin(n->phase) * amplitude;
+		n->phase += n->inc;
+	}
+}
+
+
+//! generate a block of int16 samples
+
+//! @param n oscillator, the phase is advanced
+//! @param dest output
+//! @param len amount of samples
+//! @param amplitude peak value (up to 32767)
+void nco_int16(nco_t *n, int16_t *dest, int len, float amplitude)
+{
+	int i=0;
+#ifdef __SSE2__
+	__m128i phase = _mm_add_epi32(_mm_set1_epi32(n->phase), _mm_set_epi32(3 * n->inc, 2 * n->inc, n->inc, 0));
+	__m128i step = _mm_set1_epi32(4 * n->inc);
+	__m128 amp = _mm_set1_ps(amplitude);
+	for(;i+8<=len;i+=8) {
+		__m128i lo = _mm_cvtps_epi32(_mm_mul_ps(nco_sin4(phase), amp));
+		__m128i hi = _mm_cvtps_epi32(_mm_mul_ps(nco_sin4(_mm_add_epi32(phase, step)), amp));
+		_mm_storeu_si128((__m128i *)(dest + i), _mm_packs_epi32(lo, hi));
+		phase = _mm_add_epi32(phase, _mm_add_epi32(step, step));
+	}
+	n->phase += i * n->inc;
+#endif
+	for(;i<len;i++) {
+		dest[i] = (int16_t)lrintf(nco_sin(n->phase) * amplitude);
+		n->phase += n->inc;
+	}
+}
+
+
+//! sine of a block of phases
+
+//! for modulators which make the phase themselves, a cosine is the phase + NCO_QUARTER
+//! @param dest output
+//! @param phase phases, 2^32 is one turn
+//! @param len amount of samples
+//! @param amplitude peak value
+void nco_sin_buf(float *dest, const uint32_t *phase, int len, float amplitude)
+{
+	int i=0;
+#ifdef __SSE2__
+	__m128 amp = _mm_set1_ps(amplitude);
+	for(;i+4<=len;i+=4)
+		_mm_storeu_ps(dest + i, _mm_mul_ps(nco_sin4(_mm_loadu_si128((const __m128i *)(phase + i))), amp));
+#endif
+	for(;i<len;i++)
+		dest[i] = nco_sin(phase[i]) * amplitude;
+}
+#endif //CONFIG_NCO
@@ -0,0 +1,40 @@
+//! Numerically controlled oscillator
+
+//! @file nco.h
+//!
+//! The phase is a 32 bit accumulator (2^32 = one turn), the frequency is the
+//! phase increment per sample, so the frequency resolution is rate / 2^32 and
+//! the phase never drifts, the accumulator just wraps.
+//!
+//! The sine comes from a quarter wave table of NCO_TABLE_LEN + 1 entries
+//! (generated by nco_lookup_create) with linear interpolation, the error is
+//! below 1e-6 of full scale. Bit 31 of the phase is the sign, bit 30 mirrors
+//! the quarter. Blocks are computed 4 samples at a time with SSE2 when available.
+
+#ifndef NCO_H
+#define NCO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+#define NCO_TABLE_BITS 10
+#define NCO_TABLE_LEN (1 << NCO_TABLE_BITS)  //!< entries per quarter wave
+#define NCO_FRAC_BITS (30 - NCO_TABLE_BITS)  //!< phase bits interpolated between two entries
+#define NCO_QUARTER 0x40000000UL             //!< phase of 90 degree
+
+typedef struct {
+	uint32_t phase;  //!< phase of the next sample
+	uint32_t inc;    //!< phase increment per sample
+} nco_t;
+
+#ifdef CONFIG_NCO
+uint32_t nco_inc(double freq, double sample_rate);
+void nco_init(nco_t *n, double freq, double sample_rate);
+float nco_sin(uint32_t phase);
+void nco_float(nco_t *n, float *dest, int len, float amplitude);
+void nco_int16(nco_t *n, int16_t *dest, int len, float amplitude);
+void nco_sin_buf(float *dest, const uint32_t *phase, int len, float amplitude);
+#endif
+
+#endif
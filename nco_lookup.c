@@ -0,0 +1,1031 @@
+#include "nco_lookup.h"
+
+#ifdef CONFIG_NCO
+const float nco_sine[1025] = {
+0.000000000e+00f,
+1.533980186e-03f,
+3.067956763e-03f,
+4.601926120e-03f,
+6.135884649e-03f,
+7.669828740e-03f,
+9.203754782e-03f,
+1.073765917e-02f,
+1.227153829e-02f,
+1.380538853e-02f,
+1.533920628e-02f,
+1.687298795e-02f,
+1.840672991e-02f,
+1.994042855e-02f,
+2.147408028e-02f,
+2.300768147e-02f,
+2.454122852e-02f,
+2.607471783e-02f,
+2.760814578e-02f,
+2.914150876e-02f,
+3.067480318e-02f,
+3.220802541e-02f,
+3.374117185e-02f,
+3.527423890e-02f,
+3.680722294e-02f,
+3.834012037e-02f,
+3.987292759e-02f,
+4.140564098e-02f,
+4.293825693e-02f,
+4.447077185e-02f,
+4.600318213e-02f,
+4.753548416e-02f,
+4.906767433e-02f,
+5.059974904e-02f,
+5.213170468e-02f,
+5.366353765e-02f,
+5.519524435e-02f,
+5.672682117e-02f,
+5.825826450e-02f,
+5.978957075e-02f,
+6.132073630e-02f,
+6.285175756e-02f,
+6.438263093e-02f,
+6.591335280e-02f,
+6.744391956e-02f,
+6.897432763e-02f,
+7.050457339e-02f,
+7.203465325e-02f,
+7.356456360e-02f,
+7.509430085e-02f,
+7.662386139e-02f,
+7.815324163e-02f,
+7.968243797e-02f,
+8.121144681e-02f,
+8.274026455e-02f,
+8.426888759e-02f,
+8.579731234e-02f,
+8.732553521e-02f,
+8.885355258e-02f,
+9.038136088e-02f,
+9.190895650e-02f,
+9.343633585e-02f,
+9.496349533e-02f,
+9.649043136e-02f,
+9.801714033e-02f,
+9.954361866e-02f,
+1.010698628e-01f,
+1.025958690e-01f,
+1.041216339e-01f,
+1.056471537e-01f,
+1.071724250e-01f,
+1.086974440e-01f,
+1.102222073e-01f,
+1.117467112e-01f,
+1.132709522e-01f,
+1.147949266e-01f,
+1.163186309e-01f,
+1.178420615e-01f,
+1.193652148e-01f,
+1.208880872e-01f,
+1.224106752e-01f,
+1.239329751e-01f,
+1.254549834e-01f,
+1.269766965e-01f,
+1.284981108e-01f,
+1.300192227e-01f,
+1.315400287e-01f,
+1.330605252e-01f,
+1.345807085e-01f,
+1.361005752e-01f,
+1.376201216e-01f,
+1.391393442e-01f,
+1.406582393e-01f,
+1.421768035e-01f,
+1.436950332e-01f,
+1.452129247e-01f,
+1.467304745e-01f,
+1.482476790e-01f,
+1.497645347e-01f,
+1.512810380e-01f,
+1.527971853e-01f,
+1.543129730e-01f,
+1.558283977e-01f,
+1.573434556e-01f,
+1.588581433e-01f,
+1.603724572e-01f,
+1.618863938e-01f,
+1.633999494e-01f,
+1.649131205e-01f,
+1.664259035e-01f,
+1.679382950e-01f,
+1.694502912e-01f,
+1.709618888e-01f,
+1.724730840e-01f,
+1.739838734e-01f,
+1.754942534e-01f,
+1.770042204e-01f,
+1.785137709e-01f,
+1.800229014e-01f,
+1.815316083e-01f,
+1.830398880e-01f,
+1.845477369e-01f,
+1.860551517e-01f,
+1.875621286e-01f,
+1.890686641e-01f,
+1.905747548e-01f,
+1.920803970e-01f,
+1.935855873e-01f,
+1.950903220e-01f,
+1.965945977e-01f,
+1.980984107e-01f,
+1.996017576e-01f,
+2.011046348e-01f,
+2.026070388e-01f,
+2.041089661e-01f,
+2.056104131e-01f,
+2.071113762e-01f,
+2.086118520e-01f,
+2.101118369e-01f,
+2.116113274e-01f,
+2.131103199e-01f,
+2.146088110e-01f,
+2.161067971e-01f,
+2.176042746e-01f,
+2.191012402e-01f,
+2.205976901e-01f,
+2.220936210e-01f,
+2.235890292e-01f,
+2.250839114e-01f,
+2.265782638e-01f,
+2.280720832e-01f,
+2.295653658e-01f,
+2.310581083e-01f,
+2.325503070e-01f,
+2.340419586e-01f,
+2.355330594e-01f,
+2.370236060e-01f,
+2.385135948e-01f,
+2.400030224e-01f,
+2.414918853e-01f,
+2.429801799e-01f,
+2.444679027e-01f,
+2.459550503e-01f,
+2.474416192e-01f,
+2.489276057e-01f,
+2.504130066e-01f,
+2.518978182e-01f,
+2.533820370e-01f,
+2.548656596e-01f,
+2.563486825e-01f,
+2.578311022e-01f,
+2.593129151e-01f,
+2.607941179e-01f,
+2.622747070e-01f,
+2.637546790e-01f,
+2.652340303e-01f,
+2.667127575e-01f,
+2.681908571e-01f,
+2.696683256e-01f,
+2.711451595e-01f,
+2.726213554e-01f,
+2.740969099e-01f,
+2.755718193e-01f,
+2.770460803e-01f,
+2.785196894e-01f,
+2.799926431e-01f,
+2.814649379e-01f,
+2.829365705e-01f,
+2.844075372e-01f,
+2.858778347e-01f,
+2.873474595e-01f,
+2.888164082e-01f,
+2.902846773e-01f,
+2.917522632e-01f,
+2.932191627e-01f,
+2.946853722e-01f,
+2.961508882e-01f,
+2.976157074e-01f,
+2.990798263e-01f,
+3.005432414e-01f,
+3.020059493e-01f,
+3.034679466e-01f,
+3.049292297e-01f,
+3.063897954e-01f,
+3.078496400e-01f,
+3.093087603e-01f,
+3.107671527e-01f,
+3.122248139e-01f,
+3.136817404e-01f,
+3.151379288e-01f,
+3.165933756e-01f,
+3.180480774e-01f,
+3.195020308e-01f,
+3.209552324e-01f,
+3.224076788e-01f,
+3.238593665e-01f,
+3.253102922e-01f,
+3.267604523e-01f,
+3.282098436e-01f,
+3.296584625e-01f,
+3.311063058e-01f,
+3.325533699e-01f,
+3.339996514e-01f,
+3.354451471e-01f,
+3.368898534e-01f,
+3.383337670e-01f,
+3.397768844e-01f,
+3.412192023e-01f,
+3.426607173e-01f,
+3.441014260e-01f,
+3.455413250e-01f,
+3.469804108e-01f,
+3.484186802e-01f,
+3.498561298e-01f,
+3.512927561e-01f,
+3.527285558e-01f,
+3.541635254e-01f,
+3.555976617e-01f,
+3.570309612e-01f,
+3.584634206e-01f,
+3.598950365e-01f,
+3.613258056e-01f,
+3.627557244e-01f,
+3.641847896e-01f,
+3.656129978e-01f,
+3.670403457e-01f,
+3.684668300e-01f,
+3.698924471e-01f,
+3.713171940e-01f,
+3.727410670e-01f,
+3.741640630e-01f,
+3.755861785e-01f,
+3.770074102e-01f,
+3.784277548e-01f,
+3.798472089e-01f,
+3.812657692e-01f,
+3.826834324e-01f,
+3.841001950e-01f,
+3.855160538e-01f,
+3.869310055e-01f,
+3.883450467e-01f,
+3.897581741e-01f,
+3.911703843e-01f,
+3.925816741e-01f,
+3.939920401e-01f,
+3.954014789e-01f,
+3.968099874e-01f,
+3.982175622e-01f,
+3.996241998e-01f,
+4.010298972e-01f,
+4.024346509e-01f,
+4.038384576e-01f,
+4.052413140e-01f,
+4.066432169e-01f,
+4.080441629e-01f,
+4.094441487e-01f,
+4.108431711e-01f,
+4.122412267e-01f,
+4.136383122e-01f,
+4.150344245e-01f,
+4.164295601e-01f,
+4.178237158e-01f,
+4.192168884e-01f,
+4.206090744e-01f,
+4.220002708e-01f,
+4.233904741e-01f,
+4.247796812e-01f,
+4.261678887e-01f,
+4.275550934e-01f,
+4.289412921e-01f,
+4.303264813e-01f,
+4.317106580e-01f,
+4.330938189e-01f,
+4.344759606e-01f,
+4.358570799e-01f,
+4.372371737e-01f,
+4.386162385e-01f,
+4.399942713e-01f,
+4.413712687e-01f,
+4.427472276e-01f,
+4.441221446e-01f,
+4.454960165e-01f,
+4.468688402e-01f,
+4.482406123e-01f,
+4.496113297e-01f,
+4.509809890e-01f,
+4.523495872e-01f,
+4.537171210e-01f,
+4.550835871e-01f,
+4.564489824e-01f,
+4.578133036e-01f,
+4.591765475e-01f,
+4.605387110e-01f,
+4.618997907e-01f,
+4.632597836e-01f,
+4.646186863e-01f,
+4.659764958e-01f,
+4.673332087e-01f,
+4.686888220e-01f,
+4.700433325e-01f,
+4.713967368e-01f,
+4.727490320e-01f,
+4.741002147e-01f,
+4.754502817e-01f,
+4.767992301e-01f,
+4.781470564e-01f,
+4.794937577e-01f,
+4.808393306e-01f,
+4.821837721e-01f,
+4.835270789e-01f,
+4.848692480e-01f,
+4.862102761e-01f,
+4.875501601e-01f,
+4.888888969e-01f,
+4.902264833e-01f,
+4.915629161e-01f,
+4.928981922e-01f,
+4.942323085e-01f,
+4.955652618e-01f,
+4.968970490e-01f,
+4.982276670e-01f,
+4.995571125e-01f,
+5.008853826e-01f,
+5.022124740e-01f,
+5.035383837e-01f,
+5.048631085e-01f,
+5.061866453e-01f,
+5.075089911e-01f,
+5.088301425e-01f,
+5.101500967e-01f,
+5.114688504e-01f,
+5.127864006e-01f,
+5.141027442e-01f,
+5.154178780e-01f,
+5.167317990e-01f,
+5.180445041e-01f,
+5.193559902e-01f,
+5.206662541e-01f,
+5.219752929e-01f,
+5.232831035e-01f,
+5.245896827e-01f,
+5.258950275e-01f,
+5.271991348e-01f,
+5.285020015e-01f,
+5.298036247e-01f,
+5.311040012e-01f,
+5.324031279e-01f,
+5.337010018e-01f,
+5.349976199e-01f,
+5.362929791e-01f,
+5.375870763e-01f,
+5.388799085e-01f,
+5.401714727e-01f,
+5.414617659e-01f,
+5.427507849e-01f,
+5.440385267e-01f,
+5.453249884e-01f,
+5.466101669e-01f,
+5.478940592e-01f,
+5.491766622e-01f,
+5.504579729e-01f,
+5.517379884e-01f,
+5.530167056e-01f,
+5.542941215e-01f,
+5.555702330e-01f,
+5.568450373e-01f,
+5.581185312e-01f,
+5.593907119e-01f,
+5.606615762e-01f,
+5.619311212e-01f,
+5.631993440e-01f,
+5.644662415e-01f,
+5.657318108e-01f,
+5.669960488e-01f,
+5.682589527e-01f,
+5.695205193e-01f,
+5.707807459e-01f,
+5.720396293e-01f,
+5.732971667e-01f,
+5.745533550e-01f,
+5.758081914e-01f,
+5.770616729e-01f,
+5.783137964e-01f,
+5.795645591e-01f,
+5.808139581e-01f,
+5.820619903e-01f,
+5.833086529e-01f,
+5.845539430e-01f,
+5.857978575e-01f,
+5.870403935e-01f,
+5.882815482e-01f,
+5.895213186e-01f,
+5.907597019e-01f,
+5.919966950e-01f,
+5.932322950e-01f,
+5.944664992e-01f,
+5.956993045e-01f,
+5.969307081e-01f,
+5.981607070e-01f,
+5.993892984e-01f,
+6.006164794e-01f,
+6.018422471e-01f,
+6.030665985e-01f,
+6.042895309e-01f,
+6.055110414e-01f,
+6.067311270e-01f,
+6.079497850e-01f,
+6.091670123e-01f,
+6.103828063e-01f,
+6.115971639e-01f,
+6.128100824e-01f,
+6.140215589e-01f,
+6.152315906e-01f,
+6.164401745e-01f,
+6.176473079e-01f,
+6.188529880e-01f,
+6.200572118e-01f,
+6.212599765e-01f,
+6.224612794e-01f,
+6.236611175e-01f,
+6.248594881e-01f,
+6.260563884e-01f,
+6.272518155e-01f,
+6.284457666e-01f,
+6.296382389e-01f,
+6.308292296e-01f,
+6.320187359e-01f,
+6.332067551e-01f,
+6.343932842e-01f,
+6.355783205e-01f,
+6.367618612e-01f,
+6.379439036e-01f,
+6.391244449e-01f,
+6.403034822e-01f,
+6.414810128e-01f,
+6.426570340e-01f,
+6.438315429e-01f,
+6.450045368e-01f,
+6.461760130e-01f,
+6.473459686e-01f,
+6.485144010e-01f,
+6.496813074e-01f,
+6.508466850e-01f,
+6.520105311e-01f,
+6.531728430e-01f,
+6.543336178e-01f,
+6.554928530e-01f,
+6.566505457e-01f,
+6.578066933e-01f,
+6.589612930e-01f,
+6.601143421e-01f,
+6.612658378e-01f,
+6.624157776e-01f,
+6.635641586e-01f,
+6.647109782e-01f,
+6.658562337e-01f,
+6.669999223e-01f,
+6.681420414e-01f,
+6.692825883e-01f,
+6.704215604e-01f,
+6.715589548e-01f,
+6.726947691e-01f,
+6.738290004e-01f,
+6.749616461e-01f,
+6.760927036e-01f,
+6.772221701e-01f,
+6.783500431e-01f,
+6.794763199e-01f,
+6.806009978e-01f,
+6.817240742e-01f,
+6.828455464e-01f,
+6.839654118e-01f,
+6.850836678e-01f,
+6.862003117e-01f,
+6.873153409e-01f,
+6.884287528e-01f,
+6.895405447e-01f,
+6.906507141e-01f,
+6.917592584e-01f,
+6.928661748e-01f,
+6.939714609e-01f,
+6.950751140e-01f,
+6.961771315e-01f,
+6.972775108e-01f,
+6.983762494e-01f,
+6.994733446e-01f,
+7.005687939e-01f,
+7.016625947e-01f,
+7.027547445e-01f,
+7.038452405e-01f,
+7.049340804e-01f,
+7.060212614e-01f,
+7.071067812e-01f,
+7.081906370e-01f,
+7.092728264e-01f,
+7.103533469e-01f,
+7.114321957e-01f,
+7.125093706e-01f,
+7.135848688e-01f,
+7.146586879e-01f,
+7.157308253e-01f,
+7.168012785e-01f,
+7.178700451e-01f,
+7.189371224e-01f,
+7.200025080e-01f,
+7.210661993e-01f,
+7.221281939e-01f,
+7.231884893e-01f,
+7.242470830e-01f,
+7.253039724e-01f,
+7.263591551e-01f,
+7.274126286e-01f,
+7.284643904e-01f,
+7.295144381e-01f,
+7.305627692e-01f,
+7.316093812e-01f,
+7.326542717e-01f,
+7.336974381e-01f,
+7.347388781e-01f,
+7.357785892e-01f,
+7.368165689e-01f,
+7.378528148e-01f,
+7.388873245e-01f,
+7.399200955e-01f,
+7.409511254e-01f,
+7.419804117e-01f,
+7.430079521e-01f,
+7.440337442e-01f,
+7.450577854e-01f,
+7.460800735e-01f,
+7.471006060e-01f,
+7.481193805e-01f,
+7.491363945e-01f,
+7.501516458e-01f,
+7.511651319e-01f,
+7.521768504e-01f,
+7.531867990e-01f,
+7.541949753e-01f,
+7.552013769e-01f,
+7.562060014e-01f,
+7.572088465e-01f,
+7.582099098e-01f,
+7.592091890e-01f,
+7.602066817e-01f,
+7.612023855e-01f,
+7.621962981e-01f,
+7.631884173e-01f,
+7.641787405e-01f,
+7.651672656e-01f,
+7.661539902e-01f,
+7.671389119e-01f,
+7.681220285e-01f,
+7.691033376e-01f,
+7.700828370e-01f,
+7.710605243e-01f,
+7.720363972e-01f,
+7.730104534e-01f,
+7.739826906e-01f,
+7.749531066e-01f,
+7.759216990e-01f,
+7.768884657e-01f,
+7.778534042e-01f,
+7.788165124e-01f,
+7.797777879e-01f,
+7.807372286e-01f,
+7.816948321e-01f,
+7.826505962e-01f,
+7.836045186e-01f,
+7.845565972e-01f,
+7.855068296e-01f,
+7.864552136e-01f,
+7.874017470e-01f,
+7.883464276e-01f,
+7.892892532e-01f,
+7.902302214e-01f,
+7.911693302e-01f,
+7.921065773e-01f,
+7.930419605e-01f,
+7.939754776e-01f,
+7.949071263e-01f,
+7.958369046e-01f,
+7.967648102e-01f,
+7.976908409e-01f,
+7.986149946e-01f,
+7.995372691e-01f,
+8.004576622e-01f,
+8.013761717e-01f,
+8.022927955e-01f,
+8.032075315e-01f,
+8.041203774e-01f,
+8.050313311e-01f,
+8.059403906e-01f,
+8.068475535e-01f,
+8.077528179e-01f,
+8.086561816e-01f,
+8.095576424e-01f,
+8.104571983e-01f,
+8.113548470e-01f,
+8.122505866e-01f,
+8.131444148e-01f,
+8.140363297e-01f,
+8.149263291e-01f,
+8.158144108e-01f,
+8.167005729e-01f,
+8.175848132e-01f,
+8.184671296e-01f,
+8.193475201e-01f,
+8.202259826e-01f,
+8.211025150e-01f,
+8.219771153e-01f,
+8.228497814e-01f,
+8.237205112e-01f,
+8.245893028e-01f,
+8.254561540e-01f,
+8.263210628e-01f,
+8.271840273e-01f,
+8.280450453e-01f,
+8.289041148e-01f,
+8.297612338e-01f,
+8.306164003e-01f,
+8.314696123e-01f,
+8.323208678e-01f,
+8.331701647e-01f,
+8.340175011e-01f,
+8.348628750e-01f,
+8.357062844e-01f,
+8.365477272e-01f,
+8.373872016e-01f,
+8.382247056e-01f,
+8.390602371e-01f,
+8.398937942e-01f,
+8.407253750e-01f,
+8.415549774e-01f,
+8.423825996e-01f,
+8.432082396e-01f,
+8.440318955e-01f,
+8.448535652e-01f,
+8.456732470e-01f,
+8.464909388e-01f,
+8.473066387e-01f,
+8.481203448e-01f,
+8.489320552e-01f,
+8.497417680e-01f,
+8.505494813e-01f,
+8.513551931e-01f,
+8.521589016e-01f,
+8.529606049e-01f,
+8.537603011e-01f,
+8.545579884e-01f,
+8.553536647e-01f,
+8.561473284e-01f,
+8.569389774e-01f,
+8.577286100e-01f,
+8.585162243e-01f,
+8.593018184e-01f,
+8.600853904e-01f,
+8.608669386e-01f,
+8.616464611e-01f,
+8.624239561e-01f,
+8.631994217e-01f,
+8.639728561e-01f,
+8.647442575e-01f,
+8.655136241e-01f,
+8.662809540e-01f,
+8.670462455e-01f,
+8.678094968e-01f,
+8.685707060e-01f,
+8.693298713e-01f,
+8.700869911e-01f,
+8.708420635e-01f,
+8.715950867e-01f,
+8.723460589e-01f,
+8.730949784e-01f,
+8.738418435e-01f,
+8.745866523e-01f,
+8.753294031e-01f,
+8.760700942e-01f,
+8.768087238e-01f,
+8.775452902e-01f,
+8.782797917e-01f,
+8.790122264e-01f,
+8.797425928e-01f,
+8.804708891e-01f,
+8.811971135e-01f,
+8.819212643e-01f,
+8.826433400e-01f,
+8.833633387e-01f,
+8.840812587e-01f,
+8.847970984e-01f,
+8.855108561e-01f,
+8.862225301e-01f,
+8.869321188e-01f,
+8.876396204e-01f,
+8.883450333e-01f,
+8.890483559e-01f,
+8.897495864e-01f,
+8.904487232e-01f,
+8.911457648e-01f,
+8.918407094e-01f,
+8.925335554e-01f,
+8.932243012e-01f,
+8.939129451e-01f,
+8.945994856e-01f,
+8.952839210e-01f,
+8.959662498e-01f,
+8.966464702e-01f,
+8.973245807e-01f,
+8.980005797e-01f,
+8.986744657e-01f,
+8.993462370e-01f,
+9.000158920e-01f,
+9.006834292e-01f,
+9.013488470e-01f,
+9.020121439e-01f,
+9.026733182e-01f,
+9.033323685e-01f,
+9.039892931e-01f,
+9.046440906e-01f,
+9.052967593e-01f,
+9.059472978e-01f,
+9.065957045e-01f,
+9.072419779e-01f,
+9.078861165e-01f,
+9.085281187e-01f,
+9.091679831e-01f,
+9.098057081e-01f,
+9.104412923e-01f,
+9.110747341e-01f,
+9.117060320e-01f,
+9.123351846e-01f,
+9.129621904e-01f,
+9.135870479e-01f,
+9.142097557e-01f,
+9.148303122e-01f,
+9.154487161e-01f,
+9.160649658e-01f,
+9.166790599e-01f,
+9.172909970e-01f,
+9.179007756e-01f,
+9.185083943e-01f,
+9.191138517e-01f,
+9.197171463e-01f,
+9.203182767e-01f,
+9.209172415e-01f,
+9.215140393e-01f,
+9.221086687e-01f,
+9.227011283e-01f,
+9.232914167e-01f,
+9.238795325e-01f,
+9.244654743e-01f,
+9.250492408e-01f,
+9.256308305e-01f,
+9.262102421e-01f,
+9.267874743e-01f,
+9.273625257e-01f,
+9.279353948e-01f,
+9.285060805e-01f,
+9.290745813e-01f,
+9.296408958e-01f,
+9.302050229e-01f,
+9.307669611e-01f,
+9.313267091e-01f,
+9.318842656e-01f,
+9.324396293e-01f,
+9.329927988e-01f,
+9.335437730e-01f,
+9.340925504e-01f,
+9.346391298e-01f,
+9.351835099e-01f,
+9.357256895e-01f,
+9.362656672e-01f,
+9.368034417e-01f,
+9.373390119e-01f,
+9.378723764e-01f,
+9.384035341e-01f,
+9.389324835e-01f,
+9.394592236e-01f,
+9.399837530e-01f,
+9.405060706e-01f,
+9.410261751e-01f,
+9.415440652e-01f,
+9.420597398e-01f,
+9.425731976e-01f,
+9.430844375e-01f,
+9.435934582e-01f,
+9.441002585e-01f,
+9.446048373e-01f,
+9.451071933e-01f,
+9.456073254e-01f,
+9.461052324e-01f,
+9.466009131e-01f,
+9.470943664e-01f,
+9.475855910e-01f,
+9.480745859e-01f,
+9.485613499e-01f,
+9.490458819e-01f,
+9.495281806e-01f,
+9.500082450e-01f,
+9.504860739e-01f,
+9.509616663e-01f,
+9.514350210e-01f,
+9.519061368e-01f,
+9.523750127e-01f,
+9.528416476e-01f,
+9.533060404e-01f,
+9.537681899e-01f,
+9.542280951e-01f,
+9.546857549e-01f,
+9.551411683e-01f,
+9.555943341e-01f,
+9.560452513e-01f,
+9.564939189e-01f,
+9.569403357e-01f,
+9.573845008e-01f,
+9.578264130e-01f,
+9.582660714e-01f,
+9.587034749e-01f,
+9.591386225e-01f,
+9.595715131e-01f,
+9.600021457e-01f,
+9.604305194e-01f,
+9.608566331e-01f,
+9.612804858e-01f,
+9.617020765e-01f,
+9.621214043e-01f,
+9.625384680e-01f,
+9.629532669e-01f,
+9.633657998e-01f,
+9.637760658e-01f,
+9.641840640e-01f,
+9.645897933e-01f,
+9.649932529e-01f,
+9.653944417e-01f,
+9.657933589e-01f,
+9.661900034e-01f,
+9.665843745e-01f,
+9.669764710e-01f,
+9.673662922e-01f,
+9.677538371e-01f,
+9.681391047e-01f,
+9.685220943e-01f,
+9.689028048e-01f,
+9.692812354e-01f,
+9.696573851e-01f,
+9.700312532e-01f,
+9.704028387e-01f,
+9.707721407e-01f,
+9.711391584e-01f,
+9.715038910e-01f,
+9.718663375e-01f,
+9.722264971e-01f,
+9.725843689e-01f,
+9.729399522e-01f,
+9.732932461e-01f,
+9.736442497e-01f,
+9.739929622e-01f,
+9.743393828e-01f,
+9.746835107e-01f,
+9.750253451e-01f,
+9.753648851e-01f,
+9.757021300e-01f,
+9.760370790e-01f,
+9.763697313e-01f,
+9.767000861e-01f,
+9.770281427e-01f,
+9.773539001e-01f,
+9.776773578e-01f,
+9.779985149e-01f,
+9.783173707e-01f,
+9.786339244e-01f,
+9.789481753e-01f,
+9.792601226e-01f,
+9.795697657e-01f,
+9.798771037e-01f,
+9.801821360e-01f,
+9.804848618e-01f,
+9.807852804e-01f,
+9.810833912e-01f,
+9.813791933e-01f,
+9.816726862e-01f,
+9.819638691e-01f,
+9.822527414e-01f,
+9.825393023e-01f,
+9.828235512e-01f,
+9.831054874e-01f,
+9.833851103e-01f,
+9.836624192e-01f,
+9.839374134e-01f,
+9.842100924e-01f,
+9.844804554e-01f,
+9.847485018e-01f,
+9.850142310e-01f,
+9.852776424e-01f,
+9.855387353e-01f,
+9.857975092e-01f,
+9.860539633e-01f,
+9.863080972e-01f,
+9.865599103e-01f,
+9.868094018e-01f,
+9.870565713e-01f,
+9.873014182e-01f,
+9.875439418e-01f,
+9.877841416e-01f,
+9.880220171e-01f,
+9.882575677e-01f,
+9.884907929e-01f,
+9.887216920e-01f,
+9.889502645e-01f,
+9.891765100e-01f,
+9.894004278e-01f,
+9.896220175e-01f,
+9.898412785e-01f,
+9.900582103e-01f,
+9.902728124e-01f,
+9.904850843e-01f,
+9.906950254e-01f,
+9.909026354e-01f,
+9.911079137e-01f,
+9.913108598e-01f,
+9.915114733e-01f,
+9.917097537e-01f,
+9.919057004e-01f,
+9.920993131e-01f,
+9.922905913e-01f,
+9.924795346e-01f,
+9.926661424e-01f,
+9.928504145e-01f,
+9.930323502e-01f,
+9.932119492e-01f,
+9.933892111e-01f,
+9.935641355e-01f,
+9.937367219e-01f,
+9.939069700e-01f,
+9.940748793e-01f,
+9.942404495e-01f,
+9.944036801e-01f,
+9.945645707e-01f,
+9.947231211e-01f,
+9.948793308e-01f,
+9.950331994e-01f,
+9.951847267e-01f,
+9.953339121e-01f,
+9.954807555e-01f,
+9.956252564e-01f,
+9.957674145e-01f,
+9.959072294e-01f,
+9.960447009e-01f,
+9.961798286e-01f,
+9.963126122e-01f,
+9.964430514e-01f,
+9.965711458e-01f,
+9.966968952e-01f,
+9.968202993e-01f,
+9.969413578e-01f,
+9.970600703e-01f,
+9.971764367e-01f,
+9.972904567e-01f,
+9.974021299e-01f,
+9.975114561e-01f,
+9.976184351e-01f,
+9.977230666e-01f,
+9.978253504e-01f,
+9.979252862e-01f,
+9.980228738e-01f,
+9.981181129e-01f,
+9.982110034e-01f,
+9.983015449e-01f,
+9.983897374e-01f,
+9.984755806e-01f,
+9.985590742e-01f,
+9.986402182e-01f,
+9.987190122e-01f,
+9.987954562e-01f,
+9.988695499e-01f,
+9.989412932e-01f,
+9.990106859e-01f,
+9.990777278e-01f,
+9.991424187e-01f,
+9.992047586e-01f,
+9.992647473e-01f,
+9.993223846e-01f,
+9.993776704e-01f,
+9.994306046e-01f,
+9.994811870e-01f,
+9.995294175e-01f,
+9.995752960e-01f,
+9.996188225e-01f,
+9.996599967e-01f,
+9.996988187e-01f,
+9.997352883e-01f,
+9.997694054e-01f,
+9.998011699e-01f,
+9.998305818e-01f,
+9.998576410e-01f,
+9.998823475e-01f,
+9.999047011e-01f,
+9.999247018e-01f,
+9.999423497e-01f,
+9.999576446e-01f,
+9.999705864e-01f,
+9.999811753e-01f,
+9.999894111e-01f,
+9.999952938e-01f,
+9.999988235e-01f,
+1.000000000e+00f,
+};
+#endif
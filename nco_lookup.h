@@ -0,0 +1,6 @@
+#include <stdint.h>
+#include "config.h"
+
+#ifdef CONFIG_NCO
+extern const float nco_sine[1025];
+#endif
@@ -0,0 +1,26 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "nco.h"
+
+int main(void)
+{
+	int i;
+	FILE *fh, *fc;
+	fh = fopen("nco_lookup.h", "w");
+	fc = fopen("nco_lookup.c", "w");
+	fprintf(fh, "#include <stdint.h>\n#include \"config.h\"\n\n");
+	fprintf(fc, "#include \"nco_lookup.h\"\n\n");
+
+	//quarter wave, the extra entry is the end point for the interpolation
+	fprintf(fh, "#ifdef CONFIG_NCO\nextern const float nco_sine[%d];\n#endif\n", NCO_TABLE_LEN + 1);
+	fprintf(fc, "#ifdef CONFIG_NCO\nconst float nco_sine[%d] = {\n", NCO_TABLE_LEN + 1);
+	for(i=0;i<=NCO_TABLE_LEN;i++) {
+		fprintf(fc, "%.9ef,\n", sin(M_PI / 2 * i / NCO_TABLE_LEN));
+	}
+	fprintf(fc, "};\n#endif\n");
+
+	fclose(fh);
+	fclose(fc);
+	return(0);
+}
@@ -0,0 +1,231 @@
+//! Line code to PCM modulator
+
+//! @file pcm.c
+
+
+#include <string.h>
+#include <math.h>
+#include "config.h"
+#if defined(CONFIG_PCM) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "pcm.h"
+#include "helper.h"
+#include "manchester.h"
+
+
+#ifdef CONFIG_PCM
+//! line code state between bytes
+typedef struct {
+	bool level;  //!< level of the last chip
+	bool last;   //!< previous data bit (miller)
+} pcm_state_t;
+
+
+//! chips per payload byte of a line code
+static uint_fast8_t pcm_chips_per_byte(bytecodec_id_t code)
+{
+	switch(code) {
+	case BYTECODEC_MANCHESTER_GE_THOMAS:
+	case BYTECODEC_MANCHESTER_IEEE802_3:
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T0:
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T1:
+	case BYTECODEC_BMC:
+	case BYTECODEC_MILLER:
+		return(16);
+	default:
+		return(8);
+	}
+}
+
+
+//! line code a byte
+
+//! @param p modulator
+//! @param st line code state, the level is not updated
+//! @param in data
+//! @return chips, first chip in bit 0
+static uint_fast16_t pcm_chips(const pcm_t *p, pcm_state_t *st, uint_fast8_t in)
+{
+	uint_fast16_t lo;
+	switch(p->code) {
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC)
+	case BYTECODEC_MANCHESTER_GE_THOMAS:
+	case BYTECODEC_MANCHESTER_IEEE802_3:
+#ifdef CONFIG_MANCHESTER_ENC_BYTE
+		lo = manchester_encode_byte(in);
+#else
+		lo = manchester_encode_nibble(LOW_NIBBLE(in)) | (manchester_encode_nibble(HIGH_NIBBLE(in)) << 8);
+#endif
+		return((p->code == BYTECODEC_MANCHESTER_IEEE802_3) ? ~lo & 0xffff : lo);
+#endif
+#if defined(CONFIG_DIFF_MANCHESTER) && defined(CONFIG_DIFF_MANCHESTER_ENC)
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T0:
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T1:
+		if(p->code == BYTECODEC_DIFFERENTIAL_MANCHESTER_T1)
+			in = ~in;
+		lo = differential_manchester_encode_nibble(st->level, in);
+		return(lo | (differential_manchester_encode_nibble(lo >> 7, HIGH_NIBBLE(in)) << 8));
+#endif
+#if defined(CONFIG_BMC) && defined(CONFIG_BMC_ENC)
+	case BYTECODEC_BMC:
+		lo = bmc_encode_nibble(st->level, in);
+		return(lo | (bmc_encode_nibble(lo >> 7, HIGH_NIBBLE(in)) << 8));
+#endif
+#ifdef CONFIG_NRZI
+	case BYTECODEC_NRZI:
+		return(nrzi_encode_byte(st->level, p->nrzs ? (uint8_t)~in : in));
+#endif
+#if defined(CONFIG_MILLER) && defined(CONFIG_MILLER_ENC)
+	case BYTECODEC_MILLER: {
+		bool level = st->level;
+		return(miller_encode_byte(&level, &st->last, in));
+	}
+#endif
+	default:
+		(void)lo;
+		return(in);
+	}
+}
+
+
+//! copy a chip template
+static void pcm_copy(uint8_t *dest, const uint8_t *src, size_t bytes)
+{
+	size_t i=0;
+#ifdef __SSE2__
+	for(;i+16<=bytes;i+=16)
+		_mm_storeu_si128((__m128i *)(dest + i), _mm_loadu_si128((const __m128i *)(src + i)));
+#endif
+	for(;i<bytes;i++)
+		dest[i] = src[i];
+}
+
+
+//! modulate a payload
+
+//! @param p modulator
+//! @param st line code state, updated
+//! @param tmpl chip templates (chip16 or chipf)
+//! @param stride bytes between the templates
+//! @param size bytes per sample
+//! @param dest output samples
+//! @param buf payload
+//! @param len length of buf
+//! @return bytes written to dest
+static size_t pcm_run(const pcm_t *p, pcm_state_t *st, const uint8_t *tmpl, size_t stride, size_t size, uint8_t *dest, const uint8_t *buf, int len)
+{
+	size_t chip_bytes = p->samples_per_chip * size;
+	uint_fast8_t n = pcm_chips_per_byte(p->code), j;
+	uint8_t *start = dest;
+	int i;
+	for(i=0;i<len;i++) {
+		uint_fast16_t chips = pcm_chips(p, st, buf[i]);
+		for(j=0;j<n;j++) {
+			bool level = chips & 1;
+			pcm_copy(dest, tmpl + ((st->level << 1) | level) * stride, chip_bytes);
+			dest += chip_bytes;
+			st->level = level;
+			chips >>= 1;
+		}
+	}
+	return(dest - start);
+}
+
+
+//! prepare a modulator
+
+//! @param p modulator
+//! @param codec line code (BYTECODEC_MANCHESTER_*, DIFFERENTIAL_MANCHESTER_*, BMC, NRZI, MILLER), others are NRZ,
+//!        opt as for bc_encode(): line level before the payload, NRZI transition on 0
+//! @param samples_per_chip samples per chip (1 - PCM_MAX_SPC)
+//! @param rise samples of a level change (0 - samples_per_chip)
+//! @param amplitude level of a 1 chip, full scale is 1.0
+//! @return 0 on success, -1 on invalid parameters
+int pcm_init(pcm_t *p, const bytecodec_t *codec, uint_fast16_t samples_per_chip, uint_fast16_t rise, float amplitude)
+{
+	uint_fast16_t k;
+	uint_fast8_t t;
+	if(!samples_per_chip || samples_per_chip > PCM_MAX_SPC || rise > samples_per_chip)
+		return(-1);
+	p->code = codec->id;
+	p->prev = codec->opt[0];
+	p->nrzs = codec->id == BYTECODEC_NRZI && codec->opt[1];
+	p->samples_per_chip = samples_per_chip;
+	p->rise = rise;
+	for(k=0;k<samples_per_chip;k++) {
+		//raised cosine from -1 to 1 over the first rise samples
+		float edge = (k < rise) ? -cosf((float)M_PI * (k + 0.5f) / rise) : 1.0f;
+		p->chipf[0][k] = -amplitude;
+		p->chipf[1][k] = amplitude * edge;
+		p->chipf[2][k] = -amplitude * edge;
+		p->chipf[3][k] = amplitude;
+		for(t=0;t<4;t++)
+			p->chip16[t][k] = (int16_t)lrintf(p->chipf[t][k] * 32767.0f);
+	}
+	return(0);
+}
+
+
+//! amount of samples of a payload
+
+//! @param p modulator
+//! @param len payload length
+long pcm_samples(const pcm_t *p, int len)
+{
+	return((long)len * pcm_chips_per_byte(p->code) * p->samples_per_chip);
+}
+
+
+//! modulate a payload to int16 samples
+
+//! @param p modulator
+//! @param dest output (pcm_samples() samples)
+//! @param buf payload
+//! @param len length of buf
+//! @return amount of samples
+long pcm_modulate_int16(const pcm_t *p, int16_t *dest, const uint8_t *buf, int len)
+{
+	pcm_state_t st = {p->prev, 1};
+	return(pcm_run(p, &st, (const uint8_t *)p->chip16[0], sizeof(p->chip16[0]), sizeof(int16_t), (uint8_t *)dest, buf, len) / sizeof(int16_t));
+}
+
+
+//! modulate a payload to float samples
+
+//! @param p modulator
+//! @param dest output (pcm_samples() samples)
+//! @param buf payload
+//! @param len length of buf
+//! @return amount of samples
+long pcm_modulate_float(const pcm_t *p, float *dest, const uint8_t *buf, int len)
+{
+	pcm_state_t st = {p->prev, 1};
+	return(pcm_run(p, &st, (const uint8_t *)p->chipf[0], sizeof(p->chipf[0]), sizeof(float), (uint8_t *)dest, buf, len) / sizeof(float));
+}
+
+
+//! modulate a payload and append it to a WAV file
+
+//! @param p modulator
+//! @param w mono WAV_INT16 or WAV_FLOAT32 writer
+//! @param buf payload
+//! @param len length of buf
+//! @return 0 on success, -1 on error
+int pcm_modulate_wav(const pcm_t *p, wav_writer_t *w, const uint8_t *buf, int len)
+{
+	uint8_t block[PCM_BLOCK];
+	pcm_state_t st = {p->prev, 1};
+	bool f = w->format == WAV_FLOAT32;
+	size_t size = f ? sizeof(float) : sizeof(int16_t);
+	int i, n = PCM_BLOCK / (pcm_chips_per_byte(p->code) * p->samples_per_chip * size);
+	if(w->num_channels != 1 || (w->format != WAV_INT16 && !f))
+		return(-1);
+	for(i=0;i<len;i+=n) {
+		size_t bytes = pcm_run(p, &st, f ? (const uint8_t *)p->chipf[0] : (const uint8_t *)p->chip16[0], f ? sizeof(p->chipf[0]) : sizeof(p->chip16[0]), size, block, buf + i, min(n, len - i));
+		if(wav_append(w, block, bytes / size))
+			return(-1);
+	}
+	return(0);
+}
+#endif //CONFIG_PCM
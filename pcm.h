@@ -0,0 +1,46 @@
+//! Line code to PCM modulator
+
+//! @file pcm.h
+//!
+//! Maps a payload through a line code straight to int16 or float samples,
+//! the chips of a byte are made in a register and expanded at once, no chip
+//! buffer is built. Every chip is samples_per_chip samples at +amplitude (1)
+//! or -amplitude (0), a level change is a raised cosine of rise samples at
+//! the start of the chip.
+//!
+//! pcm_init() renders the 4 possible chips (previous and current level) as
+//! templates, the expansion copies a template per chip, 16 bytes at a time
+//! with SSE2 when available. pcm_modulate_wav() renders blocks of
+//! PCM_BLOCK bytes and appends them to a WAV writer in bulk.
+
+#ifndef PCM_H
+#define PCM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "bytecoder.h"
+#include "make_wav.h"
+
+#define PCM_MAX_SPC 256   //!< maximum samples per chip
+#define PCM_BLOCK 32768   //!< bytes of samples per wav_append() of pcm_modulate_wav()
+
+typedef struct {
+	bytecodec_id_t code;            //!< line code, codes without a chip mapping send the bits as they are (NRZ)
+	bool prev;                      //!< line level before the payload (differential codes, NRZI, BMC, Miller)
+	bool nrzs;                      //!< NRZI with a transition on 0 (NRZ-S)
+	uint_fast16_t samples_per_chip;
+	uint_fast16_t rise;             //!< samples of a level change, 0 = hard edge
+	int16_t chip16[4][PCM_MAX_SPC]; //!< int16 chip templates, index is previous level * 2 + level
+	float chipf[4][PCM_MAX_SPC];    //!< float chip templates
+} pcm_t;
+
+#ifdef CONFIG_PCM
+int pcm_init(pcm_t *p, const bytecodec_t *codec, uint_fast16_t samples_per_chip, uint_fast16_t rise, float amplitude);
+long pcm_samples(const pcm_t *p, int len);
+long pcm_modulate_int16(const pcm_t *p, int16_t *dest, const uint8_t *buf, int len);
+long pcm_modulate_float(const pcm_t *p, float *dest, const uint8_t *buf, int len);
+int pcm_modulate_wav(const pcm_t *p, wav_writer_t *w, const uint8_t *buf, int len);
+#endif
+
+#endif
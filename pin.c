@@ -1,6 +1,66 @@
+#include <string.h>
 #include "pin.h"
 
 
+#if defined(__linux__)
+//! virtual pin of the host backend
+typedef struct {
+	const uint32_t *edges;   //!< edge log, NULL if none
+	long len;                //!< edges in the log
+	long pos;                //!< edges passed
+	double next;             //!< virtual time of edge pos
+	double cycles_per_tick;  //!< time scale of the log
+#ifdef CONFIG_WAV_MAP
+	const wav_map_t *wav;    //!< capture, NULL if none
+	uint_fast16_t channel;
+	double cycles_per_sample;
+#endif
+	uint64_t start;          //!< virtual time the source was attached
+	pin_state_t level;       //!< level of the source before its first edge
+	pin_state_t out;         //!< written level, read back if no source is attached
+} pin_host_t;
+
+static pin_host_t pin_host[PIN_AMOUNT];
+static uint64_t pin_host_now;                                 //!< virtual clock in cycles
+static uint_fast16_t pin_host_read_cost = PIN_HOST_READ_CYCLES;
+
+
+//! level of a virtual pin at the current virtual time
+static pin_state_t pin_host_level(pin_host_t *p)
+{
+#ifdef CONFIG_WAV_MAP
+	if(p->wav) {
+		uint64_t i = (uint64_t)((pin_host_now - p->start) / p->cycles_per_sample);
+		const uint8_t *s;
+		if(i >= p->wav->frames)
+			return(PIN_STATE_LOW);
+		s = p->wav->samples + (i * p->wav->channels + p->channel) * p->wav->bytes_per_sample;
+		if(p->wav->format == WAV_UINT8)
+			return(*s > 128);
+		if(p->wav->format == WAV_INT16) {
+			int16_t v;
+			memcpy(&v, s, sizeof(v)); //samples are little endian, as is the host (wav_map)
+			return(v > 0);
+		} else {
+			float v;
+			memcpy(&v, s, sizeof(v));
+			return(v > 0);
+		}
+	}
+#endif
+	if(p->edges) {
+		while(p->pos < p->len && p->next <= pin_host_now) {
+			p->pos++;
+			if(p->pos < p->len)
+				p->next += (uint32_t)(p->edges[p->pos] - p->edges[p->pos-1]) * p->cycles_per_tick;
+		}
+		return(p->level ^ (p->pos & 1));
+	}
+	return(p->out);
+}
+#endif
+
+
 pin_state_t read_pin(pin_t pin)
 {
 #if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__)
@@ -8,6 +68,9 @@ pin_state_t read_pin(pin_t pin)
 	return(READ_BIT(PIN2REG_PIN(pin), PIN2PIN(pin)));
 #elif defined(__MSP430__)
 	return(READ_BIT(PIN2REG_IN(pin), PIN2PIN(pin)));
+#elif defined(__linux__)
+	pin_host_now += pin_host_read_cost;
+	return(pin_host_level(&pin_host[pin]));
 #endif
 }
 
@@ -18,6 +81,8 @@ void write_pin(pin_t pin, pin_state_t state)
 	WRITE_BIT(PIN2REG_PORT(pin), PIN2PIN(pin), state);
 #elif defined(__MSP430__)
 	WRITE_BIT(PIN2REG_OUT(pin), PIN2PIN(pin), state);
+#elif defined(__linux__)
+	pin_host[pin].out = state;
 #endif
 }
 
@@ -28,6 +93,8 @@ void toggle_pin(pin_t pin)
 	SET_BIT(PIN2REG_PIN(pin), PIN2PIN(pin));
 #elif defined(__MSP430__)
 	PIN2REG_OUT(pin) ^= PIN2PIN(pin);
+#elif defined(__linux__)
+	pin_host[pin].out = !pin_host[pin].out;
 #endif
 }
 
@@ -57,6 +124,45 @@ void pin_interrupt_mode(pin_t pin, pin_interrupt_mode_t mode)
 	if(mode != PIN_INTERRUPT_MODE_OFF)
 		WRITE_BIT(PIN2REG_IES(pin), PIN2PIN(pin), (mode == PIN_INTERRUPT_MODE_FALLING_EDGE));
 }
+
+
+#ifdef CONFIG_EDGE
+static edge_ring_t *pin_edge_ring;
+static pin_t pin_edge_pin;
+
+
+//! capture the edges of a pin into a ring
+
+//! the port interrupt has to call pin_edge_interrupt() with a time stamp,
+//! unlike get_pulse_length() nothing waits for the pin
+//! @param pin input pin
+//! @param ring ring the time stamps are pushed to, drained with edge_ring_read() or edge_ring_decode()
+void pin_capture_edges(pin_t pin, edge_ring_t *ring)
+{
+	edge_ring_init(ring);
+	pin_edge_ring = ring;
+	pin_edge_pin = pin;
+	pin_interrupt_mode(pin, read_pin(pin) ? PIN_INTERRUPT_MODE_FALLING_EDGE : PIN_INTERRUPT_MODE_RISING_EDGE);
+}
+
+
+//! record an edge, call from the port interrupt
+
+//! the pin only interrupts on one edge, so the edge is flipped every time
+//! @param time time stamp of the edge (e.g. an extended timer count)
+void pin_edge_interrupt(uint32_t time)
+{
+	edge_ring_push(pin_edge_ring, time);
+	PIN2REG_IES(pin_edge_pin) ^= BIT(PIN2PIN(pin_edge_pin));
+	PIN2REG_IFG(pin_edge_pin) &= ~BIT(PIN2PIN(pin_edge_pin));
+}
+#endif
+#elif defined(__linux__)
+void pin_mode(pin_t pin, pin_mode_t mode)
+{
+	if(mode == PIN_MODE_INPUT_PULLUP)
+		pin_host[pin].out = PIN_STATE_HIGH;
+}
 #endif
 
 /* Measures the length (in microseconds) of a pulse on the pin; state is HIGH
@@ -104,5 +210,111 @@ uint_fast16_t get_pulse_length(pin_t pin, pin_state_t state, uint_fast16_t timeo
 	// and the start of the loop. There will be some error introduced by
 	// the interrupt handlers.
 	return(cycles_to_ms(pulsewidth * 21 + 16));
+#elif defined(__linux__)
+	// the virtual clock runs on every read_pin(), so the time is exact,
+	// the timeout is in microseconds as above (ms_to_cycles() takes microseconds)
+	uint64_t end = pin_host_now + ms_to_cycles((uint64_t)timeout), start;
+
+	while(read_pin(pin) == state) {
+		if(pin_host_now > end)
+			return(0);
+	}
+	while(read_pin(pin) != state) {
+		if(pin_host_now > end)
+			return(0);
+	}
+	start = pin_host_now;
+	while(read_pin(pin) == state) {
+		if(pin_host_now > end)
+			return(0);
+	}
+	return(cycles_to_us(pin_host_now - start));
+#endif
+}
+
+
+#if defined(__linux__)
+//! detach all virtual pins and set the virtual clock to 0
+void pin_host_reset(void)
+{
+	memset(pin_host, 0, sizeof(pin_host));
+	pin_host_now = 0;
+	pin_host_read_cost = PIN_HOST_READ_CYCLES;
+}
+
+
+//! virtual time in cycles (F_CPU per second)
+uint64_t pin_host_time(void)
+{
+	return(pin_host_now);
+}
+
+
+//! let virtual time pass
+void pin_host_delay(uint64_t cycles)
+{
+	pin_host_now += cycles;
+}
+
+
+//! set the virtual cycles a read_pin() takes
+void pin_host_read_cycles(uint_fast16_t cycles)
+{
+	pin_host_read_cost = cycles;
+}
+
+
+//! drive a virtual pin from an edge log
+
+//! the first edge is at the current virtual time
+//! @param pin virtual pin
+//! @param edges time stamps of the edges (may wrap around), NULL to detach
+//! @param len amount of edges
+//! @param level level before the first edge
+//! @param cycles_per_tick virtual cycles per tick of the log, the time scale
+//! @return 0 on success, -1 on invalid parameters
+int pin_host_edges(pin_t pin, const uint32_t *edges, long len, pin_state_t level, double cycles_per_tick)
+{
+	pin_host_t *p;
+	if(pin >= PIN_AMOUNT || len < 0 || cycles_per_tick <= 0)
+		return(-1);
+	p = &pin_host[pin];
+	p->edges = len ? edges : NULL;
+	p->len = len;
+	p->pos = 0;
+	p->next = pin_host_now;
+	p->cycles_per_tick = cycles_per_tick;
+#ifdef CONFIG_WAV_MAP
+	p->wav = NULL;
+#endif
+	p->start = pin_host_now;
+	p->level = level;
+	return(0);
+}
+
+
+#ifdef CONFIG_WAV_MAP
+//! drive a virtual pin from a capture
+
+//! the first sample is at the current virtual time, a sample above the
+//! middle (0, or 128 for 8 bit samples) is high, the pin is low after the end
+//! @param pin virtual pin
+//! @param m mapped capture, with a sample rate
+//! @param channel channel of the capture
+//! @param scale time scale, 2.0 replays the capture at half speed
+//! @return 0 on success, -1 on invalid parameters
+int pin_host_wav(pin_t pin, const wav_map_t *m, uint_fast16_t channel, double scale)
+{
+	pin_host_t *p;
+	if(pin >= PIN_AMOUNT || channel >= m->channels || !m->sample_rate || scale <= 0)
+		return(-1);
+	p = &pin_host[pin];
+	p->edges = NULL;
+	p->wav = m;
+	p->channel = channel;
+	p->cycles_per_sample = (double)F_CPU * scale / m->sample_rate;
+	p->start = pin_host_now;
+	return(0);
+}
 #endif
-}
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -1,9 +1,17 @@
 #ifndef PIN_H
 #define PIN_H
 
+#include <stdint.h>
+#include "config.h"
+#include "helper.h"
+#include "edge.h"
+#if defined(__linux__)
+#include "wav_map.h"
+#endif
+
 
 //#if !defined(__AVR__) && !defined(__GCC_AVR32__)
-#if !defined(__AVR_ATmega328P__) || !defined(__AVR_ATmega328__) || !defined(__MSP430__)
+#if !defined(__AVR_ATmega328P__) && !defined(__AVR_ATmega328__) && !defined(__MSP430__) && !defined(__linux__)
 #error unsupported platform
 #endif
 
@@ -18,6 +26,16 @@
 #define F_CPU 16000000L
 #endif
 
+//! host backend (Linux): virtual pins replay edge logs or WAV captures on a
+//! virtual clock of F_CPU cycles per second, every read_pin() takes
+//! PIN_HOST_READ_CYCLES of it, so busy waiting code runs as fast as the host can
+#if defined(__linux__)
+#ifndef F_CPU
+#define F_CPU 16000000L
+#endif
+#define PIN_HOST_READ_CYCLES 16 //!< default virtual cycles of a read_pin()
+#endif
+
 #define cycles_per_ms() ( F_CPU / 1000000L )
 #define cycles_to_us(a) ( ((a) * 1000L) / (F_CPU / 1000L) )
 #define ms_to_cycles(a) ( ((a) * (F_CPU / 1000L)) / 1000L )
@@ -42,14 +60,14 @@
 
 
 typedef enum {
-#if defined(__AVR__) || (__GCC_AVR32__)
+#if defined(__AVR__) || (__GCC_AVR32__) || defined(__linux__)
 	PIN_STATE_LOW  = 0,
 	PIN_STATE_HIGH = 1
 #endif
 } pin_state_t;
 
 
-#if defined(__AVR__) || (__GCC_AVR32__)
+#if defined(__AVR__) || (__GCC_AVR32__) || defined(__linux__)
 typedef enum {
 	PIN_MODE_OUTPUT,
 	PIN_MODE_INPUT,
@@ -188,6 +206,15 @@ typedef enum {
 	PIN_3_5 = 21,
 	PIN_3_6 = 22,
 	PIN_3_7 = 23,
+#elif defined(__linux__)
+	PIN_HOST_0 = 0,
+	PIN_HOST_1 = 1,
+	PIN_HOST_2 = 2,
+	PIN_HOST_3 = 3,
+	PIN_HOST_4 = 4,
+	PIN_HOST_5 = 5,
+	PIN_HOST_6 = 6,
+	PIN_HOST_7 = 7,
 #endif
 	PIN_AMOUNT
 } pin_t;
@@ -195,12 +222,26 @@ typedef enum {
 pin_state_t read_pin(pin_t pin);
 void write_pin(pin_t pin, pin_state_t state);
 void toggle_pin(pin_t pin);
-#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__MSP430__)
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__MSP430__) || defined(__linux__)
 void pin_mode(pin_t pin, pin_mode_t mode);
 #endif
 #if defined(__MSP430__)
 void pin_interrupt_mode(pin_t pin, pin_interrupt_mode_t mode);
+#ifdef CONFIG_EDGE
+void pin_capture_edges(pin_t pin, edge_ring_t *ring);
+void pin_edge_interrupt(uint32_t time);
+#endif
 #endif
 uint_fast16_t get_pulse_length(pin_t pin, pin_state_t state, uint_fast16_t timeout);
+#if defined(__linux__)
+void pin_host_reset(void);
+uint64_t pin_host_time(void);
+void pin_host_delay(uint64_t cycles);
+void pin_host_read_cycles(uint_fast16_t cycles);
+int pin_host_edges(pin_t pin, const uint32_t *edges, long len, pin_state_t level, double cycles_per_tick);
+#ifdef CONFIG_WAV_MAP
+int pin_host_wav(pin_t pin, const wav_map_t *m, uint_fast16_t channel, double scale);
+#endif
+#endif
 
 #endif
@@ -0,0 +1,294 @@
+//! Pipelined receive chain
+
+//! @file pipeline.c
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "config.h"
+#ifdef CONFIG_PIPELINE
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+#include "pipeline.h"
+#include "fir.h"
+#include "slicer.h"
+#include "deframer.h"
+
+
+#ifdef CONFIG_PIPELINE
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#define pipeline_acquire(x) atomic_load_explicit(&(x), memory_order_acquire)     //!< index written by the other side
+#define pipeline_relaxed(x) atomic_load_explicit(&(x), memory_order_relaxed)     //!< index written by this side
+#define pipeline_release(x, v) atomic_store_explicit(&(x), (v), memory_order_release)
+#else
+#define pipeline_barrier() __asm volatile("" ::: "memory")
+#define pipeline_acquire(x) ({ uint32_t v_ = (x); pipeline_barrier(); v_; })
+#define pipeline_relaxed(x) (x)
+#define pipeline_release(x, v) do { pipeline_barrier(); (x) = (v); } while(0)
+#endif
+
+
+//! monotonic time in ns
+static uint64_t pipeline_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+
+//! empty a queue
+static void pipeline_queue_init(pipeline_queue_t *q)
+{
+	pipeline_release(q->head, 0);
+	pipeline_release(q->tail, 0);
+}
+
+
+//! buffers in a queue
+static uint32_t pipeline_queue_count(pipeline_queue_t *q)
+{
+	return(pipeline_acquire(q->head) - pipeline_relaxed(q->tail));
+}
+
+
+//! add a buffer, producer only, a queue holds all buffers of its link so it is never full
+static void pipeline_push(pipeline_queue_t *q, uint8_t *buf, long len)
+{
+	uint32_t head = pipeline_relaxed(q->head);
+	q->buf[head & (PIPELINE_BUFS - 1)] = buf;
+	q->len[head & (PIPELINE_BUFS - 1)] = len;
+	pipeline_release(q->head, head + 1);
+}
+
+
+//! take a buffer, consumer only, waits for one
+
+//! @param q queue
+//! @param len set to the bytes in the buffer
+//! @param waits counts the waits for an empty queue
+//! @return buffer
+static uint8_t *pipeline_pop(pipeline_queue_t *q, long *len, unsigned long *waits)
+{
+	uint32_t tail = pipeline_relaxed(q->tail), spin = 0;
+	uint8_t *buf;
+	if(pipeline_acquire(q->head) == tail) {
+		(*waits)++;
+		while(pipeline_acquire(q->head) == tail) {
+			if(++spin >= PIPELINE_SPIN) {
+				sched_yield();
+				spin = 0;
+			}
+		}
+	}
+	buf = q->buf[tail & (PIPELINE_BUFS - 1)];
+	*len = q->len[tail & (PIPELINE_BUFS - 1)];
+	pipeline_release(q->tail, tail + 1);
+	return(buf);
+}
+
+
+//! empty a pipeline
+void pipeline_init(pipeline_t *p)
+{
+	memset(p, 0, sizeof(*p));
+}
+
+
+//! append a stage
+
+//! @param p pipeline
+//! @param kernel stage kernel
+//! @param ctx state given to the kernel
+//! @param out_size bytes of an output buffer, enough for the output of the largest input buffer; 0 for the sink
+//! @return index of the stage, -1 if there are PIPELINE_MAX_STAGES stages already
+int pipeline_add(pipeline_t *p, pipeline_kernel_t kernel, void *ctx, long out_size)
+{
+	pipeline_stage_t *s;
+	if(p->stages >= PIPELINE_MAX_STAGES || !kernel || out_size < 0)
+		return(-1);
+	s = &p->stage[p->stages];
+	memset(s, 0, sizeof(*s));
+	s->kernel = kernel;
+	s->ctx = ctx;
+	s->out_size = out_size;
+	s->pipeline = p;
+	s->index = p->stages;
+	return(p->stages++);
+}
+
+
+//! thread of a stage
+static void *pipeline_worker(void *arg)
+{
+	pipeline_stage_t *s = arg;
+	pipeline_t *p = s->pipeline;
+	int i = s->index;
+	bool sink = i == p->stages - 1;
+	uint8_t *in = NULL, *out = NULL;
+	long len = 0, n;
+	uint64_t t;
+	while(!pipeline_acquire(p->go))
+		sched_yield();
+	if(pipeline_relaxed(p->go) < 0)
+		return(NULL);
+	for(;;) {
+		if(i) {
+			s->fill += pipeline_queue_count(&p->full[i-1]);
+			in = pipeline_pop(&p->full[i-1], &len, &s->in_waits);
+			if(len < 0)
+				break;
+		}
+		if(!sink && !out)
+			out = pipeline_pop(&p->empty[i], &n, &s->out_waits);
+		t = pipeline_ns();
+		n = s->kernel(s->ctx, out, sink ? 0 : s->out_size, in, len);
+		s->busy_ns += pipeline_ns() - t;
+		s->blocks++;
+		if(i)
+			pipeline_push(&p->empty[i-1], in, 0);
+		if(!i && n <= 0)
+			break;
+		if(!sink && n > 0) {
+			pipeline_push(&p->full[i], out, n);
+			out = NULL;
+		}
+	}
+	//pass the end of the stream on
+	if(!sink) {
+		if(!out)
+			out = pipeline_pop(&p->empty[i], &n, &s->out_waits);
+		pipeline_push(&p->full[i], out, -1);
+	}
+	return(NULL);
+}
+
+
+//! run all stages until the source ends the stream
+
+//! the buffers are allocated here and freed when the last stage is done
+//! @param p pipeline with at least 2 stages
+//! @return 0 on success, -1 on error
+int pipeline_run(pipeline_t *p)
+{
+	pthread_t thread[PIPELINE_MAX_STAGES];
+	uint8_t *mem, *buf;
+	size_t size = 0;
+	int i, j, started, e;
+	uint64_t t;
+	if(p->stages < 2)
+		return(-1);
+	for(i=0;i<p->stages-1;i++) {
+		if(p->stage[i].out_size <= 0)
+			return(-1);
+		size += PIPELINE_BUFS * ((p->stage[i].out_size + PIPELINE_CACHE_LINE - 1) / PIPELINE_CACHE_LINE * PIPELINE_CACHE_LINE);
+	}
+	mem = aligned_alloc(PIPELINE_CACHE_LINE, size);
+	if(!mem)
+		return(-1);
+	for(i=0,buf=mem;i<p->stages-1;i++) {
+		pipeline_queue_init(&p->full[i]);
+		pipeline_queue_init(&p->empty[i]);
+		for(j=0;j<PIPELINE_BUFS;j++) {
+			pipeline_push(&p->empty[i], buf, 0);
+			buf += (p->stage[i].out_size + PIPELINE_CACHE_LINE - 1) / PIPELINE_CACHE_LINE * PIPELINE_CACHE_LINE;
+		}
+	}
+	pipeline_release(p->go, 0);
+	t = pipeline_ns();
+	for(started=0;started<p->stages;started++) {
+		p->stage[started].blocks = p->stage[started].in_waits = p->stage[started].out_waits = p->stage[started].fill = 0;
+		p->stage[started].busy_ns = 0;
+		if(pthread_create(&thread[started], NULL, pipeline_worker, &p->stage[started]))
+			break;
+	}
+	//no stage starts before all threads are there
+	e = (started < p->stages) ? -1 : 0;
+	pipeline_release(p->go, e ? -1 : 1);
+	for(i=0;i<started;i++)
+		pthread_join(thread[i], NULL);
+	p->wall_ns = pipeline_ns() - t;
+	free(mem);
+	return(e);
+}
+
+
+//! part of the last run a stage spent in its kernel (0 - 1)
+float pipeline_load(const pipeline_t *p, int stage)
+{
+	if(stage < 0 || stage >= p->stages || !p->wall_ns)
+		return(0);
+	return((float)p->stage[stage].busy_ns / p->wall_ns);
+}
+
+
+//! mean part of the input buffers of a stage which were waiting when it took one (0 - 1)
+
+//! near 1 the stage is the bottleneck, near 0 it waits for the stages before
+float pipeline_occupancy(const pipeline_t *p, int stage)
+{
+	const pipeline_stage_t *s;
+	if(stage <= 0 || stage >= p->stages)
+		return(0);
+	s = &p->stage[stage];
+	if(!s->blocks)
+		return(0);
+	return((float)s->fill / s->blocks / PIPELINE_BUFS);
+}
+
+
+#ifdef CONFIG_WAV_MAP
+//! source kernel, copies frames of a mapped WAV file, ctx is a pipeline_wav_t
+long pipeline_wav(void *ctx, uint8_t *dest, long max, const uint8_t *src, long len)
+{
+	pipeline_wav_t *w = ctx;
+	const uint8_t *samples;
+	long frame = w->m->channels * w->m->bytes_per_sample;
+	uint64_t n = wav_map_window(w->m, w->pos, max / frame, &samples);
+	(void)src;
+	(void)len;
+	memcpy(dest, samples, n * frame);
+	w->pos += n;
+	return(n * frame);
+}
+#endif
+
+
+#ifdef CONFIG_FIR
+//! filter kernel for int16 samples, ctx is a fir_t
+
+//! the output buffer needs FIR_OUT_MAX(samples, decimation) samples
+long pipeline_fir_int16(void *ctx, uint8_t *dest, long max, const uint8_t *src, long len)
+{
+	(void)max;
+	return(fir_int16(ctx, (int16_t *)dest, (const int16_t *)src, len / 2) * 2);
+}
+#endif
+
+
+#ifdef CONFIG_SLICER
+//! slicer kernel for int16 samples, ctx is a slicer_t
+
+//! the output buffer needs SLICER_OUT_MAX(samples, samples_per_chip) bytes
+long pipeline_slicer_int16(void *ctx, uint8_t *dest, long max, const uint8_t *src, long len)
+{
+	(void)max;
+	return(slicer_int16(ctx, dest, (const int16_t *)src, len / 2));
+}
+#endif
+
+
+//! sink kernel feeding a chip stream to a deframer, ctx is a deframer_t
+
+//! the line code is decoded with the frame, as the phase of the chips is
+//! only known after the sync word
+long pipeline_deframer(void *ctx, uint8_t *dest, long max, const uint8_t *src, long len)
+{
+	(void)dest;
+	(void)max;
+	deframer_push(ctx, src, len);
+	return(0);
+}
+#endif //CONFIG_PIPELINE
@@ -0,0 +1,111 @@
+//! Pipelined receive chain
+
+//! @file pipeline.h
+//!
+//! Runs the stages of a receive chain (e.g. WAV samples, FIR, slicer,
+//! deframer) on one thread each, so a single stream keeps several cores busy.
+//! Two neighbouring stages are linked by a pair of lock free single producer,
+//! single consumer queues: one carries filled buffers downstream, the other
+//! returns them to the producer once they are consumed. Every link owns
+//! PIPELINE_BUFS buffers, allocated once by pipeline_run(), nothing is
+//! allocated or copied between the stages after that.
+//!
+//! A stage which finds no free buffer waits for the next one, which holds
+//! back the stages before it (backpressure), a stage which finds no input
+//! waits for its producer. Both are counted, together with the fill of the
+//! input queue and the time spent in the kernel, so pipeline_load() and
+//! pipeline_occupancy() tell which stage limits the chain.
+//!
+//! A stage is a kernel turning len bytes at src into at most max bytes at
+//! dest. The first stage (source) gets no input and ends the stream by
+//! returning 0, the last stage (sink) gets no output buffer. A kernel which
+//! returns 0 keeps its output buffer for the next call, so kernels which
+//! collect input (e.g. the slicer between two bytes) are no special case.
+//! Ready made kernels wrap wav_map_window(), fir_int16(), slicer_int16() and
+//! deframer_push().
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "wav_map.h"
+
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define PIPELINE_ATOMIC _Atomic
+#else
+#define PIPELINE_ATOMIC volatile
+#endif
+
+#define PIPELINE_MAX_STAGES 8
+#define PIPELINE_BUFS 4          //!< buffers per link, a power of 2
+#define PIPELINE_CACHE_LINE 64   //!< buffers and queue indices do not share cache lines
+#define PIPELINE_SPIN 64         //!< polls of an empty queue before the thread yields
+
+//! stage kernel
+
+//! @param ctx state of the stage
+//! @param dest output buffer, NULL for the sink
+//! @param max size of dest
+//! @param src input, NULL for the source
+//! @param len bytes at src
+//! @return bytes written to dest, the source ends the stream with 0
+typedef long (*pipeline_kernel_t)(void *ctx, uint8_t *dest, long max, const uint8_t *src, long len);
+
+typedef struct {
+	PIPELINE_ATOMIC uint32_t head;  //!< producer only
+	uint8_t pad0[PIPELINE_CACHE_LINE - sizeof(uint32_t)];
+	PIPELINE_ATOMIC uint32_t tail;  //!< consumer only
+	uint8_t pad1[PIPELINE_CACHE_LINE - sizeof(uint32_t)];
+	uint8_t *buf[PIPELINE_BUFS];
+	long len[PIPELINE_BUFS];        //!< bytes in buf, -1 ends the stream
+} pipeline_queue_t;
+
+typedef struct {
+	pipeline_kernel_t kernel;
+	void *ctx;
+	long out_size;                  //!< bytes of an output buffer, 0 for the sink
+	void *pipeline;                 //!< set by pipeline_add()
+	int index;
+	unsigned long blocks;           //!< kernel calls with input (or output for the source)
+	unsigned long in_waits;         //!< times the stage found no input
+	unsigned long out_waits;        //!< times the stage found no free buffer (backpressure)
+	unsigned long fill;             //!< sum of the buffers waiting in the input queue at every block
+	uint64_t busy_ns;               //!< time spent in the kernel
+} pipeline_stage_t;
+
+typedef struct {
+	pipeline_stage_t stage[PIPELINE_MAX_STAGES];
+	pipeline_queue_t full[PIPELINE_MAX_STAGES - 1];  //!< from stage i to stage i+1
+	pipeline_queue_t empty[PIPELINE_MAX_STAGES - 1]; //!< back from stage i+1 to stage i
+	int stages;
+	PIPELINE_ATOMIC int go;         //!< 0 while the threads are started, 1 to run, -1 to give up
+	uint64_t wall_ns;               //!< duration of the last pipeline_run()
+} pipeline_t;
+
+typedef struct {
+	const wav_map_t *m;
+	uint64_t pos;                   //!< next frame
+} pipeline_wav_t;
+
+#ifdef CONFIG_PIPELINE
+void pipeline_init(pipeline_t *p);
+int pipeline_add(pipeline_t *p, pipeline_kernel_t kernel, void *ctx, long out_size);
+int pipeline_run(pipeline_t *p);
+float pipeline_load(const pipeline_t *p, int stage);
+float pipeline_occupancy(const pipeline_t *p, int stage);
+#ifdef CONFIG_WAV_MAP
+long pipeline_wav(void *ctx, uint8_t *dest, long max, const uint8_t *src, long len);
+#endif
+#ifdef CONFIG_FIR
+long pipeline_fir_int16(void *ctx, uint8_t *dest, long max, const uint8_t *src, long len);
+#endif
+#ifdef CONFIG_SLICER
+long pipeline_slicer_int16(void *ctx, uint8_t *dest, long max, const uint8_t *src, long len);
+#endif
+long pipeline_deframer(void *ctx, uint8_t *dest, long max, const uint8_t *src, long len);
+#endif
+
+#endif
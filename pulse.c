@@ -0,0 +1,177 @@
+//! Pulse width Manchester and BMC decoder
+
+//! @file pulse.c
+
+
+#include "config.h"
+#include "pulse.h"
+
+
+#ifdef CONFIG_PULSE
+#define PULSE_MAX_CHIP (1UL << 28) //!< longest chip in 1/16 ticks, the thresholds stay within 32 bits
+
+
+//! prepare a decoder
+
+//! @param p decoder
+//! @param code BYTECODEC_MANCHESTER_GE_THOMAS, BYTECODEC_MANCHESTER_IEEE802_3 or BYTECODEC_BMC
+//! @param chip_ticks nominal chip (half bit) duration in ticks
+//! @param level level of the first pulse (Manchester)
+//! @return 0 on success, -1 on invalid parameters
+int pulse_init(pulse_t *p, bytecodec_id_t code, uint32_t chip_ticks, bool level)
+{
+	if(code != BYTECODEC_MANCHESTER_GE_THOMAS && code != BYTECODEC_MANCHESTER_IEEE802_3 && code != BYTECODEC_BMC)
+		return(-1);
+	if(!chip_ticks || chip_ticks >= (PULSE_MAX_CHIP >> PULSE_FRAC_BITS))
+		return(-1);
+	p->code = code;
+	p->chip = chip_ticks << PULSE_FRAC_BITS;
+	p->edge = 0;
+	p->started = false;
+	p->level = level;
+	p->synced = true;
+	p->pending = -1;
+	p->byte = 0;
+	p->bits = 0;
+	p->errors = 0;
+	return(0);
+}
+
+
+//! drop the incomplete byte and wait for the next long pulse
+static void pulse_resync(pulse_t *p, bool error)
+{
+	p->synced = false;
+	p->pending = -1;
+	p->byte = 0;
+	p->bits = 0;
+	if(error)
+		p->errors++;
+}
+
+
+//! decode a pulse
+
+//! @param p decoder
+//! @param dest output, gets a byte when one is complete
+//! @param d duration in ticks
+//! @return amount of complete bytes (0 or 1)
+static uint_fast8_t pulse_one(pulse_t *p, uint8_t *dest, uint32_t d)
+{
+	bool level = p->level, bmc = p->code == BYTECODEC_BMC;
+	uint_fast8_t k, i, out=0;
+	int_fast8_t c0;
+	uint32_t d16;
+	p->level = !level;
+	if(d >= (PULSE_MAX_CHIP >> PULSE_FRAC_BITS)) {
+		pulse_resync(p, false);
+		return(0);
+	}
+	d16 = d << PULSE_FRAC_BITS;
+	if(d16 >= 2 * p->chip + p->chip / 2) {
+		pulse_resync(p, false); //gap
+		return(0);
+	}
+	if(d16 < p->chip / 2) {
+		pulse_resync(p, true); //glitch
+		return(0);
+	}
+	k = (d16 < p->chip + p->chip / 2) ? 1 : 2;
+	//follow the chip duration
+	p->chip += ((int32_t)(d16 / k) - (int32_t)p->chip) / 8;
+	if(!p->synced) {
+		if(k == 1)
+			return(0);
+		//a long pulse holds a bit boundary (Manchester) or is a whole 0 bit (BMC)
+		p->synced = true;
+		if(!bmc) {
+			p->pending = level;
+			return(0);
+		}
+	}
+	//BMC changes the level at every bit boundary
+	if(bmc && k == 2 && p->pending >= 0) {
+		pulse_resync(p, true);
+		return(0);
+	}
+	for(i=0;i<k;i++) {
+		if(p->pending < 0) {
+			p->pending = level;
+			continue;
+		}
+		c0 = p->pending;
+		p->pending = -1;
+		if(!bmc && c0 == level) {
+			pulse_resync(p, true);
+			return(out);
+		}
+		if(bmc)
+			p->byte |= (c0 ^ level) << p->bits;
+		else if(p->code == BYTECODEC_MANCHESTER_GE_THOMAS)
+			p->byte |= c0 << p->bits;
+		else
+			p->byte |= !c0 << p->bits;
+		if(++p->bits == 8) {
+			dest[out++] = p->byte;
+			p->byte = 0;
+			p->bits = 0;
+		}
+	}
+	return(out);
+}
+
+
+//! decode pulse durations
+
+//! @param p decoder, the state is kept between calls
+//! @param dest output, up to PULSE_OUT_MAX(len) bytes
+//! @param durations time between two edges in ticks
+//! @param len amount of durations
+//! @return amount of complete bytes
+long pulse_decode(pulse_t *p, uint8_t *dest, const uint32_t *durations, long len)
+{
+	long i, out = 0;
+	for(i=0;i<len;i++)
+		out += pulse_one(p, dest + out, durations[i]);
+	return(out);
+}
+
+
+//! decode edge time stamps
+
+//! the first edge ever only starts the first pulse
+//! @param p decoder, the state is kept between calls
+//! @param dest output, up to PULSE_OUT_MAX(len) bytes
+//! @param edges time stamps of the edges in ticks
+//! @param len amount of edges
+//! @return amount of complete bytes
+long pulse_decode_edges(pulse_t *p, uint8_t *dest, const uint32_t *edges, long len)
+{
+	long i = 0, out = 0;
+	if(len > 0 && !p->started) {
+		p->edge = edges[i++];
+		p->started = true;
+	}
+	for(;i<len;i++) {
+		out += pulse_one(p, dest + out, edges[i] - p->edge);
+		p->edge = edges[i];
+	}
+	return(out);
+}
+
+
+//! skip edges which were not captured
+
+//! the level follows the lost edges and the next one, which only starts
+//! a pulse, the decoder synchronizes again
+//! @param p decoder
+//! @param edges amount of lost edges
+void pulse_lost(pulse_t *p, unsigned long edges)
+{
+	if(!edges)
+		return;
+	p->level ^= (edges + 1) & 1;
+	p->started = false;
+	pulse_resync(p, true);
+}
+#endif //CONFIG_PULSE
@@ -0,0 +1,52 @@
+//! Pulse width Manchester and BMC decoder
+
+//! @file pulse.h
+//!
+//! Decodes from the durations between edges, as given by a timer capture or
+//! an edge log, without sampling the line onto a grid first. Every pulse is
+//! one chip (short) or two chips (long) of the same level, the chips are
+//! paired into bits as they come.
+//!
+//! The chip duration starts at the nominal value and follows the measured
+//! pulses (1/8 of the difference per pulse, in 1/16 ticks), the thresholds
+//! are 1.5 and 2.5 chips. A pulse shorter than half a chip, or a pair which
+//! is not valid for the code, is an error, a pulse longer than 2.5 chips is
+//! a gap (end of frame or idle line). Both drop the incomplete byte and the
+//! decoder synchronizes again at the next long pulse, which is at a known
+//! position in the bit for Manchester and BMC.
+//!
+//! The first pulse has to start at a bit boundary. Time stamps may wrap
+//! around, the difference of two uint32_t is the duration anyway.
+
+#ifndef PULSE_H
+#define PULSE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "bytecoder.h"
+
+#define PULSE_FRAC_BITS 4 //!< fraction bits of the chip duration, pulses up to 2^27 ticks
+#define PULSE_OUT_MAX(len) ((len) / 8 + 1) //!< maximum bytes of len pulses
+
+typedef struct {
+	bytecodec_id_t code;     //!< BYTECODEC_MANCHESTER_GE_THOMAS, BYTECODEC_MANCHESTER_IEEE802_3 or BYTECODEC_BMC
+	uint32_t chip;           //!< chip duration in 1/16 ticks
+	uint32_t edge;           //!< time stamp of the last edge
+	bool started;            //!< edge is valid
+	bool level;              //!< level of the next pulse
+	bool synced;
+	int_fast8_t pending;     //!< first chip of the bit, -1 if none
+	uint8_t byte;            //!< bits of an incomplete byte
+	uint_fast8_t bits;       //!< bits in byte
+	unsigned long errors;    //!< invalid pulses and pairs
+} pulse_t;
+
+#ifdef CONFIG_PULSE
+int pulse_init(pulse_t *p, bytecodec_id_t code, uint32_t chip_ticks, bool level);
+long pulse_decode(pulse_t *p, uint8_t *dest, const uint32_t *durations, long len);
+long pulse_decode_edges(pulse_t *p, uint8_t *dest, const uint32_t *edges, long len);
+void pulse_lost(pulse_t *p, unsigned long edges);
+#endif
+
+#endif
@@ -0,0 +1,549 @@
+//! Scatter-gather line coding
+
+//! @file sg.c
+
+
+#include <string.h>
+#include "config.h"
+#include "helper.h"
+#include "sg.h"
+#include "manchester.h"
+#include "crc.h"
+
+
+#ifdef CONFIG_SG
+//! state of a line code between segments
+typedef struct {
+	const bytecodec_t *codec;
+	bool prev;               //!< level of the last chip
+	bool last;               //!< last data bit (miller)
+} sg_line_t;
+
+//! place in a segment list
+typedef struct {
+	int seg;
+	int pos;
+} sg_pos_t;
+
+
+static void sg_line_init(sg_line_t *l, const bytecodec_t *codec)
+{
+	l->codec = codec;
+	l->prev = codec->opt[0];
+	l->last = 1;
+}
+
+
+static void sg_invert(uint8_t *dest, const uint8_t *buf, int len)
+{
+	int i;
+	for(i=0;i<len;i++)
+		dest[i] = ~buf[i];
+}
+
+
+//! chips per data byte of a line code
+
+//! @return 2 (1 for NRZI), 0 if the codec is no line code or not configured for both directions
+int sg_ratio(const bytecodec_t *codec)
+{
+	switch(codec->id) {
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC) && defined(CONFIG_MANCHESTER_DEC)
+	case BYTECODEC_MANCHESTER_GE_THOMAS:
+	case BYTECODEC_MANCHESTER_IEEE802_3:
+		return(2);
+#endif
+#if defined(CONFIG_DIFF_MANCHESTER) && defined(CONFIG_DIFF_MANCHESTER_ENC) && defined(CONFIG_DIFF_MANCHESTER_DEC)
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T0:
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T1:
+		return(2);
+#endif
+#if defined(CONFIG_BMC) && defined(CONFIG_BMC_ENC) && defined(CONFIG_BMC_DEC)
+	case BYTECODEC_BMC:
+		return(2);
+#endif
+#ifdef CONFIG_NRZI
+	case BYTECODEC_NRZI:
+		return(1);
+#endif
+#if defined(CONFIG_MILLER) && defined(CONFIG_MILLER_ENC) && defined(CONFIG_MILLER_DEC)
+	case BYTECODEC_MILLER:
+		return(2);
+#endif
+	default:
+		return(0);
+	}
+}
+
+
+//! encode a piece of a segment, dest needs sg_ratio() * len bytes
+static void sg_encode_block(sg_line_t *l, uint8_t *dest, const uint8_t *buf, int len)
+{
+	uint8_t tmp[SG_BLOCK];
+	uint_fast16_t w;
+	int i, n;
+	switch(l->codec->id) {
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC) && defined(CONFIG_MANCHESTER_DEC)
+	case BYTECODEC_MANCHESTER_GE_THOMAS:
+		manchester_encode_to(dest, buf, len);
+		break;
+	case BYTECODEC_MANCHESTER_IEEE802_3:
+		manchester_encode_to(dest, buf, len);
+		sg_invert(dest, dest, len << 1);
+		break;
+#endif
+#if defined(CONFIG_DIFF_MANCHESTER) && defined(CONFIG_DIFF_MANCHESTER_ENC) && defined(CONFIG_DIFF_MANCHESTER_DEC)
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T0:
+		differential_manchester_encode_buf(dest, l->prev, buf, len);
+		l->prev = dest[(len << 1) - 1] >> 7;
+		break;
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T1:
+		for(i=0;i<len;i+=n) {
+			n = min(len - i, SG_BLOCK);
+			sg_invert(tmp, buf + i, n);
+			differential_manchester_encode_buf(dest + (i << 1), l->prev, tmp, n);
+			l->prev = dest[((i + n) << 1) - 1] >> 7;
+		}
+		break;
+#endif
+#if defined(CONFIG_BMC) && defined(CONFIG_BMC_ENC) && defined(CONFIG_BMC_DEC)
+	case BYTECODEC_BMC:
+		bmc_encode_buf(dest, l->prev, buf, len);
+		l->prev = dest[(len << 1) - 1] >> 7;
+		break;
+#endif
+#ifdef CONFIG_NRZI
+	case BYTECODEC_NRZI:
+		if(l->codec->opt[1])
+			sg_invert(dest, buf, len);
+		else
+			memcpy(dest, buf, len);
+		l->prev = nrzi_encode_buf(l->prev, dest, len);
+		break;
+#endif
+#if defined(CONFIG_MILLER) && defined(CONFIG_MILLER_ENC) && defined(CONFIG_MILLER_DEC)
+	case BYTECODEC_MILLER:
+		for(i=0;i<len;i++) {
+			w = miller_encode_byte(&l->prev, &l->last, buf[i]);
+			dest[i<<1] = LOW_BYTE(w);
+			dest[(i<<1)+1] = HIGH_BYTE(w);
+		}
+		break;
+#endif
+	default:
+		break;
+	}
+	(void)tmp;
+	(void)w;
+	(void)n;
+}
+
+
+//! decode a block of up to SG_BLOCK chips in place
+
+//! @return length of the data, or -1 on invalid chips
+static int sg_decode_block(sg_line_t *l, uint8_t *buf, int len)
+{
+	uint8_t chips[SG_BLOCK];
+	uint_fast16_t w;
+	bool next;
+	int i;
+	if(sg_ratio(l->codec) == 2 && (len & 1))
+		return(-1);
+	next = len ? buf[len-1] >> 7 : l->prev;
+	switch(l->codec->id) {
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC) && defined(CONFIG_MANCHESTER_DEC)
+	case BYTECODEC_MANCHESTER_GE_THOMAS:
+	case BYTECODEC_MANCHESTER_IEEE802_3:
+		if(l->codec->id == BYTECODEC_MANCHESTER_IEEE802_3)
+			sg_invert(buf, buf, len);
+#ifdef CONFIG_MANCHESTER_ERROR_DETECTOR
+		if(!manchester_check_buf(buf, len))
+			return(-1);
+#endif
+		if(manchester_decode_buf(buf, len))
+			return(-1);
+		return(len >> 1);
+#endif
+#if defined(CONFIG_DIFF_MANCHESTER) && defined(CONFIG_DIFF_MANCHESTER_ENC) && defined(CONFIG_DIFF_MANCHESTER_DEC)
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T0:
+	case BYTECODEC_DIFFERENTIAL_MANCHESTER_T1:
+#ifdef CONFIG_MANCHESTER_ERROR_DETECTOR
+		if(!manchester_check_buf(buf, len))
+			return(-1);
+#endif
+		differential_manchester_decode_buf(l->prev, buf, len);
+		if(l->codec->id == BYTECODEC_DIFFERENTIAL_MANCHESTER_T1)
+			sg_invert(buf, buf, len >> 1);
+		l->prev = next;
+		return(len >> 1);
+#endif
+#if defined(CONFIG_BMC) && defined(CONFIG_BMC_ENC) && defined(CONFIG_BMC_DEC)
+	case BYTECODEC_BMC:
+#ifdef CONFIG_BMC_ERROR_DETECTOR
+		if(!bmc_check_buf(l->prev, buf, len))
+			return(-1);
+#endif
+		bmc_decode_buf(buf, len);
+		l->prev = next;
+		return(len >> 1);
+#endif
+#ifdef CONFIG_NRZI
+	case BYTECODEC_NRZI:
+		l->prev = nrzi_decode_buf(l->prev, buf, len);
+		if(l->codec->opt[1])
+			sg_invert(buf, buf, len);
+		return(len);
+#endif
+#if defined(CONFIG_MILLER) && defined(CONFIG_MILLER_ENC) && defined(CONFIG_MILLER_DEC)
+	case BYTECODEC_MILLER:
+		//the check of miller_decode_buf() starts a new sequence, check here with the state
+		memcpy(chips, buf, len);
+		miller_decode_buf(l->prev, buf, len);
+		for(i=0;i<(len>>1);i++) {
+			w = miller_encode_byte(&l->prev, &l->last, buf[i]);
+			if(LOW_BYTE(w) != chips[i<<1] || HIGH_BYTE(w) != chips[(i<<1)+1])
+				return(-1);
+		}
+		return(len >> 1);
+#endif
+	default:
+		(void)chips;
+		(void)w;
+		(void)i;
+		(void)next;
+		return(-1);
+	}
+}
+
+
+//! copy up to max bytes from a segment list, moving on
+static int sg_get(const sg_in_t *src, int nsrc, sg_pos_t *in, uint8_t *buf, int max)
+{
+	int n = 0, k;
+	while(n < max && in->seg < nsrc) {
+		k = min(max - n, src[in->seg].len - in->pos);
+		memcpy(buf + n, src[in->seg].buf + in->pos, k);
+		n += k;
+		in->pos += k;
+		if(in->pos >= src[in->seg].len) {
+			in->seg++;
+			in->pos = 0;
+		}
+	}
+	return(n);
+}
+
+
+//! copy bytes into a segment list, moving on
+
+//! @return 0 on success, -1 if the segments are full
+static int sg_put(const sg_out_t *dest, int ndest, sg_pos_t *out, const uint8_t *buf, int len)
+{
+	int k;
+	while(len > 0) {
+		if(out->seg >= ndest)
+			return(-1);
+		k = min(len, dest[out->seg].len - out->pos);
+		memcpy(dest[out->seg].buf + out->pos, buf, k);
+		buf += k;
+		len -= k;
+		out->pos += k;
+		if(out->pos >= dest[out->seg].len) {
+			out->seg++;
+			out->pos = 0;
+		}
+	}
+	return(0);
+}
+
+
+//! copy a segment list into one buffer
+
+//! @return length of the data
+int sg_gather(uint8_t *dest, const sg_in_t *src, int nsrc)
+{
+	int i, len = 0;
+	for(i=0;i<nsrc;i++) {
+		memcpy(dest + len, src[i].buf, src[i].len);
+		len += src[i].len;
+	}
+	return(len);
+}
+
+
+//! encode a segment list with a line code
+
+//! a single output buffer is a list of one segment
+//! @param codec line code, see sg_ratio()
+//! @param dest output segments
+//! @param ndest amount of output segments
+//! @param src input segments
+//! @param nsrc amount of input segments
+//! @return length of output data, or -1 if the output is too small or the codec no line code
+int sg_encode(const bytecodec_t *codec, const sg_out_t *dest, int ndest, const sg_in_t *src, int nsrc)
+{
+	int ratio = sg_ratio(codec), i, n, room, len, total = 0;
+	sg_pos_t out = {0, 0};
+	const uint8_t *buf;
+	uint8_t tmp[2];
+	sg_line_t l;
+	if(!ratio)
+		return(-1);
+	sg_line_init(&l, codec);
+	for(i=0;i<nsrc;i++) {
+		buf = src[i].buf;
+		len = src[i].len;
+		while(len > 0) {
+			while(out.seg < ndest && out.pos >= dest[out.seg].len) {
+				out.seg++;
+				out.pos = 0;
+			}
+			if(out.seg >= ndest)
+				return(-1);
+			room = (dest[out.seg].len - out.pos) / ratio;
+			if(room) {
+				n = min(len, room);
+				sg_encode_block(&l, dest[out.seg].buf + out.pos, buf, n);
+				out.pos += n * ratio;
+			} else {
+				//the chips of this byte are split between two output segments
+				n = 1;
+				sg_encode_block(&l, tmp, buf, 1);
+				if(sg_put(dest, ndest, &out, tmp, ratio))
+					return(-1);
+			}
+			buf += n;
+			len -= n;
+			total += n * ratio;
+		}
+	}
+	return(total);
+}
+
+
+//! decode a segment list from a place in it
+static int sg_decode_from(const bytecodec_t *codec, const sg_out_t *dest, int ndest, const sg_in_t *src, int nsrc, sg_pos_t in)
+{
+	uint8_t tmp[SG_BLOCK];
+	sg_pos_t out = {0, 0};
+	sg_line_t l;
+	int n, total = 0;
+	if(!sg_ratio(codec))
+		return(-1);
+	sg_line_init(&l, codec);
+	while((n = sg_get(src, nsrc, &in, tmp, SG_BLOCK)) > 0) {
+		n = sg_decode_block(&l, tmp, n);
+		if(n < 0 || sg_put(dest, ndest, &out, tmp, n))
+			return(-1);
+		total += n;
+	}
+	return(total);
+}
+
+
+//! decode a segment list with a line code
+
+//! the chips of a data byte may be split between two input segments
+//! @param codec line code, see sg_ratio()
+//! @param dest output segments
+//! @param ndest amount of output segments
+//! @param src input segments
+//! @param nsrc amount of input segments
+//! @return length of output data, or -1 on invalid chips, if the output is too small or the codec no line code
+int sg_decode(const bytecodec_t *codec, const sg_out_t *dest, int ndest, const sg_in_t *src, int nsrc)
+{
+	sg_pos_t in = {0, 0};
+	return(sg_decode_from(codec, dest, ndest, src, nsrc, in));
+}
+
+
+//! add a segment of the extra bytes to a segment list
+
+//! @return the segment data, NULL if there is no room
+static uint8_t *sg_insert(sg_in_t *seg, int *n, int at, uint8_t *extra, int *used, int len)
+{
+	uint8_t *buf = extra + *used;
+	if(*n >= SG_MAX_SEGS || *used + len > SG_EXTRA)
+		return(NULL);
+	memmove(&seg[at+1], &seg[at], (*n - at) * sizeof(*seg));
+	seg[at].buf = buf;
+	seg[at].len = len;
+	(*n)++;
+	*used += len;
+	return(buf);
+}
+
+
+//! run a codec on a segment list by adding segments
+
+//! @return length of output data, -1 if the codec needs the frame in one buffer
+static int sg_chain_step(const bytecodec_t *codec, sg_in_t *seg, int *n, uint8_t *extra, int *used, int len)
+{
+	uint_fast16_t crc;
+	uint8_t *buf;
+	int i, off;
+	switch(codec->id) {
+	case BYTECODEC_ABORT:
+		return(len);
+	case BYTECODEC_CRC8:
+		crc = codec->opt[1];
+		for(i=0;i<*n;i++)
+			crc = crc8_update(crc, codec->opt[0] ? codec->opt[0] : CRC8_POLY, seg[i].buf, seg[i].len);
+		if(!(buf = sg_insert(seg, n, *n, extra, used, 1)))
+			return(-1);
+		buf[0] = crc;
+		return(len + 1);
+	case BYTECODEC_CRC16:
+		crc = codec->opt[1];
+		for(i=0;i<*n;i++)
+			crc = crc16_update(crc, codec->opt[0] ? codec->opt[0] : CRC16_POLY, seg[i].buf, seg[i].len);
+		if(!(buf = sg_insert(seg, n, *n, extra, used, 2)))
+			return(-1);
+		buf[0] = HIGH_BYTE(crc);
+		buf[1] = LOW_BYTE(crc);
+		return(len + 2);
+	case BYTECODEC_ENCODED_LENGTH:
+		if(len < (int)codec->opt[0] || *n + 2 > SG_MAX_SEGS)
+			return(-1);
+		//the length has to fit into the field, bc_encode() fails then as well
+		i = bc_len_field_bytes(codec);
+		if(i < (int)sizeof(int) && ((len - (int)codec->opt[0]) >> (i << 3)))
+			return(-1);
+		//find the segment the field goes into, split it there
+		off = codec->opt[0];
+		for(i=0;i<*n && off && off >= seg[i].len;i++)
+			off -= seg[i].len;
+		if(off) {
+			memmove(&seg[i+1], &seg[i], (*n - i) * sizeof(*seg));
+			(*n)++;
+			seg[i].len = off;
+			seg[i+1].buf += off;
+			seg[i+1].len -= off;
+			i++;
+		}
+		if(!(buf = sg_insert(seg, n, i, extra, used, bc_len_field_bytes(codec))))
+			return(-1);
+#ifdef CONFIG_BYTECODER_BIGLEN
+		bc_encode_len(buf, len, len - codec->opt[0], 0, bc_len_field_bytes(codec), codec->opt[2]);
+#else
+		bc_encode_len(buf, len, len - codec->opt[0], 0);
+#endif
+		return(len + bc_len_field_bytes(codec));
+	case BYTECODEC_SYNC_WORD:
+		if(!(buf = sg_insert(seg, n, 0, extra, used, codec->opt[1])))
+			return(-1);
+		for(i=0;i<(int)codec->opt[1];i++)
+			buf[i] = READ_BYTE(codec->opt[0], codec->opt[1]-i-1);
+		return(len + codec->opt[1]);
+	case BYTECODEC_PREAMBLE:
+		if(!(buf = sg_insert(seg, n, 0, extra, used, codec->opt[1])))
+			return(-1);
+		memset(buf, codec->opt[0], codec->opt[1]);
+		return(len + codec->opt[1]);
+	default:
+		return(-1);
+	}
+}
+
+
+//! amount of bytes SYNC_WORD and PREAMBLE codecs put in front
+
+//! @return bytes, -1 if there is another codec
+static int sg_chain_prefix(const bytecodec_t *codec, int amount)
+{
+	int i, len = 0;
+	for(i=0;i<amount;i++) {
+		if(codec[i].id != BYTECODEC_SYNC_WORD && codec[i].id != BYTECODEC_PREAMBLE)
+			return(-1);
+		len += codec[i].opt[1];
+	}
+	return(len);
+}
+
+
+//! encode a segment list with a chain of codecs
+
+//! gives the same output as bc_encode_chain() on the concatenated segments
+//! @param codec_chain chain
+//! @param buf output data (needs to be codec_chain->enc_buf_len), no segment may point into it
+//! @param src input segments
+//! @param nsrc amount of input segments
+//! @return length of output data, or -1 on error
+int sg_encode_chain(const bytecodec_chain_t *codec_chain, uint8_t *buf, const sg_in_t *src, int nsrc)
+{
+	const bytecodec_t *codec = codec_chain->codec;
+	int amount = bc_chain_amount(codec_chain);
+	sg_in_t seg[SG_MAX_SEGS];
+	uint8_t extra[SG_EXTRA];
+	sg_out_t out;
+	int i, j, k, b, n = nsrc, used = 0, len = 0, pre, step;
+	if(nsrc > SG_MAX_SEGS)
+		return(bc_encode_chain(codec_chain, buf, sg_gather(buf, src, nsrc)));
+	memcpy(seg, src, nsrc * sizeof(*seg));
+	for(i=0;i<nsrc;i++)
+		len += src[i].len;
+	for(i=0;i<amount;i++) {
+		if(sg_ratio(&codec[i])) {
+			//write the line code behind the SYNC_WORD and PREAMBLE codecs after it
+			pre = sg_chain_prefix(codec + i + 1, amount - i - 1);
+			out.buf = buf + max(pre, 0);
+			out.len = len * sg_ratio(&codec[i]);
+			len = sg_encode(&codec[i], &out, 1, seg, n);
+			if(len < 0)
+				return(-1);
+			if(pre < 0)
+				return(bc_encode_codecs(codec + i + 1, amount - i - 1, buf, len));
+			for(j=amount-1,k=0;j>i;j--) {
+				if(codec[j].id == BYTECODEC_PREAMBLE) {
+					memset(buf + k, codec[j].opt[0], codec[j].opt[1]);
+					k += codec[j].opt[1];
+				} else {
+					for(b=0;b<(int)codec[j].opt[1];b++)
+						buf[k++] = READ_BYTE(codec[j].opt[0], codec[j].opt[1]-b-1);
+				}
+			}
+			return(pre + len);
+		}
+		step = sg_chain_step(&codec[i], seg, &n, extra, &used, len);
+		if(step < 0)
+			break;
+		len = step;
+	}
+	//the rest of the chain needs the frame in one buffer
+	return(bc_encode_codecs(codec + i, amount - i, buf, sg_gather(buf, seg, n)));
+}
+
+
+//! decode a segment list with a chain of codecs
+
+//! gives the same output as bc_decode_chain() on the concatenated segments
+//! @param codec_chain chain
+//! @param buf output data (needs to be codec_chain->dec_buf_len), no segment may point into it
+//! @param src input segments
+//! @param nsrc amount of input segments
+//! @return length of output data, or -1 on error
+int sg_decode_chain(const bytecodec_chain_t *codec_chain, uint8_t *buf, const sg_in_t *src, int nsrc)
+{
+	const bytecodec_t *codec = codec_chain->codec;
+	int amount = bc_chain_amount(codec_chain);
+	uint8_t tmp[SG_BLOCK];
+	sg_pos_t in = {0, 0};
+	sg_out_t out;
+	int i, pre, len;
+	for(i=amount-1;i>=0 && (codec[i].id == BYTECODEC_SYNC_WORD || codec[i].id == BYTECODEC_PREAMBLE);i--);
+	pre = sg_chain_prefix(codec + i + 1, amount - i - 1);
+	//reed solomon takes the invalid manchester bytes as erasures in bc_decode_codecs()
+	if(i < 0 || !sg_ratio(&codec[i]) || pre > SG_BLOCK || (i > 0 && codec[i-1].id == BYTECODEC_REED_SOLOMON))
+		return(bc_decode_chain(codec_chain, buf, sg_gather(buf, src, nsrc)));
+	//check and skip the SYNC_WORD and PREAMBLE in front
+	if(sg_get(src, nsrc, &in, tmp, pre) != pre || bc_decode_codecs(codec + i + 1, amount - i - 1, tmp, pre) != 0)
+		return(-1);
+	out.buf = buf;
+	out.len = codec_chain->dec_buf_len;
+	len = sg_decode_from(&codec[i], &out, 1, src, nsrc, in);
+	if(len < 0)
+		return(-1);
+	return(bc_decode_codecs(codec, i, buf, len));
+}
+#endif //CONFIG_SG
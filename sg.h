@@ -0,0 +1,59 @@
+//! Scatter-gather line coding
+
+//! @file sg.h
+//!
+//! A frame is often a header, a payload owned by the application and a
+//! trailer, in three places. Instead of copying them into one buffer before
+//! coding, the functions here take a list of segments (pointer, length) and
+//! code them in order, the state of the line code (level, last bit) is kept
+//! across the segment boundaries. The output is one buffer or a list of
+//! segments as well, chips which fall on a boundary between two output
+//! segments are split between them.
+//!
+//! Encoding writes straight into the output. Decoding takes the chips in
+//! blocks of SG_BLOCK bytes into a buffer on the stack, as the decoders
+//! work in place.
+//!
+//! sg_encode_chain() runs the codecs of a chain up to the line code on the
+//! segment list: CRC8/CRC16, ENCODED_LENGTH, SYNC_WORD and PREAMBLE only add
+//! segments of their own. The line code then writes the coded frame to its
+//! place in the output, SYNC_WORD and PREAMBLE after it are written in front.
+//! Any other codec is run in place as by bc_encode_chain(), after the
+//! segments are gathered into the output. sg_decode_chain() decodes the line
+//! code straight from the segments, if it is only followed by SYNC_WORD and
+//! PREAMBLE.
+
+#ifndef SG_H
+#define SG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "bytecoder.h"
+
+#define SG_BLOCK 64       //!< chips decoded at once, even
+#define SG_MAX_SEGS 16    //!< segments of a frame in sg_encode_chain(), input and added ones
+#define SG_EXTRA 16       //!< bytes of the segments added by sg_encode_chain()
+
+//! input segment
+typedef struct {
+	const uint8_t *buf;
+	int len;
+} sg_in_t;
+
+//! output segment
+typedef struct {
+	uint8_t *buf;
+	int len;
+} sg_out_t;
+
+#ifdef CONFIG_SG
+int sg_ratio(const bytecodec_t *codec);
+int sg_gather(uint8_t *dest, const sg_in_t *src, int nsrc);
+int sg_encode(const bytecodec_t *codec, const sg_out_t *dest, int ndest, const sg_in_t *src, int nsrc);
+int sg_decode(const bytecodec_t *codec, const sg_out_t *dest, int ndest, const sg_in_t *src, int nsrc);
+int sg_encode_chain(const bytecodec_chain_t *codec_chain, uint8_t *buf, const sg_in_t *src, int nsrc);
+int sg_decode_chain(const bytecodec_chain_t *codec_chain, uint8_t *buf, const sg_in_t *src, int nsrc);
+#endif
+
+#endif
@@ -0,0 +1,110 @@
+//! Bit slicer with clock recovery
+
+//! @file slicer.c
+
+
+#include <math.h>
+#include "config.h"
+#include "slicer.h"
+
+
+#ifdef CONFIG_SLICER
+//! prepare a slicer
+
+//! the first chip is expected in the first samples_per_chip samples
+//! @param s slicer
+//! @param samples_per_chip nominal samples per chip, at least 2
+//! @param bandwidth loop bandwidth relative to the chip rate (typ. 0.02 - 0.1)
+//! @return 0 on success, -1 on invalid parameters
+int slicer_init(slicer_t *s, float samples_per_chip, float bandwidth)
+{
+	//second order loop with a damping of 0.707
+	float damping = 0.707f, theta = bandwidth / (damping + 0.25f / damping);
+	float d = 1 + 2 * damping * theta + theta * theta;
+	if(samples_per_chip < 2 || bandwidth <= 0 || bandwidth >= 0.25f)
+		return(-1);
+	s->spc = samples_per_chip;
+	//the normalized error is about 4 / samples_per_chip per sample of timing offset
+	s->kp = 4 * damping * theta / d * samples_per_chip / 4;
+	s->ki = 4 * theta * theta / d * samples_per_chip / 4;
+	s->integ = 0;
+	s->step = samples_per_chip / 2;
+	s->pos = (samples_per_chip - 1) / 2;
+	s->last = 0;
+	s->prev = 0;
+	s->mid = 0;
+	s->level = 0;
+	s->half = false;
+	s->byte = 0;
+	s->bits = 0;
+	return(0);
+}
+
+
+//! slice float samples
+
+//! @param s slicer, the loop state is kept
+//! @param dest chips, up to SLICER_OUT_MAX(len, samples_per_chip) bytes
+//! @param src samples
+//! @param len amount of samples
+//! @return amount of complete bytes
+long slicer_float(slicer_t *s, uint8_t *dest, const float *src, long len)
+{
+	float pos = s->pos, y, a, e, t;
+	long out = 0, i;
+	while(pos < len - 1) {
+		i = (long)floorf(pos);
+		a = (i < 0) ? s->last : src[i];
+		y = a + (src[i+1] - a) * (pos - i);
+		if(s->half) {
+			s->mid = y;
+			s->half = false;
+		} else {
+			s->level += (fabsf(y) - s->level) * (1.0f / 16);
+			e = (y - s->prev) * s->mid / (s->level * s->level + 1e-30f);
+			s->integ += s->ki * e;
+			t = s->spc / 8;
+			s->integ = (s->integ > t) ? t : ((s->integ < -t) ? -t : s->integ);
+			//late strobes (e > 0) make the next chip shorter
+			t = s->integ + s->kp * e;
+			t = (t > s->spc / 8) ? s->spc / 8 : ((t < -s->spc / 8) ? -s->spc / 8 : t);
+			s->step = (s->spc - t) / 2;
+			s->prev = y;
+			s->half = true;
+			s->byte |= (y > 0) << s->bits;
+			if(++s->bits == 8) {
+				dest[out++] = s->byte;
+				s->byte = 0;
+				s->bits = 0;
+			}
+		}
+		pos += s->step;
+	}
+	s->pos = pos - len;
+	if(len > 0)
+		s->last = src[len-1];
+	return(out);
+}
+
+
+//! slice int16 samples
+
+//! @param s slicer, the loop state is kept
+//! @param dest chips, up to SLICER_OUT_MAX(len, samples_per_chip) bytes
+//! @param src samples
+//! @param len amount of samples
+//! @return amount of complete bytes
+long slicer_int16(slicer_t *s, uint8_t *dest, const int16_t *src, long len)
+{
+	float buf[SLICER_BLOCK];
+	long done = 0, out = 0, n, i;
+	while(done < len) {
+		n = (len - done < SLICER_BLOCK) ? len - done : SLICER_BLOCK;
+		for(i=0;i<n;i++)
+			buf[i] = src[done + i];
+		out += slicer_float(s, dest + out, buf, n);
+		done += n;
+	}
+	return(out);
+}
+#endif //CONFIG_SLICER
@@ -0,0 +1,50 @@
+//! Bit slicer with clock recovery
+
+//! @file slicer.h
+//!
+//! Turns an oversampled, band limited and bipolar (centered on 0) sample
+//! stream into chips packed LSB first into bytes, the input of
+//! manchester_decode_buf() and the other chip decoders.
+//!
+//! The chip clock is recovered with a Gardner timing error detector: the
+//! stream is interpolated (linear) at every chip and half way between two
+//! chips, the sample between two chips is 0 on time, and its sign and size
+//! with the change of the chips tell if the clock is late or early. The
+//! error is normalized by the mean magnitude, so the loop does not depend
+//! on the signal level, and goes through a proportional integral loop
+//! filter which tracks a clock offset of up to 1/8 of the chip rate.
+//!
+//! The stream is processed in blocks of any size, the loop state and an
+//! incomplete byte are kept between calls.
+
+#ifndef SLICER_H
+#define SLICER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+#define SLICER_BLOCK 1024 //!< int16 samples converted at a time
+#define SLICER_OUT_MAX(len, samples_per_chip) ((long)((len) / ((samples_per_chip) * 7 / 8) / 8) + 1) //!< maximum bytes of len samples
+
+typedef struct {
+	float spc;          //!< nominal samples per chip
+	float kp, ki;       //!< loop filter gains
+	float integ;        //!< chip period correction in samples
+	float step;         //!< samples between two strobes (half a chip)
+	float pos;          //!< next strobe from the first sample of the next block, -1 is the last sample of the last block
+	float last;         //!< last sample of the last block
+	float prev, mid;    //!< last chip strobe and the strobe after it
+	float level;        //!< mean magnitude at the chip strobes
+	bool half;          //!< next strobe is between two chips
+	uint8_t byte;       //!< chips of an incomplete byte
+	uint_fast8_t bits;  //!< chips in byte
+} slicer_t;
+
+#ifdef CONFIG_SLICER
+int slicer_init(slicer_t *s, float samples_per_chip, float bandwidth);
+long slicer_float(slicer_t *s, uint8_t *dest, const float *src, long len);
+long slicer_int16(slicer_t *s, uint8_t *dest, const int16_t *src, long len);
+#endif
+
+#endif
@@ -1,16 +1,53 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 #include "manchester.h"
 #include "helper.h"
+#include "bytecoder.h"
+#include "deframer.h"
+#include "crc.h"
+#include "whitening.h"
+#include "blockcode.h"
+#include "fec.h"
+#include "conv.h"
+#include "interleave.h"
+#include "make_wav.h"
+#include "wav_map.h"
+#include "pcm.h"
+#include "nco.h"
+#include "fsk.h"
+#include "fir.h"
+#include "slicer.h"
+#include "pulse.h"
+#include "edge.h"
+#include "capture.h"
+#include "pipeline.h"
+#include "batch.h"
+#include "arena.h"
+#include "sg.h"
+#include "bits.h"
+#include "pin.h"
+
+
+static uint8_t test_mem[1024];
+static arena_t test_mem_arena;
+static pool_t test_pool; //!< buffers of the line code tests
+static const bytecodec_t test_line_codecs[] = {
+	{BYTECODEC_MANCHESTER_GE_THOMAS, {0, 0, 0}, NULL}
+};
 
 
 int test_manchester_code(uint8_t *in, int len)
 {
 	int e=0;
 	uint8_t *tmp;
-	if(!(tmp = malloc(len * 2))) {
-		printf("Error: malloc failed\n");
+	if(!(tmp = pool_alloc(&test_pool, len * 2))) {
+		printf("Error: no buffer\n");
+		return(-1);
 	}
 	memcpy(tmp, in, len);
 	manchester_encode_buf(tmp, len);
@@ -18,13 +55,13 @@ int test_manchester_code(uint8_t *in, int len)
 		manchester_decode_buf(tmp, len<<1);
 		e = memcmp(in, tmp, len);
 		printf("decoding manchester %s\n", e ? "failed" : "ok");
-		if(e)
-			return(-2);
+		e = e ? -2 : 0;
 	} else {
 		printf("invalid manchester data\n");
-		return(-1);
+		e = -1;
 	}
-	return(0);
+	pool_free(&test_pool, tmp);
+	return(e);
 }
 
 
@@ -32,21 +69,22 @@ int test_differential_manchester_code(bool prev, uint8_t *in, int len)
 {
 	int e=0;
 	uint8_t *tmp;
-	if(!(tmp = malloc(len * 2))) {
-		printf("Error: malloc failed\n");
+	if(!(tmp = pool_alloc(&test_pool, len * 2))) {
+		printf("Error: no buffer\n");
+		return(-1);
 	}
 	differential_manchester_encode_buf(tmp, prev, in, len);
 	if(manchester_check_buf(tmp, len<<1)) {
 		differential_manchester_decode_buf(prev, tmp, len<<1);
 		e = memcmp(in, tmp, len);
 		printf("decoding differential manchester %s\n", e ? "failed" : "ok");
-		if(e)
-			return(-2);
+		e = e ? -2 : 0;
 	} else {
 		printf("invalid manchester data\n");
-		return(-1);
+		e = -1;
 	}
-	return(0);
+	pool_free(&test_pool, tmp);
+	return(e);
 }
 
 
@@ -54,26 +92,1355 @@ int test_bmc_code(bool prev, uint8_t *in, int len)
 {
 	int e=0;
 	uint8_t *tmp;
-	if(!(tmp = malloc(len * 2))) {
-		printf("Error: malloc failed\n");
+	if(!(tmp = pool_alloc(&test_pool, len * 2))) {
+		printf("Error: no buffer\n");
+		return(-1);
 	}
 	bmc_encode_buf(tmp, prev, in, len);
 	if(bmc_check_buf(prev, tmp, len<<1)) {
 		bmc_decode_buf(tmp, len<<1);
 		e = memcmp(in, tmp, len);
 		printf("decoding bmc %s\n", e ? "failed" : "ok");
-		if(e)
-			return(-2);
+		e = e ? -2 : 0;
 	} else {
 		printf("invalid bmc data\n");
+		e = -1;
+	}
+	pool_free(&test_pool, tmp);
+	return(e);
+}
+
+int test_nrzi_code(bool prev, uint8_t *in, int len)
+{
+	int e;
+	uint8_t *tmp;
+	if(!(tmp = pool_alloc(&test_pool, len))) {
+		printf("Error: no buffer\n");
 		return(-1);
 	}
-	return(0);
+	memcpy(tmp, in, len);
+	nrzi_encode_buf(prev, tmp, len);
+	e = (nrzi_encode_byte(prev, in[0]) != tmp[0]);
+	nrzi_decode_buf(prev, tmp, len);
+	e |= memcmp(in, tmp, len);
+	printf("decoding nrzi %s\n", e ? "failed" : "ok");
+	pool_free(&test_pool, tmp);
+	return(e ? -2 : 0);
+}
+
+
+int test_miller_code(bool prev, uint8_t *in, int len)
+{
+	const uint8_t ref[2] = {0x38, 0xC6}; //0x32 first bit left 01001100 -> 00 01 11 00 01 10 00 11 (prev 0)
+	uint8_t *tmp;
+	int e;
+	if(!(tmp = pool_alloc(&test_pool, len * 2))) {
+		printf("Error: no buffer\n");
+		return(-1);
+	}
+	tmp[0] = 0x32;
+	miller_encode_buf(tmp, 0, tmp, 1);
+	e = memcmp(tmp, ref, 2);
+	tmp[0] ^= 0x10; //00 01 01 00 ..., transition after a 1
+	if(!e && !miller_decode_buf(0, tmp, 2)) {
+		printf("invalid miller data not detected\n");
+		e = 1;
+	}
+	miller_encode_buf(tmp, prev, in, len);
+	if(!e && miller_decode_buf(prev, tmp, len<<1)) {
+		printf("invalid miller data\n");
+		e = 1;
+	}
+	e |= memcmp(in, tmp, len);
+	printf("decoding miller %s\n", e ? "failed" : "ok");
+	pool_free(&test_pool, tmp);
+	return(e ? -2 : 0);
+}
+
+
+static const bytecodec_t test_frame_codecs[] = {
+	{BYTECODEC_CRC16, {0, CRC16_INIT, 0}, NULL},
+	{BYTECODEC_ENCODED_LENGTH, {0, 0, 0}, NULL},
+	{BYTECODEC_MANCHESTER_GE_THOMAS, {0, 0, 0}, NULL},
+	{BYTECODEC_SYNC_WORD, {0x2DD4, 2, 1}, NULL},
+	{BYTECODEC_PREAMBLE, {0xAA, 4, 0}, NULL}
+};
+
+
+struct test_deframer_ctx {
+	int frames;
+	int errors;
+	uint8_t payload[3][16];
+};
+
+
+static void test_deframer_cb(void *ctx, const deframer_frame_t *frame)
+{
+	struct test_deframer_ctx *c = ctx;
+	if(c->frames >= 3 || frame->len != 16 || memcmp(frame->data, c->payload[c->frames], 16))
+		c->errors++;
+	c->frames++;
+}
+
+
+//! append len bytes to a bit stream at bit position pos
+static size_t test_put_bits(uint8_t *stream, size_t pos, const uint8_t *buf, int len)
+{
+	int i, j;
+	for(i=0;i<len;i++) {
+		for(j=0;j<8;j++,pos++) {
+			if(READ_BIT(buf[i], j))
+				SET_BIT(stream[pos>>3], pos&7);
+		}
+	}
+	return(pos);
+}
+
+
+//! three frames at odd bit offsets, the second one hidden behind a false sync word
+int test_deframer(void)
+{
+	bytecodec_chain_t chain = {test_frame_codecs, sizeof(test_frame_codecs)/sizeof(test_frame_codecs[0]), 0, 0, 0, 0};
+	struct test_deframer_ctx ctx;
+	deframer_t d;
+	uint8_t stream[512], frame[64], buf[64], out[64];
+	size_t pos=0, n;
+	int i, len;
+
+	bc_chain_plan(&chain, 16);
+	memset(&ctx, 0, sizeof(ctx));
+	memset(stream, 0, sizeof(stream));
+	//a one byte length field can not hold 256, a buffer not longer than the header no frame
+	if(bc_encode(&test_frame_codecs[1], stream, 256) != -1 || !deframer_init(&d, &chain, buf, out, 2, test_deframer_cb, &ctx)) {
+		printf("deframer length limits failed\n");
+		return(-1);
+	}
+	if(deframer_init(&d, &chain, buf, out, sizeof(buf), test_deframer_cb, &ctx)) {
+		printf("deframer_init failed\n");
+		return(-1);
+	}
+	for(i=0;i<3;i++) {
+		for(n=0;n<16;n++)
+			ctx.payload[i][n] = rand();
+		memset(frame, 0, sizeof(frame));
+		memcpy(frame, ctx.payload[i], 16);
+		len = bc_encode_chain(&chain, frame, 16);
+		pos += 8 * 5 + i * 3;
+		if(i == 1) { //false sync word, the frame starts inside the false one
+			uint8_t garbage[4] = {0x2D, 0xD4, 20, 0};
+			manchester_encode_buf(garbage + 2, 1);
+			pos = test_put_bits(stream, pos, garbage, 4);
+		}
+		pos = test_put_bits(stream, pos, frame, len);
+	}
+	for(n=0;n<sizeof(stream);n+=len) {
+		len = rand() % 13 + 1; //min() is a macro
+		len = min((size_t)len, sizeof(stream) - n);
+		deframer_push(&d, stream + n, len);
+	}
+	printf("deframer %d frames, %lu failures: %s\n", ctx.frames, d.failures, (ctx.frames == 3 && !ctx.errors) ? "ok" : "failed");
+	return((ctx.frames == 3 && !ctx.errors) ? 0 : -2);
+}
+
+
+//! fused whitening chain against the bit serial codecs
+int test_whitening(uint8_t *in, int len)
+{
+	static whitening_t w;
+	const uint8_t pn9[4] = {0xFF, 0xE1, 0x1D, 0x9A};
+	bytecodec_t codecs[3] = {
+		{BYTECODEC_CRC16, {0, CRC16_INIT, 0}, NULL},
+		{BYTECODEC_WHITENING, {WHITENING_PN9, 0, 0}, NULL},
+		{BYTECODEC_MANCHESTER_GE_THOMAS, {0, 0, 0}, NULL}
+	};
+	uint8_t *fused, *serial, key[4] = {0};
+	int e, fused_len, serial_len;
+
+	whitening_init(&w, WHITENING_PN9, 0);
+	whitening_xor(&w, w.seed, key, 4);
+	if(memcmp(key, pn9, 4)) {
+		printf("whitening PN9 keystream failed\n");
+		return(-1);
+	}
+	if(!(fused = malloc((len + 2) * 2)) || !(serial = malloc((len + 2) * 2))) {
+		printf("Error: malloc failed\n");
+		free(fused);
+		return(-1);
+	}
+	memcpy(serial, in, len);
+	serial_len = bc_encode_codecs(codecs, 3, serial, len);
+	codecs[1].data = &w;
+	memcpy(fused, in, len);
+	fused_len = bc_encode_codecs(codecs, 3, fused, len);
+	e = (fused_len != serial_len) || memcmp(fused, serial, fused_len);
+	if(!e) {
+		fused_len = bc_decode_codecs(codecs, 3, fused, fused_len);
+		e = (fused_len != len) || memcmp(fused, in, len);
+	}
+	codecs[1].opt[1] = 0x0F; //seed not the one of the tables
+	e |= (bc_encode(&codecs[1], fused, len) != -1) || (bc_encode_codecs(codecs, 3, fused, len) != -1);
+	printf("whitening %s\n", e ? "failed" : "ok");
+	free(fused);
+	free(serial);
+	return(e ? -2 : 0);
 }
 
 
+int test_blockcode(uint8_t *in, int len)
+{
+	bytecodec_t codecs[2] = {
+		{BYTECODEC_4B5B, {0, 0, 0}, NULL},
+		{BYTECODEC_8B10B, {0, 0, 0}, NULL}
+	};
+	uint8_t *buf;
+	bool rd = 0;
+	int i, e, enc_len;
+
+	e = (eightb_tenb_encode_symbol(&rd, 0x00) != 0x0B9) || rd; //D.0.0 RD- 100111 0100
+	e |= (eightb_tenb_encode_symbol(&rd, EIGHTB_TENB_K28_5) != 0x17C) || !rd; //K28.5 RD- 001111 1010
+	e |= (eightb_tenb_decode_symbol(&rd, 0x283) != EIGHTB_TENB_K28_5) || rd; //K28.5 RD+ 110000 0101
+	if(!(buf = malloc(len * 2))) {
+		printf("Error: malloc failed\n");
+		return(-1);
+	}
+	for(i=0;i<2 && !e;i++) {
+		memcpy(buf, in, len);
+		enc_len = bc_encode(&codecs[i], buf, len);
+		e = (enc_len != BLOCKCODE_ENC_LEN(len)) || (bc_decode(&codecs[i], buf, enc_len) != len) || memcmp(buf, in, len);
+		if(!e) { //00000 00000 is no valid code word
+			enc_len = bc_encode(&codecs[i], buf, len);
+			buf[0] = 0;
+			buf[1] &= ~0x03;
+			e = bc_decode(&codecs[i], buf, enc_len) >= 0;
+		}
+	}
+	printf("blockcode %s\n", e ? "failed" : "ok");
+	free(buf);
+	return(e ? -2 : 0);
+}
+
+
+int test_fec(uint8_t *in, int len)
+{
+	const uint8_t msg[16] = {0x40, 0xD2, 0x75, 0x47, 0x76, 0x17, 0x32, 0x06, 0x27, 0x26, 0x96, 0xC6, 0xC6, 0x96, 0x70, 0xEC};
+	const uint8_t parity[10] = {0xBC, 0x2A, 0x90, 0x13, 0x6B, 0xAF, 0xEF, 0xFD, 0x4B, 0xE0}; //QR code example
+	bytecodec_t codecs[3] = {
+		{BYTECODEC_HAMMING_8_4, {0, 0, 0}, NULL},
+		{BYTECODEC_REED_SOLOMON, {8, 0, 0}, NULL},
+		{BYTECODEC_MANCHESTER_GE_THOMAS, {0, 0, 0}, NULL}
+	};
+	uint8_t *buf, tmp[10];
+	rs_t rs;
+	int i, e, enc_len;
+
+	rs_init(&rs, 10);
+	rs_encode_block(&rs, msg, 16, tmp);
+	e = memcmp(tmp, parity, 10);
+	if(!(buf = malloc(rs_encoded_len(8, len * 2) * 2))) {
+		printf("Error: malloc failed\n");
+		return(-1);
+	}
+	memcpy(buf, in, len);
+	enc_len = bc_encode_codecs(codecs, 3, buf, len);
+	for(i=0;i<enc_len;i+=enc_len/6)
+		buf[i] ^= 0x01; //6 bytes with invalid manchester, corrected as erasures
+	buf[3] ^= 0x0C; //1 byte error, a valid but wrong manchester pair
+	e |= (bc_decode_codecs(codecs, 3, buf, enc_len) != len) || memcmp(buf, in, len);
+	memcpy(buf, in, len);
+	hamming_encode_buf(buf, len);
+	for(i=0;i<len*2;i++)
+		buf[i] ^= BIT(i & 7); //1 bit error per code byte
+	e |= hamming_decode_buf(buf, len*2, &i) || memcmp(buf, in, len);
+	printf("fec %s\n", e ? "failed" : "ok");
+	free(buf);
+	return(e ? -2 : 0);
+}
+
+
+int test_conv(uint8_t *in, int len)
+{
+	bytecodec_t codec = {BYTECODEC_CONVOLUTIONAL, {0, 0, 0}, NULL};
+	uint8_t *buf, *soft;
+	int i, e, enc_len = CONV_ENC_LEN(len);
+
+	buf = malloc(enc_len);
+	soft = malloc(enc_len * 8);
+	if(!buf || !soft) {
+		printf("Error: malloc failed\n");
+		free(buf);
+		return(-1);
+	}
+	memcpy(buf, in, len);
+	e = bc_encode(&codec, buf, len) != enc_len;
+	for(i=0;i<enc_len*8;i++) {
+		//every 4th symbol unknown (punctured), the others weak
+		soft[i] = ((i & 3) == 3) ? 128 : (READ_BIT(buf[i>>3], i & 7) ? 160 : 96);
+	}
+	for(i=5;i<enc_len*8;i+=40)
+		buf[i>>3] ^= BIT(i & 7); //1 bit error per 20 data bits
+	e |= (bc_decode(&codec, buf, enc_len) != len) || memcmp(buf, in, len);
+	conv_decode_soft(soft, soft, len);
+	e |= memcmp(soft, in, len);
+	printf("convolutional %s\n", e ? "failed" : "ok");
+	free(soft);
+	free(buf);
+	return(e ? -2 : 0);
+}
+
+
+int test_interleave(uint8_t *in, int len)
+{
+	bytecodec_t codecs[2][2] = {
+		{{BYTECODEC_HAMMING_8_4, {0, 0, 0}, NULL}, {BYTECODEC_INTERLEAVE_BLOCK, {16, 24, 0}, NULL}},
+		{{BYTECODEC_HAMMING_8_4, {0, 0, 0}, NULL}, {BYTECODEC_INTERLEAVE_CONV, {3, 0, 0}, NULL}}
+	};
+	uint8_t *buf;
+	int i, j, e=0, enc_len;
+
+	if(!(buf = malloc(len * 2 + INTERLEAVE_CONV_EXTRA(3)))) {
+		printf("Error: malloc failed\n");
+		return(-1);
+	}
+	for(i=0;i<2;i++) {
+		memcpy(buf, in, len);
+		enc_len = bc_encode_codecs(codecs[i], 2, buf, len);
+		for(j=16;j<32;j++)
+			buf[j>>3] ^= BIT(j & 7); //16 bit burst, 1 error per code byte after deinterleaving
+		e |= (bc_decode_codecs(codecs[i], 2, buf, enc_len) != len) || memcmp(buf, in, len);
+	}
+	printf("interleave %s\n", e ? "failed" : "ok");
+	free(buf);
+	return(e ? -2 : 0);
+}
+
+
+//! little endian field of a file header
+static unsigned long long test_le(const uint8_t *buf, int n)
+{
+	unsigned long long v = 0;
+	while(n--)
+		v = (v << 8) | buf[n];
+	return(v);
+}
+
+
+//! read a file written by the wav writer, return its length
+static long test_read_file(const char *name, uint8_t *buf, long len)
+{
+	FILE *f = fopen(name, "rb");
+	long n;
+	if(!f)
+		return(-1);
+	n = fread(buf, 1, len, f);
+	fclose(f);
+	return(n);
+}
+
+
+//! unsigned 8 bit, float, multichannel headers and the JUNK to ds64 rewrite of RF64
+int test_wav_writer(void)
+{
+	const char *name = "test_wav_writer.wav";
+	const uint8_t u8[3] = {0, 128, 255};
+	const float f32[4] = {-1.0, -0.5, 0.5, 1.0};
+	const short int s16[3*5] = {0};
+	uint8_t buf[256];
+	wav_writer_t w;
+	long n;
+	int e;
+
+	//mono unsigned 8 bit: plain PCM fmt, the odd data chunk is padded
+	e = wav_open(&w, name, 8000, 1, WAV_UINT8) || wav_append(&w, u8, 3) || wav_close(&w);
+	n = test_read_file(name, buf, sizeof(buf));
+	e |= n != 80 + 4 || memcmp(buf, "RIFF", 4) || test_le(buf + 4, 4) != 80 - 8 + 4 || memcmp(buf + 12, "JUNK", 4);
+	e |= memcmp(buf + 48, "fmt ", 4) || test_le(buf + 52, 4) != 16 || test_le(buf + 56, 2) != 1 || test_le(buf + 58, 2) != 1;
+	e |= test_le(buf + 68, 2) != 1 || test_le(buf + 70, 2) != 8 || memcmp(buf + 72, "data", 4) || test_le(buf + 76, 4) != 3;
+	e |= memcmp(buf + 80, u8, 3) || buf[83];
+
+	//mono float: extensible fmt with the float sub format, fact chunk
+	e |= wav_open(&w, name, 8000, 1, WAV_FLOAT32) || wav_append(&w, f32, 4) || wav_close(&w);
+	n = test_read_file(name, buf, sizeof(buf));
+	e |= n != 116 + 16 || test_le(buf + 52, 4) != 40 || test_le(buf + 56, 2) != 0xFFFE || test_le(buf + 70, 2) != 32;
+	e |= test_le(buf + 76, 4) != 0x4 || test_le(buf + 80, 4) != 3 || memcmp(buf + 96, "fact", 4) || test_le(buf + 104, 4) != 4;
+	e |= memcmp(buf + 108, "data", 4) || test_le(buf + 112, 4) != 16 || memcmp(buf + 116, f32, 16);
+
+	//3 channels of int16: extensible fmt with the PCM sub format, no fact chunk
+	e |= wav_open(&w, name, 8000, 3, WAV_INT16) || wav_append(&w, s16, 5) || wav_close(&w);
+	n = test_read_file(name, buf, sizeof(buf));
+	e |= n != 104 + 30 || test_le(buf + 56, 2) != 0xFFFE || test_le(buf + 58, 2) != 3 || test_le(buf + 64, 4) != 8000 * 6;
+	e |= test_le(buf + 68, 2) != 6 || test_le(buf + 80, 4) != 1 || memcmp(buf + 96, "data", 4) || test_le(buf + 100, 4) != 30;
+
+	//RF64 with the limit lowered: the sizes go into the ds64 chunk
+	e |= wav_open(&w, name, 8000, 3, WAV_INT16);
+	w.rf64_limit = 100;
+	e |= wav_append(&w, s16, 5) || wav_close(&w);
+	n = test_read_file(name, buf, sizeof(buf));
+	e |= n != 104 + 30 || memcmp(buf, "RF64", 4) || test_le(buf + 4, 4) != 0xFFFFFFFF || memcmp(buf + 12, "ds64", 4);
+	e |= test_le(buf + 16, 4) != 28 || test_le(buf + 20, 8) != 104 - 8 + 30 || test_le(buf + 28, 8) != 30 || test_le(buf + 36, 8) != 5;
+	e |= test_le(buf + 100, 4) != 0xFFFFFFFF;
+	//block align and byte rate have to fit their fields
+	e |= !wav_open(&w, name, 8000, 0x4000, WAV_FLOAT32) || !wav_open(&w, name, 0x20000, 0x3FFF, WAV_FLOAT32);
+	e |= wav_open(&w, name, 8000, 0x3FFF, WAV_FLOAT32) || wav_close(&w);
+	remove(name);
+	printf("wav writer %s\n", e ? "failed" : "ok");
+	return(e ? -2 : 0);
+}
+
+
+int test_wav_map(void)
+{
+	const char *name = "test_wav_map.wav";
+	float iq[2*100];
+	short int mono[33];
+	const uint8_t *window;
+	wav_writer_t w;
+	wav_map_t m;
+	uint64_t pos, n;
+	int i, e;
+
+	for(i=0;i<200;i++)
+		iq[i] = (float)i / 200;
+	for(i=0;i<33;i++)
+		mono[i] = i * 1000 - 16000;
+	e = wav_open(&w, name, 1000000, 2, WAV_FLOAT32) || wav_append(&w, iq, 60) || wav_append(&w, iq + 120, 40) || wav_close(&w);
+	e |= wav_map_open(&m, name, WAV_MAP_SEQUENTIAL);
+	if(!e) {
+		e |= m.frames != 100 || m.channels != 2 || m.sample_rate != 1000000 || !wav_map_float(&m);
+		e |= memcmp(m.samples, iq, sizeof(iq)) != 0;
+		for(pos=0;(n = wav_map_window(&m, pos, 32, &window));pos+=n)
+			e |= memcmp(window, (const uint8_t *)iq + pos * 8, n * 8) != 0;
+		e |= pos != 100;
+		wav_map_close(&m);
+	}
+	e |= write_wav(name, 33, mono, 8000) || wav_map_open(&m, name, 0);
+	if(!e) {
+		e |= m.frames != 33 || !wav_map_int16(&m) || memcmp(wav_map_int16(&m), mono, sizeof(mono));
+		wav_map_close(&m);
+	}
+	remove(name);
+	printf("wav map %s\n", e ? "failed" : "ok");
+	return(e ? -2 : 0);
+}
+
+
+#define TEST_PCM_MAX 32
+//! every line code against its bytecodec, with either line level before the payload
+int test_pcm(uint8_t *in, int len)
+{
+	const char *name = "test_pcm.wav";
+	static const bytecodec_t codecs[] = {
+		{BYTECODEC_MANCHESTER_GE_THOMAS, {0, 0, 0}, NULL},
+		{BYTECODEC_MANCHESTER_IEEE802_3, {0, 0, 0}, NULL},
+		{BYTECODEC_DIFFERENTIAL_MANCHESTER_T0, {0, 0, 0}, NULL},
+		{BYTECODEC_DIFFERENTIAL_MANCHESTER_T0, {1, 0, 0}, NULL},
+		{BYTECODEC_DIFFERENTIAL_MANCHESTER_T1, {1, 0, 0}, NULL},
+		{BYTECODEC_BMC, {0, 0, 0}, NULL},
+		{BYTECODEC_BMC, {1, 0, 0}, NULL},
+		{BYTECODEC_NRZI, {0, 0, 0}, NULL},
+		{BYTECODEC_NRZI, {1, 1, 0}, NULL},
+		{BYTECODEC_MILLER, {0, 0, 0}, NULL},
+		{BYTECODEC_MILLER, {1, 0, 0}, NULL}
+	};
+	static pcm_t p;
+	uint8_t chips[2*TEST_PCM_MAX];
+	int16_t samples[TEST_PCM_MAX*16*4];
+	wav_writer_t w;
+	wav_map_t m;
+	long i, n;
+	int c, e = 0, chips_len;
+
+	len = min(len, TEST_PCM_MAX);
+	for(c=0;c<(int)(sizeof(codecs)/sizeof(codecs[0]));c++) {
+		memcpy(chips, in, len);
+		chips_len = bc_encode(&codecs[c], chips, len);
+		pcm_init(&p, &codecs[c], 4, 0, 0.5);
+		n = pcm_modulate_int16(&p, samples, in, len);
+		e |= chips_len < 0 || n != pcm_samples(&p, len) || n != (long)chips_len * 8 * 4;
+		for(i=0;i<n && !e;i++)
+			e |= samples[i] != (READ_BIT(chips[i>>5], (i >> 2) & 7) ? 16384 : -16384);
+		if(e) {
+			printf("pcm codec %d failed\n", codecs[c].id);
+			break;
+		}
+	}
+	//the same with edges, through the wav writer
+	pcm_init(&p, &test_line_codecs[0], 4, 2, 0.5);
+	n = pcm_modulate_int16(&p, samples, in, len);
+	e |= wav_open(&w, name, 8000, 1, WAV_INT16) || pcm_modulate_wav(&p, &w, in, len) || wav_close(&w);
+	if(!e && !wav_map_open(&m, name, 0)) {
+		e |= m.frames != (uint64_t)n || memcmp(m.samples, samples, n * 2);
+		wav_map_close(&m);
+	} else
+		e = 1;
+	remove(name);
+	printf("pcm %s\n", e ? "failed" : "ok");
+	return(e ? -2 : 0);
+}
+
+
+int test_nco(void)
+{
+	float a[1000], b[1000];
+	int16_t c[1000];
+	nco_t n;
+	int i, e=0;
+
+	nco_init(&n, 1234.5, 48000);
+	nco_float(&n, a, 1000, 1.0);
+	e |= n.phase != (uint32_t)(1000 * nco_inc(1234.5, 48000)); //no drift, the phase is exact
+	nco_init(&n, 1234.5, 48000);
+	nco_float(&n, b, 333, 1.0);
+	nco_float(&n, b + 333, 667, 1.0); //blocks continue the phase
+	e |= memcmp(a, b, sizeof(a)) != 0;
+	nco_init(&n, 1234.5, 48000);
+	nco_int16(&n, c, 1000, 32000);
+	for(i=0;i<1000;i++) {
+		float r = sin(2 * M_PI * (uint32_t)(i * nco_inc(1234.5, 48000)) / 4294967296.0);
+		e |= fabs(a[i] - r) > 1e-6 || abs(c[i] - (int)lrintf(r * 32000)) > 1;
+	}
+	printf("nco %s\n", e ? "failed" : "ok");
+	return(e ? -2 : 0);
+}
+
+
+int test_fsk(void)
+{
+	const char *name = "test_fsk.wav";
+	const uint8_t in[3] = {0x00, 0xFF, 0x00};
+	static fsk_t f;
+	float iq[3*8*8*2], d;
+	int16_t a[3*8*8], b[3*8*8];
+	wav_writer_t w;
+	wav_map_t m;
+	long i, n;
+	int e;
+
+	//gfsk baseband, a run of bits is at full deviation of +-45 degree per sample
+	fsk_init(&f, FSK_GFSK, 8, 0.5, 1200, 0, 9600, 1.0);
+	n = fsk_modulate_iq(&f, iq, in, 3);
+	e = n != fsk_samples(&f, 3);
+	for(i=0;i+1<n;i++) {
+		d = atan2(iq[2*i] * iq[2*i+3] - iq[2*i+1] * iq[2*i+2], iq[2*i] * iq[2*i+2] + iq[2*i+1] * iq[2*i+3]);
+		e |= fabs(sqrt(iq[2*i] * iq[2*i] + iq[2*i+1] * iq[2*i+1]) - 1) > 1e-5;
+		if(i / 8 == 3 || i / 8 == 20)
+			e |= fabs(d + M_PI / 4) > 1e-4;
+		if(i / 8 == 11 || i / 8 == 12)
+			e |= fabs(d - M_PI / 4) > 1e-4;
+	}
+	//shaped ook on a carrier, directly and through the wav writer
+	fsk_init(&f, FSK_OOK, 8, 0.5, 0, 2400, 9600, 0.5);
+	n = fsk_modulate_int16(&f, a, in, 3);
+	for(i=0;i<n;i++)
+		e |= (i / 8 < 6 && a[i]) || abs(a[i]) > 16384;
+	fsk_init(&f, FSK_OOK, 8, 0.5, 0, 2400, 9600, 0.5);
+	e |= wav_open(&w, name, 9600, 1, WAV_INT16) || fsk_modulate_wav(&f, &w, in, 3) || wav_close(&w);
+	if(!e && !wav_map_open(&m, name, 0)) {
+		memcpy(b, m.samples, min(m.frames, (uint64_t)n) * 2);
+		e |= m.frames != (uint64_t)n || memcmp(a, b, n * 2);
+		wav_map_close(&m);
+	} else
+		e = 1;
+	remove(name);
+	printf("fsk %s\n", e ? "failed" : "ok");
+	return(e ? -2 : 0);
+}
+
+
+#define TEST_FIR_LEN 3000
+int test_fir(void)
+{
+	static fir_t f;
+	static float in[TEST_FIR_LEN], out[TEST_FIR_LEN], taps[31];
+	static int16_t in16[TEST_FIR_LEN], out16[TEST_FIR_LEN];
+	long i, j, n, m;
+	float r;
+	int e;
+
+	for(i=0;i<TEST_FIR_LEN;i++) {
+		in16[i] = (rand() & 0x3fff) - 0x2000;
+		in[i] = in16[i] / 32768.0f;
+	}
+	e = fir_lowpass(taps, 31, 1000, 8000);
+	//in pieces, the history carries over
+	e |= fir_init(&f, taps, 31, 4);
+	n = fir_float(&f, out, in, 1);
+	n += fir_float(&f, out + n, in + 1, 1332);
+	n += fir_float(&f, out + n, in + 1333, TEST_FIR_LEN - 1333);
+	e |= n != FIR_OUT_MAX(TEST_FIR_LEN, 4);
+	for(i=0;i<n;i++) {
+		r = 0;
+		for(j=0;j<31 && j<=4*i;j++)
+			r += taps[j] * in[4*i-j];
+		e |= fabs(out[i] - r) > 1e-5;
+	}
+	e |= fir_init(&f, taps, 31, 4);
+	m = fir_int16(&f, out16, in16, TEST_FIR_LEN);
+	e |= m != n;
+	for(i=0;i<n;i++)
+		e |= abs(out16[i] - out[i] * 32768) > 2;
+	//unity gain at DC
+	for(i=0;i<TEST_FIR_LEN;i++)
+		in[i] = 0.25;
+	fir_reset(&f);
+	n = fir_float(&f, out, in, TEST_FIR_LEN);
+	e |= fabs(out[n-1] - 0.25) > 1e-5;
+	printf("fir %s\n", e ? "failed" : "ok");
+	return(e ? -2 : 0);
+}
+
+
+#define TEST_SLICER_LEN 64
+int test_slicer(void)
+{
+	static pcm_t p;
+	static int16_t samples[TEST_SLICER_LEN*16*8], drift[TEST_SLICER_LEN*16*8];
+	uint8_t in[TEST_SLICER_LEN], chips[2*TEST_SLICER_LEN+1];
+	slicer_t s;
+	long i, j, n, m, out = 0;
+	int e;
+
+	for(i=0;i<TEST_SLICER_LEN;i++)
+		in[i] = (i < 2) ? 0 : rand(); //preamble
+	pcm_init(&p, &test_line_codecs[0], 8, 4, 0.5);
+	n = pcm_modulate_int16(&p, samples, in, TEST_SLICER_LEN);
+	//the transmitter clock is 2 % fast (7.84 samples per chip)
+	for(m=0;(j = m * 51 / 50)+1<n;m++)
+		drift[m] = samples[j] + (samples[j+1] - samples[j]) * (m * 51 % 50) / 50;
+	e = slicer_init(&s, 8, 0.05);
+	for(i=0;i<m;i+=333)
+		out += slicer_int16(&s, chips + out, drift + i, min(m - i, 333));
+	e |= out < 2*TEST_SLICER_LEN - 1;
+	e |= manchester_decode_buf(chips, 2*TEST_SLICER_LEN - 2) != 0 || memcmp(chips, in, TEST_SLICER_LEN - 1);
+	printf("slicer %s\n", e ? "failed" : "ok");
+	return(e ? -2 : 0);
+}
+
+
+//! durations of the runs of equal chips, 3 % slow with jitter
+static long test_pulse_durations(uint32_t *d, const uint8_t *chips, int len)
+{
+	long i, n=0, run=1;
+	for(i=1;i<=len*8;i++) {
+		if(i < len*8 && READ_BIT(chips[i>>3], i & 7) == READ_BIT(chips[(i-1)>>3], (i-1) & 7)) {
+			run++;
+		} else {
+			d[n++] = run * 103 + rand() % 31 - 15;
+			run = 1;
+		}
+	}
+	return(n);
+}
+
+
+#define TEST_PULSE_MAX 32
+int test_pulse(uint8_t *in, int len)
+{
+	uint8_t chips[2*TEST_PULSE_MAX], out[PULSE_OUT_MAX(16*TEST_PULSE_MAX)];
+	uint32_t d[16*TEST_PULSE_MAX], edges[16*TEST_PULSE_MAX+1];
+	pulse_t p;
+	long i, n, m;
+	int e;
+
+	len = min(len, TEST_PULSE_MAX);
+	//manchester from edge time stamps, the timer wraps around
+	memcpy(chips, in, len);
+	manchester_encode_buf(chips, len);
+	n = test_pulse_durations(d, chips, 2*len);
+	edges[0] = 0xFFFFF000UL;
+	for(i=0;i<n;i++)
+		edges[i+1] = edges[i] + d[i];
+	e = pulse_init(&p, BYTECODEC_MANCHESTER_GE_THOMAS, 100, chips[0] & 1);
+	m = pulse_decode_edges(&p, out, edges, 7);
+	m += pulse_decode_edges(&p, out + m, edges + 7, n + 1 - 7);
+	e |= m != len || memcmp(out, in, len) || p.errors;
+	//bmc from durations, a glitch is an error and the decoder synchronizes again
+	bmc_encode_buf(chips, 0, in, len);
+	n = test_pulse_durations(d, chips, 2*len);
+	e |= pulse_init(&p, BYTECODEC_BMC, 100, 0);
+	m = pulse_decode(&p, out, d, n);
+	e |= m != len || memcmp(out, in, len) || p.errors;
+	pulse_init(&p, BYTECODEC_BMC, 100, 0);
+	d[n/2] = 20;
+	m = pulse_decode(&p, out, d, n);
+	e |= p.errors != 1 || m >= len || m < len/4 || memcmp(out, in, len/4);
+	printf("pulse %s\n", e ? "failed" : "ok");
+	return(e ? -2 : 0);
+}
+
+
+typedef struct {
+	edge_ring_t *ring;
+	const uint32_t *edges;
+	long len;
+	bool retry;          //!< wait for room, else drop
+	unsigned long dropped;
+	atomic_bool done;
+} test_edge_source_t;
+
+
+//! simulated interrupt source
+static void *test_edge_producer(void *arg)
+{
+	test_edge_source_t *s = arg;
+	long i;
+	for(i=0;i<s->len;i++) {
+		if(!(i & 255))
+			sched_yield(); //let the consumer catch up now and then
+		while(!edge_ring_push(s->ring, s->edges[i])) {
+			if(!s->retry) {
+				s->dropped++;
+				break;
+			}
+			sched_yield();
+		}
+	}
+	atomic_store(&s->done, true);
+	return(NULL);
+}
+
+
+#define TEST_EDGE_LEN 1000000
+#define TEST_EDGE_DROP_LEN 512
+int test_edge(uint8_t *in, int len)
+{
+	static edge_ring_t r;
+	static uint32_t edges[TEST_EDGE_LEN];
+	static uint8_t drop[2*TEST_EDGE_DROP_LEN], drop_out[TEST_EDGE_DROP_LEN + PULSE_OUT_MAX(EDGE_BATCH)];
+	uint32_t batch[EDGE_BATCH], last = 0;
+	uint8_t chips[2*TEST_PULSE_MAX], out[TEST_PULSE_MAX + PULSE_OUT_MAX(EDGE_BATCH)];
+	test_edge_source_t s = {&r, edges, TEST_EDGE_LEN, false, 0, false};
+	pthread_t t;
+	pulse_t p;
+	long i, j, k, n, got = 0;
+	bool done;
+	int e = 0, bits;
+
+	//stress: edges are dropped when the consumer falls behind, the others arrive once and in order
+	for(i=0;i<TEST_EDGE_LEN;i++)
+		edges[i] = i + 1;
+	edge_ring_init(&r);
+	if(pthread_create(&t, NULL, test_edge_producer, &s))
+		return(-1);
+	do {
+		done = atomic_load(&s.done);
+		n = edge_ring_read(&r, batch, 1 + rand() % EDGE_BATCH);
+		for(i=0;i<n;i++) {
+			e |= batch[i] <= last;
+			last = batch[i];
+		}
+		got += n;
+	} while(!done || n);
+	pthread_join(t, NULL);
+	e |= got + s.dropped != TEST_EDGE_LEN || r.overflows != s.dropped || edge_ring_count(&r);
+	//manchester edges from the source thread into the decoder
+	len = min(len, TEST_PULSE_MAX);
+	memcpy(chips, in, len);
+	manchester_encode_buf(chips, len);
+	n = test_pulse_durations(edges + 1, chips, 2*len);
+	edges[0] = 0;
+	for(i=1;i<=n;i++)
+		edges[i] += edges[i-1];
+	edge_ring_init(&r);
+	pulse_init(&p, BYTECODEC_MANCHESTER_GE_THOMAS, 100, chips[0] & 1);
+	s.len = n + 1;
+	s.retry = true;
+	atomic_store(&s.done, false);
+	if(pthread_create(&t, NULL, test_edge_producer, &s))
+		return(-1);
+	got = 0;
+	do {
+		done = atomic_load(&s.done);
+		got += edge_ring_decode(&r, &p, out + got, sizeof(out) - got);
+	} while(!done || edge_ring_count(&r));
+	pthread_join(t, NULL);
+	e |= got != len || memcmp(out, in, len) || p.errors;
+	//1 to 4 edges dropped by a full ring, the level has to follow them: 3 of
+	//the 8 bits of every byte are set, inverted bytes after a drop have 5
+	memset(drop, 0x07, TEST_EDGE_DROP_LEN);
+	manchester_encode_buf(drop, TEST_EDGE_DROP_LEN);
+	n = test_pulse_durations(edges + 1, drop, 2*TEST_EDGE_DROP_LEN);
+	edges[0] = 0;
+	for(i=1;i<=n;i++)
+		edges[i] += edges[i-1];
+	edge_ring_init(&r);
+	pulse_init(&p, BYTECODEC_MANCHESTER_GE_THOMAS, 100, drop[0] & 1);
+	got = 0;
+	for(i=0,k=1;i<=n;i++) {
+		if(k > 4 && edge_ring_count(&r) == EDGE_RING_LEN)
+			got += edge_ring_decode(&r, &p, drop_out + got, sizeof(drop_out) - got);
+		if(edge_ring_push(&r, edges[i]))
+			continue;
+		//the ring is full, edge i and k - 1 more are dropped
+		for(j=1;j<k && i<n;j++)
+			edge_ring_push(&r, edges[++i]);
+		k++;
+		got += edge_ring_decode(&r, &p, drop_out + got, sizeof(drop_out) - got);
+	}
+	got += edge_ring_decode(&r, &p, drop_out + got, sizeof(drop_out) - got);
+	e |= k != 5 || p.errors != 4 || got < TEST_EDGE_DROP_LEN - 8;
+	for(i=0;i<got;i++) {
+		for(j=0,bits=0;j<8;j++)
+			bits += READ_BIT(drop_out[i], j);
+		e |= bits != 3;
+	}
+	//two drops one batch apart, both still in the ring when the consumer comes to them
+	edge_ring_init(&r);
+	pulse_init(&p, BYTECODEC_MANCHESTER_GE_THOMAS, 100, drop[0] & 1);
+	for(i=0;edge_ring_push(&r, edges[i]);i++);
+	got = edge_ring_decode(&r, &p, drop_out, PULSE_OUT_MAX(EDGE_BATCH));
+	for(i++;edge_ring_push(&r, edges[i]);i++);
+	for(i++;i<=n;i++) {
+		if(edge_ring_count(&r) == EDGE_RING_LEN)
+			got += edge_ring_decode(&r, &p, drop_out + got, sizeof(drop_out) - got);
+		edge_ring_push(&r, edges[i]);
+	}
+	got += edge_ring_decode(&r, &p, drop_out + got, sizeof(drop_out) - got);
+	e |= r.overflows != 2 || p.errors != 2 || got < TEST_EDGE_DROP_LEN - 4;
+	for(i=0;i<got;i++) {
+		for(j=0,bits=0;j<8;j++)
+			bits += READ_BIT(drop_out[i], j);
+		e |= bits != 3;
+	}
+	printf("edge %s (%lu of %d dropped)\n", e ? "failed" : "ok", s.dropped, TEST_EDGE_LEN);
+	return(e ? -2 : 0);
+}
+
+
+int test_pin(uint8_t *in, int len)
+{
+	const char *name = "test_pin.wav";
+	static pcm_t pcm;
+	static int16_t samples[TEST_PULSE_MAX*16*8];
+	uint8_t chips[2*TEST_PULSE_MAX];
+	uint32_t d[16*TEST_PULSE_MAX], edges[16*TEST_PULSE_MAX+1];
+	bool first;
+	wav_writer_t w;
+	wav_map_t m;
+	long i, n, s, t, samples_len;
+	int e = 0;
+
+	len = min(len, TEST_PULSE_MAX);
+	memcpy(chips, in, len);
+	manchester_encode_buf(chips, len);
+	first = chips[0] & 1;
+	n = test_pulse_durations(d, chips, 2*len);
+	edges[0] = 0;
+	for(i=0;i<n;i++)
+		edges[i+1] = edges[i] + d[i];
+	//edge log in us, at normal and half speed, a pulse starting high is skipped
+	for(s=1;s<=2;s++) {
+		pin_host_reset();
+		e |= pin_host_edges(PIN_HOST_0, edges, n + 1, !first, s * cycles_per_ms());
+		for(i=first?2:1;i<n;i+=2) {
+			t = get_pulse_length(PIN_HOST_0, PIN_STATE_HIGH, 10000); //abs() is a macro
+			e |= abs(t - (long)(s * d[i])) > 1;
+		}
+	}
+	//8 samples per chip at 8 kHz, every chip is 1 ms
+	pcm_init(&pcm, &test_line_codecs[0], 8, 0, 0.5);
+	samples_len = pcm_modulate_int16(&pcm, samples, in, len);
+	e |= wav_open(&w, name, 8000, 1, WAV_INT16) || wav_append(&w, samples, samples_len) || wav_close(&w);
+	if(!e && !wav_map_open(&m, name, 0)) {
+		pin_host_reset();
+		e |= pin_host_wav(PIN_HOST_1, &m, 0, 1.0);
+		for(i=first?2:1;i<n-1;i+=2) {
+			t = get_pulse_length(PIN_HOST_1, PIN_STATE_HIGH, 10000);
+			e |= abs(t - (long)(1000 * ((d[i] + 50) / 103))) > 1;
+		}
+		wav_map_close(&m);
+	} else
+		e = 1;
+	remove(name);
+	printf("pin %s\n", e ? "failed" : "ok");
+	return(e ? -2 : 0);
+}
+
+#define TEST_CAPTURE_BURSTS 64
+int test_capture(uint8_t *in, int len)
+{
+	const char *name = "test_capture.edg";
+	static uint64_t times[TEST_CAPTURE_BURSTS*(16*TEST_PULSE_MAX+2)];
+	static capture_writer_t w;
+	static capture_cursor_t cur;
+	uint64_t start[TEST_CAPTURE_BURSTS+1], t;
+	uint8_t chips[2*TEST_PULSE_MAX], out[2*TEST_PULSE_MAX + PULSE_OUT_MAX(CAPTURE_BATCH)];
+	uint32_t d[16*TEST_PULSE_MAX], batch[CAPTURE_BATCH];
+	bool first, level = false;
+	capture_map_t c;
+	pulse_t p;
+	long i, k, n, m, total = 0;
+	int e;
+
+	len = min(len, TEST_PULSE_MAX);
+	memcpy(chips, in, len);
+	manchester_encode_buf(chips, len);
+	first = chips[0] & 1;
+	//bursts with idle time between them, one gap is longer than 2^32 ticks
+	t = 5000;
+	for(k=0;k<TEST_CAPTURE_BURSTS;k++) {
+		if(level == first)
+			times[total++] = t - 1000; //the line has to be at the other level before the burst
+		start[k] = t;
+		n = test_pulse_durations(d, chips, 2*len);
+		times[total++] = t;
+		for(i=0;i<n;i++)
+			times[total++] = t += d[i];
+		level = (n & 1) ? !first : first;
+		t += (k == TEST_CAPTURE_BURSTS/2) ? 0x123456789ULL : (uint64_t)(20000 + rand() % 100000);
+	}
+	start[k] = t;
+	e = capture_open(&w, name, 1000000, 1000000, false);
+	for(i=0;i<total && !e;i+=m) {
+		m = 1 + rand() % 3000; //min() is a macro
+		m = min(total - i, m);
+		e |= capture_append(&w, times + i, m);
+	}
+	e |= capture_close(&w) || capture_map_open(&c, name);
+	if(e) {
+		printf("capture failed\n");
+		return(-1);
+	}
+	e |= c.edges != (uint64_t)total || c.tick_rate != 1000000 || c.start != times[0];
+	//everything in order
+	e |= capture_seek(&cur, &c, 0);
+	for(i=0;(n = capture_read(&cur, batch, 1 + rand() % CAPTURE_BATCH, UINT64_MAX));i+=n)
+		for(k=0;k<n && i+k<total;k++)
+			e |= batch[k] != (uint32_t)times[i+k];
+	e |= i != total || capture_time(&cur) != UINT64_MAX;
+	//seeking
+	for(i=0;i<total;i+=1 + rand() % 1000) {
+		e |= capture_seek(&cur, &c, times[i] - (i && times[i-1] < times[i]));
+		e |= capture_time(&cur) != times[i] || capture_level(&cur) != ((i & 1) ? false : true);
+	}
+	//replay single bursts through the pulse and the chip decoder
+	for(k=0;k<TEST_CAPTURE_BURSTS;k+=5) {
+		e |= capture_seek(&cur, &c, start[k]) || capture_level(&cur) != first;
+		e |= pulse_init(&p, BYTECODEC_MANCHESTER_GE_THOMAS, 100, capture_level(&cur));
+		m = capture_decode(&cur, &p, out, sizeof(out), start[k+1] - 2000);
+		e |= m != len || memcmp(out, in, len) || p.errors;
+		e |= capture_seek(&cur, &c, start[k]);
+		m = capture_chips(&cur, out, sizeof(out), start[k+1] - 2000, 103);
+		e |= m != 2*len || manchester_decode_buf(out, 2*len) != 0 || memcmp(out, in, len);
+	}
+	e |= capture_seek(&cur, &c, t) || capture_read(&cur, batch, CAPTURE_BATCH, UINT64_MAX) != 0;
+	capture_map_close(&c);
+	remove(name);
+	printf("capture %s (%ld edges, %ld bytes of blocks)\n", e ? "failed" : "ok", total, (long)w.offset);
+	return(e ? -2 : 0);
+}
+
+#define TEST_PIPELINE_FRAMES 40
+struct test_pipeline_ctx {
+	int frames;
+	int errors;
+	uint8_t payload[TEST_PIPELINE_FRAMES][16];
+};
+
+
+static void test_pipeline_cb(void *ctx, const deframer_frame_t *frame)
+{
+	struct test_pipeline_ctx *c = ctx;
+	if(c->frames >= TEST_PIPELINE_FRAMES || frame->len != 16 || memcmp(frame->data, c->payload[c->frames], 16))
+		c->errors++;
+	c->frames++;
+}
+
+
+int test_pipeline(void)
+{
+	const char *name = "test_pipeline.wav";
+	bytecodec_chain_t chain = {test_frame_codecs, sizeof(test_frame_codecs)/sizeof(test_frame_codecs[0]), 0, 0, 0, 0};
+	const bytecodec_t nrz = {BYTECODEC_ABORT, {0, 0, 0}, NULL}; //no line code, the stream is already coded
+	static uint8_t stream[TEST_PIPELINE_FRAMES*64];
+	static int16_t samples[TEST_PIPELINE_FRAMES*64*8*8];
+	static pcm_t pcm;
+	static fir_t fir;
+	static pipeline_t p;
+	struct test_pipeline_ctx ctx;
+	uint8_t frame[64], buf[64], out[64], idle = 0x55;
+	float taps[31];
+	pipeline_wav_t src;
+	deframer_t d;
+	slicer_t s;
+	wav_writer_t w;
+	wav_map_t m;
+	size_t pos = 0;
+	long n;
+	int i, j, len, e;
+
+	//frames between alternating chips, which keep the slicer locked
+	bc_chain_plan(&chain, 16);
+	memset(&ctx, 0, sizeof(ctx));
+	memset(stream, 0, sizeof(stream));
+	for(i=0;i<TEST_PIPELINE_FRAMES;i++) {
+		for(j=0;j<16;j++)
+			ctx.payload[i][j] = rand();
+		memset(frame, 0, sizeof(frame));
+		memcpy(frame, ctx.payload[i], 16);
+		len = bc_encode_chain(&chain, frame, 16);
+		for(j=0;j<3+i%4;j++)
+			pos = test_put_bits(stream, pos, &idle, 1);
+		pos = test_put_bits(stream, pos, frame, len);
+	}
+	for(j=0;j<4;j++)
+		pos = test_put_bits(stream, pos, &idle, 1);
+	//8 samples per chip, filtered and decimated to 4
+	pcm_init(&pcm, &nrz, 8, 4, 0.5);
+	n = pcm_modulate_int16(&pcm, samples, stream, pos / 8);
+	e = wav_open(&w, name, 80000, 1, WAV_INT16) || wav_append(&w, samples, n) || wav_close(&w) || wav_map_open(&m, name, WAV_MAP_SEQUENTIAL);
+	e |= fir_lowpass(taps, 31, 10000, 80000) || fir_init(&fir, taps, 31, 2) || slicer_init(&s, 4, 0.05);
+	e |= deframer_init(&d, &chain, buf, out, sizeof(buf), test_pipeline_cb, &ctx);
+	if(e) {
+		printf("pipeline failed\n");
+		return(-1);
+	}
+	src.m = &m;
+	src.pos = 0;
+	pipeline_init(&p);
+	e |= pipeline_add(&p, pipeline_wav, &src, 2048 * sizeof(int16_t)) < 0;
+	e |= pipeline_add(&p, pipeline_fir_int16, &fir, FIR_OUT_MAX(2048, 2) * sizeof(int16_t)) < 0;
+	e |= pipeline_add(&p, pipeline_slicer_int16, &s, SLICER_OUT_MAX(FIR_OUT_MAX(2048, 2), 4)) < 0;
+	e |= pipeline_add(&p, pipeline_deframer, &d, 0) < 0;
+	e |= pipeline_run(&p);
+	e |= ctx.frames != TEST_PIPELINE_FRAMES || ctx.errors || p.stage[1].blocks + 1 != p.stage[0].blocks;
+	wav_map_close(&m);
+	remove(name);
+	printf("pipeline %s (load", e ? "failed" : "ok");
+	for(i=0;i<p.stages;i++)
+		printf(" %.2f", pipeline_load(&p, i));
+	printf(", occupancy");
+	for(i=1;i<p.stages;i++)
+		printf(" %.2f", pipeline_occupancy(&p, i));
+	printf(")\n");
+	return(e ? -2 : 0);
+}
+
+#define TEST_BATCH_JOBS 300
+#define TEST_BATCH_FILE 10    //!< job read from a file
+#define TEST_BATCH_MISSING 11 //!< job with a file which does not exist
+struct test_batch_ctx {
+	long done;
+	int frame;
+	int errors;
+};
+
+
+//! payload of frame k of job j
+static void test_batch_payload(uint8_t *payload, long j, int k)
+{
+	int i;
+	for(i=0;i<16;i++)
+		payload[i] = j * 31 + k * 7 + i;
+}
+
+
+static void test_batch_cb(void *ctx, long job, const uint8_t *frame, int len)
+{
+	struct test_batch_ctx *c = ctx;
+	uint8_t payload[16];
+	if(job != c->done)
+		c->errors++;
+	if(!frame) {
+		c->done++;
+		c->frame = 0;
+		return;
+	}
+	test_batch_payload(payload, job, c->frame++);
+	if(len != 16 || memcmp(frame, payload, 16))
+		c->errors++;
+}
+
+
+int test_batch(void)
+{
+	const char *name = "test_batch.bin";
+	bytecodec_chain_t chain = {test_frame_codecs, sizeof(test_frame_codecs)/sizeof(test_frame_codecs[0]), 0, 0, 0, 0};
+	static uint8_t streams[TEST_BATCH_JOBS][256];
+	static batch_job_t jobs[TEST_BATCH_JOBS];
+	struct test_batch_ctx ctx;
+	uint8_t frame[64];
+	batch_t b = {&chain, 0, test_batch_cb, &ctx, 0};
+	FILE *f;
+	size_t pos;
+	long j;
+	int k, len, run, e = 0;
+
+	//job j has j % 4 frames at different bit offsets
+	bc_chain_plan(&chain, 16);
+	for(j=0;j<TEST_BATCH_JOBS;j++) {
+		for(k=0,pos=j%13;k<j%4;k++) {
+			memset(frame, 0, sizeof(frame));
+			test_batch_payload(frame, j, k);
+			len = bc_encode_chain(&chain, frame, 16);
+			pos = test_put_bits(streams[j], pos, frame, len) + 8 * (k + 1);
+		}
+		jobs[j].buf = streams[j];
+		jobs[j].len = (pos + 7) / 8 + 1;
+	}
+	f = fopen(name, "wb");
+	e |= !f || fwrite(streams[TEST_BATCH_FILE], 1, jobs[TEST_BATCH_FILE].len, f) != jobs[TEST_BATCH_FILE].len;
+	if(f)
+		fclose(f);
+	jobs[TEST_BATCH_FILE].filename = name;
+	jobs[TEST_BATCH_MISSING].filename = "test_batch_missing.bin";
+	//all cores, then more workers than cores
+	for(run=0;run<2;run++) {
+		memset(&ctx, 0, sizeof(ctx));
+		b.workers = run ? 9 : 0;
+		e |= batch_run(&b, jobs, TEST_BATCH_JOBS);
+		e |= ctx.errors || ctx.done != TEST_BATCH_JOBS;
+		for(j=0;j<TEST_BATCH_JOBS;j++)
+			e |= jobs[j].frames != ((j == TEST_BATCH_MISSING) ? 0 : j % 4) || jobs[j].failures || jobs[j].error != (j == TEST_BATCH_MISSING);
+	}
+	remove(name);
+	printf("batch %s (%lu steals)\n", e ? "failed" : "ok", b.steals);
+	return(e ? -2 : 0);
+}
+
+int test_sg(uint8_t *in, int len)
+{
+	static const bytecodec_t line[] = {
+		{BYTECODEC_MANCHESTER_GE_THOMAS, {0, 0, 0}, NULL},
+		{BYTECODEC_MANCHESTER_IEEE802_3, {0, 0, 0}, NULL},
+		{BYTECODEC_DIFFERENTIAL_MANCHESTER_T0, {1, 0, 0}, NULL},
+		{BYTECODEC_DIFFERENTIAL_MANCHESTER_T1, {0, 0, 0}, NULL},
+		{BYTECODEC_BMC, {1, 0, 0}, NULL},
+		{BYTECODEC_NRZI, {1, 1, 0}, NULL},
+		{BYTECODEC_MILLER, {0, 0, 0}, NULL}
+	};
+	static const bytecodec_t codecs[] = {
+		{BYTECODEC_CRC8, {0, CRC8_INIT, 0}, NULL},
+		{BYTECODEC_WHITENING, {0, 0, 0}, NULL},
+		{BYTECODEC_MANCHESTER_GE_THOMAS, {0, 0, 0}, NULL},
+		{BYTECODEC_NRZI, {0, 0, 0}, NULL}
+	};
+	static const bytecodec_t too_long[] = {
+		{BYTECODEC_ENCODED_LENGTH, {0, 0, 0}, NULL},
+		{BYTECODEC_MANCHESTER_GE_THOMAS, {0, 0, 0}, NULL}
+	};
+	bytecodec_chain_t chain[3] = {
+		{test_frame_codecs, sizeof(test_frame_codecs)/sizeof(test_frame_codecs[0]), 0, 0, 0, 0},
+		{codecs, sizeof(codecs)/sizeof(codecs[0]), 0, 0, 0, 0},
+		{too_long, sizeof(too_long)/sizeof(too_long[0]), 0, 0, 0, 0}
+	};
+	static uint8_t big[300], big_out[1024];
+	uint8_t ref[256], out[256], dec[256];
+	sg_in_t src[3], chips[3];
+	sg_out_t dest[3], one = {dec, sizeof(dec)};
+	int c, n, m, e = 0;
+	//header, payload and trailer of odd lengths
+	src[0].buf = in;
+	src[0].len = 3;
+	src[1].buf = in + 3;
+	src[1].len = len - 8;
+	src[2].buf = in + len - 5;
+	src[2].len = 5;
+	for(c=0;c<(int)(sizeof(line)/sizeof(line[0]));c++) {
+		memcpy(ref, in, len);
+		n = bc_encode(&line[c], ref, len);
+		//chips of a byte split between the output segments
+		dest[0].buf = out;
+		dest[0].len = 7;
+		dest[1].buf = out + 7;
+		dest[1].len = 0;
+		dest[2].buf = out + 7;
+		dest[2].len = sizeof(out) - 7;
+		m = sg_encode(&line[c], dest, 3, src, 3);
+		e |= m != n || memcmp(out, ref, n);
+		chips[0].buf = out;
+		chips[0].len = 5;
+		chips[1].buf = out + 5;
+		chips[1].len = n - 14;
+		chips[2].buf = out + n - 9;
+		chips[2].len = 9;
+		m = sg_decode(&line[c], &one, 1, chips, 3);
+		e |= m != len || memcmp(dec, in, len);
+		//too small
+		dest[2].len = n - 8;
+		e |= sg_encode(&line[c], dest, 3, src, 3) != -1;
+	}
+	dest[0].len = sizeof(out);
+	n = sg_encode(&line[0], dest, 1, src, 3);
+	chips[1].len = n - 14;
+	e |= sg_decode(&line[0], &one, 1, chips, 3) != len;
+	out[12] ^= 0x01; //one manchester pair 00 or 11
+	e |= sg_decode(&line[0], &one, 1, chips, 3) != -1;
+	//chains, straight and gathered
+	for(c=0;c<2;c++) {
+		bc_chain_plan(&chain[c], len);
+		n = sg_gather(ref, src, 3);
+		n = bc_encode_chain(&chain[c], ref, n);
+		m = sg_encode_chain(&chain[c], out, src, 3);
+		e |= n < 0 || m != n || memcmp(out, ref, n);
+		chips[1].len = n - 14;
+		chips[2].buf = out + n - 9;
+		m = sg_decode_chain(&chain[c], dec, chips, 3);
+		e |= m != len || memcmp(dec, in, len);
+	}
+	out[n-1] ^= 0x10;
+	e |= sg_decode_chain(&chain[1], dec, chips, 3) != -1;
+	//300 bytes do not fit into a one byte length field
+	bc_chain_plan(&chain[2], sizeof(big));
+	src[0].buf = big;
+	src[0].len = 150;
+	src[1].buf = big + 150;
+	src[1].len = 150;
+	e |= sg_encode_chain(&chain[2], big_out, src, 2) != -1;
+	e |= bc_encode_chain(&chain[2], big_out, sizeof(big)) != -1;
+	printf("sg %s\n", e ? "failed" : "ok");
+	return(e ? -2 : 0);
+}
+
+int test_bits(uint8_t *in, int len)
+{
+	bytecodec_chain_t chain = {test_frame_codecs, sizeof(test_frame_codecs)/sizeof(test_frame_codecs[0]), 0, 0, 0, 0};
+	uint64_t word[3][BITS_WORDS(1024)];
+	uint8_t ref[256], tmp[256], out[256];
+	bits_t a, b, c, v;
+	bool prev;
+	int i, n, e = 0;
+	bits_init(&a, word[0], BITS_WORDS(1024));
+	bits_init(&b, word[1], BITS_WORDS(1024));
+	bits_init(&c, word[2], BITS_WORDS(1024));
+	//3 bits, then the bytes, which are no longer on a byte boundary
+	e |= bits_append(&a, 5, 3) || bits_append_bytes(&a, in, len) || a.len != 3 + 8 * (size_t)len;
+	e |= bits_peek(&a, 0, 3) != 5 || bits_peek(&a, 3, 8) != in[0] || bits_peek(&a, 3 + 8 * (len - 1), 64) != in[len-1];
+	e |= bits_slice(&v, &a, 3, 8 * len) || bits_bytes(&v) != NULL || v.word != word[0] || v.off != 3;
+	e |= bits_copy_bytes(&v, 0, tmp, sizeof(tmp)) != (size_t)len || memcmp(tmp, in, len);
+	e |= bits_slice(&v, &a, 0, a.len + 1) != -1;
+	//manchester from the unaligned view against the byte codec
+	bits_slice(&v, &a, 3, 8 * len);
+	memcpy(ref, in, len);
+	manchester_encode_buf(ref, len);
+	e |= bits_manchester_encode(&b, &v, false) || bits_bytes(&b) == NULL || b.len != 16 * (size_t)len || memcmp(bits_bytes(&b), ref, 2 * len);
+	e |= bits_manchester_decode(&c, &b, false) || c.len != 8 * (size_t)len || memcmp(bits_bytes(&c), in, len);
+	bits_clear(&c);
+	word[1][1] ^= 1; //one pair 00 or 11
+	e |= bits_manchester_decode(&c, &b, false) != -1;
+	//a stream of 13 bits, in place
+	bits_clear(&b);
+	bits_clear(&c);
+	bits_slice(&v, &a, 0, 13);
+	e |= bits_manchester_encode(&b, &v, true) || bits_manchester_decode(&c, &b, true) || c.len != 13 || bits_peek(&c, 0, 64) != bits_peek(&a, 0, 13);
+	//nrzi against the byte codec, in place
+	bits_clear(&b);
+	bits_append_bytes(&b, in, len);
+	bits_slice(&v, &b, 0, 0);
+	prev = 1;
+	e |= bits_nrzi_encode(&v, &b, &prev);
+	memcpy(ref, in, len);
+	e |= prev != nrzi_encode_buf(1, ref, len) || memcmp(bits_bytes(&b), ref, len);
+	prev = 1;
+	bits_slice(&v, &b, 0, 0);
+	e |= bits_nrzi_decode(&v, &b, &prev) || memcmp(bits_bytes(&b), in, len);
+	//chain on a view at bit 3, in place only after it is moved to bit 0
+	bc_chain_plan(&chain, len);
+	bits_slice(&v, &a, 3, 8 * len);
+	memcpy(ref, in, len);
+	n = bc_encode_chain(&chain, ref, len);
+	e |= bits_encode_chain(&chain, &v, NULL) != -1 || bits_decode_chain(&chain, &v, NULL) != -1 || bits_peek(&a, 0, 11) != (5 | (uint64_t)in[0] << 3);
+	//through the scratch buffer, the 3 bits in front are kept
+	e |= bits_encode_chain(&chain, &v, tmp) || v.off != 3 || v.len != 8 * (size_t)n || bits_peek(&a, 0, 3) != 5;
+	e |= bits_copy_bytes(&v, 0, out, n) != (size_t)n || memcmp(out, ref, n);
+	e |= bits_decode_chain(&chain, &v, tmp) || v.len != 8 * (size_t)len || bits_peek(&a, 0, 3) != 5;
+	e |= bits_copy_bytes(&v, 0, out, len) != (size_t)len || memcmp(out, in, len);
+	bits_align(&v);
+	e |= bits_encode_chain(&chain, &v, NULL) || v.off || v.len != 8 * (size_t)n || memcmp(bits_bytes(&v), ref, n);
+	e |= bits_decode_chain(&chain, &v, NULL) || v.len != 8 * (size_t)len || memcmp(bits_bytes(&v), in, len);
+	bits_init(&v, word[2], 1);
+	bits_append_bytes(&v, in, 4);
+	e |= bits_encode_chain(&chain, &v, NULL) != -1 || bits_encode_chain(&chain, &v, tmp) != -1;
+	for(i=0;i<70;i++)
+		e |= bits_append(&v, 1, 1) != (i < 64 - 32 ? 0 : -1);
+	printf("bits %s\n", e ? "failed" : "ok");
+	return(e ? -2 : 0);
+}
+
+int test_fixed(void)
+{
+	static const bytecodec_t codecs[] = {
+		{BYTECODEC_FIXED_LENGTH, {32, 0, 0}, NULL},
+		{BYTECODEC_MANCHESTER_IEEE802_3, {0, 0, 0}, NULL}
+	};
+	uint8_t in[64], ref[128], out[128];
+	int i, n, e = 0;
+	for(i=0;i<64;i++)
+		in[i] = rand();
+	memcpy(ref, in, 64);
+	manchester_encode_buf(ref, 64);
+	manchester_encode_fixed(16, out, in, false);
+	e |= memcmp(out, ref, 32) || manchester_decode_fixed(16, out, out, false) || memcmp(out, in, 16);
+	manchester_encode_fixed(32, out, in, false);
+	e |= memcmp(out, ref, 64) || manchester_decode_fixed(32, out, out, false) || memcmp(out, in, 32);
+	memcpy(out, in, 64);
+	manchester_encode_fixed(64, out, out, true);
+	for(i=0;i<128;i++)
+		e |= (out[i] ^ ref[i]) != 0xFF;
+	out[77] ^= 0x04; //one pair 00 or 11
+	e |= manchester_decode_fixed(64, out, out, true) != -1;
+	//a FIXED_LENGTH chain takes the unrolled coders (encoder not at -Os), same frames as codec by codec
+	memcpy(out, in, 20);
+	n = bc_encode_codecs(codecs, 2, out, 20);
+	memcpy(ref, in, 20);
+	e |= n != 64 || n != bc_encode(&codecs[1], ref, bc_encode(&codecs[0], ref, 20)) || memcmp(out, ref, n);
+	e |= bc_decode_codecs(codecs, 2, out, n) != 32 || memcmp(out, in, 20) || out[20] || out[31];
+	n = bc_encode_codecs(codecs, 2, out, 20);
+	out[0] ^= 0x01;
+	e |= bc_decode_codecs(codecs, 2, out, n) != -1;
+	printf("fixed %s\n", e ? "failed" : "ok");
+	return(e ? -2 : 0);
+}
+
+int test_arena(void)
+{
+	static uint8_t mem[4096 + 3];
+	bytecodec_chain_t chain = {test_frame_codecs, sizeof(test_frame_codecs)/sizeof(test_frame_codecs[0]), 0, 0, 0, 0};
+	uint8_t *x, *y, *b[2];
+	arena_t a;
+	pool_t p;
+	size_t mark;
+	int i, e;
+
+	//aligned pieces, released after a mark
+	arena_init(&a, mem + 3, sizeof(mem) - 3);
+	x = arena_alloc(&a, 5);
+	y = arena_alloc(&a, 17);
+	e = !x || !y || ((uintptr_t)x | (uintptr_t)y) % ARENA_ALIGN || y - x != ARENA_ALIGN;
+	mark = arena_mark(&a);
+	e |= !arena_alloc(&a, 1000) || arena_alloc(&a, sizeof(mem)) != NULL;
+	arena_release(&a, mark);
+	e |= arena_alloc(&a, 1) != y + 2 * ARENA_ALIGN || a.peak < 1000;
+	e |= !arena_thread() || arena_thread()->size;
+	//two frame buffers of the chain, then a larger size
+	bc_chain_plan(&chain, 16);
+	pool_init(&p);
+	e |= pool_add_chain(&p, &a, &chain, 2) || pool_add(&p, &a, 200, 1);
+	for(i=0;i<2;i++)
+		e |= !(b[i] = pool_alloc(&p, chain.dec_buf_len)) || ((uintptr_t)b[i] % ARENA_ALIGN);
+	x = pool_alloc(&p, chain.dec_buf_len); //from the larger size
+	e |= !x || pool_alloc(&p, 1) != NULL || p.misses != 1;
+	pool_free(&p, x);
+	e |= pool_alloc(&p, 200) != x || pool_alloc(&p, 201) != NULL;
+	pool_free(&p, x);
+	//the hot path takes nothing from the arena
+	mark = arena_mark(&a);
+	for(i=0;i<1000;i++) {
+		pool_free(&p, b[i & 1]);
+		e |= pool_alloc(&p, 1) != b[i & 1];
+	}
+	e |= arena_mark(&a) != mark || pool_add(&p, &a, sizeof(mem), 1) == 0;
+	printf("arena %s\n", e ? "failed" : "ok");
+	return(e ? -2 : 0);
+}
+
+
+
+
+
+
 int main(void)
 {
+	bytecodec_chain_t line_chain = {test_line_codecs, 1, 0, 0, 0, 0};
 	int i;
 	//test byte encoding/decoding
 	for(i=0;i<4;i++) {
@@ -123,8 +1490,38 @@ int main(void)
 	for(i=0;i<TEST_ARRAY_LEN;i++)
 		test_array[i] = rand();
 	print_levels_of_binary_code(test_array, TEST_ARRAY_LEN);
+	bc_chain_plan(&line_chain, TEST_ARRAY_LEN);
+	arena_init(&test_mem_arena, test_mem, sizeof(test_mem));
+	pool_init(&test_pool);
+	if(pool_add_chain(&test_pool, &test_mem_arena, &line_chain, 1))
+		printf("Error: no memory for the test buffers\n");
 	test_manchester_code(test_array, TEST_ARRAY_LEN);
 	test_differential_manchester_code(0, test_array, TEST_ARRAY_LEN);
 	test_bmc_code(0, test_array, TEST_ARRAY_LEN);
+	test_nrzi_code(0, test_array, TEST_ARRAY_LEN);
+	test_miller_code(0, test_array, TEST_ARRAY_LEN);
+	test_whitening(test_array, TEST_ARRAY_LEN);
+	test_blockcode(test_array, TEST_ARRAY_LEN);
+	test_fec(test_array, TEST_ARRAY_LEN);
+	test_conv(test_array, TEST_ARRAY_LEN);
+	test_interleave(test_array, TEST_ARRAY_LEN);
+	test_wav_writer();
+	test_wav_map();
+	test_pcm(test_array, TEST_ARRAY_LEN);
+	test_nco();
+	test_fsk();
+	test_fir();
+	test_slicer();
+	test_pulse(test_array, TEST_ARRAY_LEN);
+	test_edge(test_array, TEST_ARRAY_LEN);
+	test_pin(test_array, TEST_ARRAY_LEN);
+	test_capture(test_array, TEST_ARRAY_LEN);
+	test_pipeline();
+	test_batch();
+	test_arena();
+	test_sg(test_array, TEST_ARRAY_LEN);
+	test_bits(test_array, TEST_ARRAY_LEN);
+	test_fixed();
+	test_deframer();
 	return(0);
 }
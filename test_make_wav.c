@@ -3,8 +3,8 @@
  * Test program for the write_wav function in make_wav.c
  */
 
-#include <math.h>
 #include "make_wav.h"
+#include "nco.h"
 
 #define S_RATE  (44100)
 #define BUF_SIZE (S_RATE*2) /* 2 second buffer */
@@ -13,22 +13,16 @@ short int buffer[BUF_SIZE];
 
 int main(int argc, char * argv)
 {
-    int i;
-    float t;
     float amplitude = 32000;
     float freq_Hz = 440;
-    float phase=0;
+    nco_t osc;
 
-    float freq_radians_per_sample = freq_Hz*2*M_PI/S_RATE;
+    /* fill buffer with a sine wave, the phase accumulator does not drift */
+    nco_init(&osc, freq_Hz, S_RATE);
+    nco_int16(&osc, buffer, BUF_SIZE, amplitude);
 
-    /* fill buffer with a sine wave */
-    for (i=0; i<BUF_SIZE; i++)
-    {
-        phase += freq_radians_per_sample;
-    buffer[i] = (int)(amplitude * sin(phase));
-    }
-
-    write_wav("test.wav", BUF_SIZE, buffer, S_RATE);
+    if (write_wav("test.wav", BUF_SIZE, buffer, S_RATE))
+        return 1;
 
     return 0;
 }
@@ -0,0 +1,252 @@
+//! Memory mapped WAV and raw sample reader
+
+//! @file wav_map.c
+
+
+#include <string.h>
+#include "config.h"
+#ifdef CONFIG_WAV_MAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "wav_map.h"
+
+
+#ifdef CONFIG_WAV_MAP
+#define WAV_MAP_SIZE_UNKNOWN 0xFFFFFFFFUL //!< 32 bit size field of RF64 files
+#define WAV_MAP_FORMAT_PCM 1
+#define WAV_MAP_FORMAT_IEEE_FLOAT 3
+#define WAV_MAP_FORMAT_EXTENSIBLE 0xFFFE
+
+
+//! read a little endian field of the header
+static uint64_t wav_map_le(const uint8_t *p, uint_fast8_t bytes)
+{
+	uint64_t out=0;
+	while(bytes--)
+		out = (out << 8) | p[bytes];
+	return(out);
+}
+
+
+//! map a whole file read only
+
+//! @return 0 on success, -1 on error
+static int wav_map_file(wav_map_t *m, const char *filename, uint_fast8_t flags)
+{
+	struct stat st;
+	void *map;
+	int fd = open(filename, O_RDONLY);
+	memset(m, 0, sizeof(*m));
+	if(fd < 0)
+		return(-1);
+	if(fstat(fd, &st) || st.st_size <= 0 || (uint64_t)st.st_size > SIZE_MAX) {
+		close(fd);
+		return(-1);
+	}
+	map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd); //the mapping keeps the file
+	if(map == MAP_FAILED)
+		return(-1);
+	if(flags & WAV_MAP_SEQUENTIAL)
+		madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+	m->map = map;
+	m->map_len = (size_t)st.st_size;
+	m->flags = flags;
+	return(0);
+}
+
+
+//! set the sample format and the sample range
+
+//! @param m reader
+//! @param format sample format
+//! @param channels channels per frame
+//! @param offset offset of the first sample in the file
+//! @param size bytes of samples
+//! @return 0 on success, -1 if the format can not be viewed on this host
+static int wav_map_samples(wav_map_t *m, wav_format_t format, uint_fast16_t channels, size_t offset, uint64_t size)
+{
+	m->format = format;
+	m->channels = channels;
+	m->bytes_per_sample = (format == WAV_UINT8) ? 1 : ((format == WAV_FLOAT32) ? 4 : 2);
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+	if(format != WAV_UINT8)
+		return(-1);
+#endif
+	if(!channels || offset > m->map_len)
+		return(-1);
+	m->samples = m->map + offset;
+	m->frames = size / (channels * m->bytes_per_sample);
+	return(0);
+}
+
+
+//! map a WAV file and validate its header
+
+//! @param m reader
+//! @param filename file to map
+//! @param flags WAV_MAP_SEQUENTIAL or 0
+//! @return 0 on success, -1 if the file can not be mapped or has an unsupported header
+int wav_map_open(wav_map_t *m, const char *filename, uint_fast8_t flags)
+{
+	const uint8_t *p, *fmt = NULL;
+	size_t pos = 12, len;
+	uint64_t size, data_size64 = 0;
+	uint_fast16_t tag, channels, bits;
+	wav_format_t format;
+	bool rf64;
+
+	if(wav_map_file(m, filename, flags))
+		return(-1);
+	p = m->map;
+	len = m->map_len;
+	if(len < 12 || (memcmp(p, "RIFF", 4) && memcmp(p, "RF64", 4)) || memcmp(p + 8, "WAVE", 4))
+		goto invalid;
+	rf64 = !memcmp(p, "RF64", 4);
+	//walk the chunks up to the data chunk
+	for(;;) {
+		if(pos + 8 > len)
+			goto invalid;
+		size = wav_map_le(p + pos + 4, 4);
+		if(!memcmp(p + pos, "data", 4))
+			break;
+		if(size > len - pos - 8)
+			goto invalid;
+		if(!memcmp(p + pos, "ds64", 4) && size >= 24)
+			data_size64 = wav_map_le(p + pos + 16, 8);
+		else if(!memcmp(p + pos, "fmt ", 4) && size >= 16)
+			fmt = p + pos + 8;
+		pos += 8 + size + (size & 1);
+	}
+	pos += 8;
+	if(rf64 && size == WAV_MAP_SIZE_UNKNOWN)
+		size = data_size64;
+	if(!size || size > len - pos)
+		size = len - pos; //not closed or truncated recording
+	if(!fmt)
+		goto invalid;
+
+	tag = wav_map_le(fmt, 2);
+	channels = wav_map_le(fmt + 2, 2);
+	bits = wav_map_le(fmt + 14, 2);
+	if(tag == WAV_MAP_FORMAT_EXTENSIBLE && wav_map_le(fmt - 4, 4) >= 40)
+		tag = wav_map_le(fmt + 24, 2); //the sub format GUID starts with the format tag
+	if(tag == WAV_MAP_FORMAT_PCM && bits == 8)
+		format = WAV_UINT8;
+	else if(tag == WAV_MAP_FORMAT_PCM && bits == 16)
+		format = WAV_INT16;
+	else if(tag == WAV_MAP_FORMAT_IEEE_FLOAT && bits == 32)
+		format = WAV_FLOAT32;
+	else
+		goto invalid;
+	if(wav_map_samples(m, format, channels, pos, size))
+		goto invalid;
+	if(wav_map_le(fmt + 12, 2) != channels * m->bytes_per_sample) //block align
+		goto invalid;
+	m->sample_rate = wav_map_le(fmt + 4, 4);
+	return(0);
+invalid:
+	wav_map_close(m);
+	return(-1);
+}
+
+
+//! map a raw sample file (no header)
+
+//! @param m reader
+//! @param filename file to map
+//! @param flags WAV_MAP_SEQUENTIAL or 0
+//! @param format sample format
+//! @param channels samples per frame, 2 for interleaved IQ
+//! @param sample_rate frames per second, informational
+//! @return 0 on success, -1 on error
+int wav_map_open_raw(wav_map_t *m, const char *filename, uint_fast8_t flags, wav_format_t format, uint_fast16_t channels, uint32_t sample_rate)
+{
+	if(wav_map_file(m, filename, flags))
+		return(-1);
+	if(wav_map_samples(m, format, channels, 0, m->map_len)) {
+		wav_map_close(m);
+		return(-1);
+	}
+	m->sample_rate = sample_rate;
+	return(0);
+}
+
+
+//! unmap a file
+void wav_map_close(wav_map_t *m)
+{
+	if(m->map)
+		munmap((void *)m->map, m->map_len);
+	m->map = NULL;
+	m->samples = NULL;
+	m->frames = 0;
+}
+
+
+//! int16 view of the samples
+
+//! @return interleaved samples, or NULL if the file has another format or is not aligned
+const int16_t *wav_map_int16(const wav_map_t *m)
+{
+	if(m->format != WAV_INT16 || ((uintptr_t)m->samples & 1))
+		return(NULL);
+	return((const int16_t *)m->samples);
+}
+
+
+//! uint8 view of the samples
+
+//! @return interleaved samples, or NULL if the file has another format
+const uint8_t *wav_map_uint8(const wav_map_t *m)
+{
+	if(m->format != WAV_UINT8)
+		return(NULL);
+	return(m->samples);
+}
+
+
+//! float view of the samples
+
+//! @return interleaved samples, or NULL if the file has another format or is not aligned
+const float *wav_map_float(const wav_map_t *m)
+{
+	if(m->format != WAV_FLOAT32 || ((uintptr_t)m->samples & 3))
+		return(NULL);
+	return((const float *)m->samples);
+}
+
+
+//! get a window of frames
+
+//! with WAV_MAP_SEQUENTIAL the window is prefetched and the pages of the window
+//! before it (same size) are released
+//! @param m reader
+//! @param pos first frame
+//! @param frames frames wanted
+//! @param samples set to the first sample of the window
+//! @return frames in the window, less than frames at the end of the file
+uint64_t wav_map_window(const wav_map_t *m, uint64_t pos, uint64_t frames, const uint8_t **samples)
+{
+	size_t frame_len = m->channels * m->bytes_per_sample;
+	size_t page = (size_t)sysconf(_SC_PAGESIZE);
+	uintptr_t start, end, prev;
+	if(pos >= m->frames)
+		return(0);
+	frames = (frames < m->frames - pos) ? frames : m->frames - pos;
+	*samples = m->samples + pos * frame_len;
+	if(m->flags & WAV_MAP_SEQUENTIAL) {
+		start = (uintptr_t)*samples & ~(uintptr_t)(page - 1);
+		end = (uintptr_t)(*samples + frames * frame_len);
+		madvise((void *)start, end - start, MADV_WILLNEED);
+		prev = (start - (uintptr_t)m->map > end - start) ? start - (end - start) : (uintptr_t)m->map;
+		prev &= ~(uintptr_t)(page - 1);
+		if(start > prev)
+			madvise((void *)prev, start - prev, MADV_DONTNEED);
+	}
+	return(frames);
+}
+#endif //CONFIG_WAV_MAP
@@ -0,0 +1,53 @@
+//! Memory mapped WAV and raw sample reader
+
+//! @file wav_map.h
+//!
+//! The file is mapped read only and the samples are used where they are,
+//! nothing is copied or allocated, so captures of any size can be decoded.
+//! WAV files (RIFF and RF64, PCM, float and WAVE_FORMAT_EXTENSIBLE, as
+//! written by make_wav.c) are validated and described by their header, raw
+//! captures (e.g. interleaved IQ) by the caller.
+//!
+//! Samples are little endian in the file, so the typed views are only
+//! available on little endian hosts (and uint8 samples everywhere).
+//! A WAV file which was not closed (data size 0) is read up to its end.
+//!
+//! With WAV_MAP_SEQUENTIAL the kernel is told the file is read front to back,
+//! wav_map_window() then prefetches the window and drops the pages before it,
+//! so the resident memory stays at a few windows.
+
+#ifndef WAV_MAP_H
+#define WAV_MAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "config.h"
+#include "helper.h"
+#include "make_wav.h"
+
+#define WAV_MAP_SEQUENTIAL BIT(0) //!< file is read front to back (madvise)
+
+typedef struct {
+	const uint8_t *map;            //!< whole file
+	size_t map_len;                //!< length of the file
+	const uint8_t *samples;        //!< first sample
+	uint64_t frames;               //!< sample frames (one sample per channel)
+	uint32_t sample_rate;          //!< 0 for raw files without a rate
+	uint_fast16_t channels;
+	uint_fast8_t bytes_per_sample;
+	uint_fast8_t flags;
+	wav_format_t format;
+} wav_map_t;
+
+#ifdef CONFIG_WAV_MAP
+int wav_map_open(wav_map_t *m, const char *filename, uint_fast8_t flags);
+int wav_map_open_raw(wav_map_t *m, const char *filename, uint_fast8_t flags, wav_format_t format, uint_fast16_t channels, uint32_t sample_rate);
+void wav_map_close(wav_map_t *m);
+const int16_t *wav_map_int16(const wav_map_t *m);
+const uint8_t *wav_map_uint8(const wav_map_t *m);
+const float *wav_map_float(const wav_map_t *m);
+uint64_t wav_map_window(const wav_map_t *m, uint64_t pos, uint64_t frames, const uint8_t **samples);
+#endif
+
+#endif
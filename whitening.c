@@ -0,0 +1,311 @@
+//! Data whitening (PN9/PN15 scrambler)
+
+//! @file whitening.c
+
+
+#include <string.h>
+#include "whitening.h"
+#include "helper.h"
+#include "manchester.h"
+#include "crc.h"
+
+
+#define WHITENING_KEY8(w, s)  ((w)->key8[0][(s) & 0xff] ^ (w)->key8[1][(s) >> 8])
+#define WHITENING_NEXT8(w, s) ((w)->next8[0][(s) & 0xff] ^ (w)->next8[1][(s) >> 8])
+#define WHITENING_KEY64(w, s)  ((w)->key64[0][(s) & 0xff] ^ (w)->key64[1][(s) >> 8])
+#define WHITENING_NEXT64(w, s) ((w)->next64[0][(s) & 0xff] ^ (w)->next64[1][(s) >> 8])
+
+
+static uint_fast8_t whitening_degree(uint_fast16_t poly)
+{
+	uint_fast8_t n=0;
+	while(poly >> (n + 1))
+		n++;
+	return(n);
+}
+
+
+//! step the LFSR once
+
+//! @param taps polynomial without the x^n term
+//! @param n degree
+#define whitening_step(state, taps, n) (((state) >> 1) | ((count_set_bits((state) & (taps)) & 1) << ((n) - 1)))
+
+
+//! whiten/dewhiten an array with a bit serial LFSR
+
+//! reference implementation, also used to generate the tables
+//! @param poly polynomial with the x^n term
+//! @param state LFSR state at the start of buf, 0 means all ones
+//! @param buf input/output data
+//! @param len length of buf
+//! @return LFSR state after buf
+uint_fast16_t whitening_lfsr(uint_fast16_t poly, uint_fast16_t state, uint8_t *buf, int len)
+{
+	uint_fast8_t n = whitening_degree(poly), j;
+	uint_fast16_t taps = poly & (BIT(n) - 1);
+	int i;
+	if(!state)
+		state = BIT(n) - 1;
+	for(i=0;i<len;i++) {
+		uint_fast8_t key=0;
+		for(j=0;j<8;j++) {
+			if(state & 1)
+				SET_BIT(key, j);
+			state = whitening_step(state, taps, n);
+		}
+		buf[i] ^= key;
+	}
+	return(state);
+}
+
+
+//! precompute the keystream tables
+
+//! @param w tables to fill
+//! @param poly polynomial with the x^n term, degree 2 to 16
+//! @param seed start state, 0 means all ones
+//! @retval 0 ok
+//! @retval -1 unsupported polynomial
+int whitening_init(whitening_t *w, uint_fast16_t poly, uint_fast16_t seed)
+{
+	uint_fast8_t n = whitening_degree(poly), b, j;
+	uint_fast16_t taps = poly & (BIT(n) - 1);
+	int v;
+
+	if(n < 2 || n > 16)
+		return(-1);
+	w->poly = poly;
+	w->degree = n;
+	w->seed = seed ? seed : (uint_fast16_t)(BIT(n) - 1);
+	for(b=0;b<2;b++) {
+		for(v=0;v<256;v++) {
+			uint_fast16_t state = (v << (b << 3)) & (BIT(n) - 1);
+			uint_fast8_t key = 0;
+			for(j=0;j<8;j++) {
+				if(state & 1)
+					SET_BIT(key, j);
+				state = whitening_step(state, taps, n);
+			}
+			w->key8[b][v] = key;
+			w->next8[b][v] = state;
+#ifdef CONFIG_WHITENING_WORD
+			{
+				uint64_t key64 = 0;
+				state = (v << (b << 3)) & (BIT(n) - 1);
+				for(j=0;j<64;j++) {
+					if(state & 1)
+						key64 |= (uint64_t)1 << j;
+					state = whitening_step(state, taps, n);
+				}
+				w->key64[b][v] = key64;
+				w->next64[b][v] = state;
+			}
+#endif
+		}
+	}
+	return(0);
+}
+
+
+#ifdef CONFIG_WHITENING_WORD
+//! XOR 64 keystream bits onto 8 bytes
+static void whitening_xor64(uint8_t *buf, uint64_t key)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	uint64_t tmp;
+	memcpy(&tmp, buf, 8);
+	tmp ^= key;
+	memcpy(buf, &tmp, 8);
+#else
+	uint_fast8_t i;
+	for(i=0;i<8;i++)
+		buf[i] ^= READ_BYTE(key, i);
+#endif
+}
+#endif
+
+
+//! whiten/dewhiten an array
+
+//! @param w tables
+//! @param state LFSR state at the start of buf (w->seed at the start of a frame)
+//! @param buf input/output data
+//! @param len length of buf
+//! @return LFSR state after buf
+uint_fast16_t whitening_xor(const whitening_t *w, uint_fast16_t state, uint8_t *buf, int len)
+{
+	int i=0;
+#ifdef CONFIG_WHITENING_WORD
+	for(;i+8<=len;i+=8) {
+		whitening_xor64(buf + i, WHITENING_KEY64(w, state));
+		state = WHITENING_NEXT64(w, state);
+	}
+#endif
+	for(;i<len;i++) {
+		buf[i] ^= WHITENING_KEY8(w, state);
+		state = WHITENING_NEXT8(w, state);
+	}
+	return(state);
+}
+
+
+//! store whitened bytes, manchester encoded if requested
+static void whitening_emit(uint8_t *dest, int pos, const uint8_t *tmp, uint_fast8_t n, bool manchester)
+{
+	uint_fast8_t i;
+	if(!manchester) {
+		memcpy(dest + pos, tmp, n);
+		return;
+	}
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_ENC_BYTE)
+	for(i=0;i<n;i++) {
+		uint_fast16_t enc = manchester_encode_byte(tmp[i]);
+		dest[(pos+i)<<1] = LOW_BYTE(enc);
+		dest[((pos+i)<<1)+1] = HIGH_BYTE(enc);
+	}
+#else
+	(void)i;
+#endif
+}
+
+
+//! whiten a frame in one pass, optionally with crc16 and manchester coding
+
+//! equivalent to the codecs CRC16, WHITENING, MANCHESTER_GE_THOMAS in a chain
+//! @param w tables
+//! @param buf input/output data (needs to be (len + 2) * 2 with crc16 and manchester)
+//! @param len length of input data
+//! @param flags WHITENING_CRC16, WHITENING_MANCHESTER
+//! @param crc_poly crc16 polynomial
+//! @param crc_init crc16 start value
+//! @return length of output data, or -1 if not supported
+int whitening_encode(const whitening_t *w, uint8_t *buf, int len, uint_fast8_t flags, uint_fast16_t crc_poly, uint_fast16_t crc_init)
+{
+	int out_len = len + ((flags & WHITENING_CRC16) ? 2 : 0), i=0;
+	bool manchester = flags & WHITENING_MANCHESTER;
+	uint_fast16_t state = w->seed, crc = crc_init;
+	uint8_t *src = buf, tmp[8];
+
+#if !defined(CONFIG_MANCHESTER) || !defined(CONFIG_MANCHESTER_ENC_BYTE)
+	if(manchester)
+		return(-1);
+#endif
+	if(manchester) { //encode forward from the upper half
+		src = buf + out_len;
+		memmove(src, buf, len);
+	}
+#ifdef CONFIG_WHITENING_WORD
+	for(;i+8<=len;i+=8) {
+		memcpy(tmp, src + i, 8);
+		if(flags & WHITENING_CRC16)
+			crc = crc16_update(crc, crc_poly, tmp, 8);
+		whitening_xor64(tmp, WHITENING_KEY64(w, state));
+		state = WHITENING_NEXT64(w, state);
+		whitening_emit(buf, i, tmp, 8, manchester);
+	}
+#endif
+	for(;i<len;i++) {
+		tmp[0] = src[i];
+		if(flags & WHITENING_CRC16)
+			crc = crc16_update(crc, crc_poly, tmp, 1);
+		tmp[0] ^= WHITENING_KEY8(w, state);
+		state = WHITENING_NEXT8(w, state);
+		whitening_emit(buf, i, tmp, 1, manchester);
+	}
+	if(flags & WHITENING_CRC16) {
+		tmp[0] = HIGH_BYTE(crc);
+		tmp[1] = LOW_BYTE(crc);
+		tmp[0] ^= WHITENING_KEY8(w, state);
+		state = WHITENING_NEXT8(w, state);
+		tmp[1] ^= WHITENING_KEY8(w, state);
+		whitening_emit(buf, len, tmp, 2, manchester);
+	}
+	return(manchester ? (out_len << 1) : out_len);
+}
+
+
+//! load bytes to dewhiten, manchester decoded if requested
+
+//! @retval 0 ok
+//! @retval -1 invalid manchester code
+static int whitening_load(uint8_t *tmp, const uint8_t *buf, int pos, uint_fast8_t n, bool manchester)
+{
+	uint_fast8_t i;
+	if(!manchester) {
+		memcpy(tmp, buf + pos, n);
+		return(0);
+	}
+#if defined(CONFIG_MANCHESTER) && defined(CONFIG_MANCHESTER_DEC_BYTE)
+	for(i=0;i<n;i++) {
+		int_fast16_t dec = manchester_decode_byte(buf[(pos+i)<<1] | (buf[((pos+i)<<1)+1] << 8));
+		if(dec < 0)
+			return(-1);
+		tmp[i] = dec;
+	}
+	return(0);
+#else
+	(void)i;
+	return(-1);
+#endif
+}
+
+
+//! dewhiten a frame in one pass, optionally with manchester decoding and crc16 check
+
+//! equivalent to decoding the codecs CRC16, WHITENING, MANCHESTER_GE_THOMAS in a chain
+//! the buffer is decoded in place
+//! @param w tables
+//! @param buf input/output data
+//! @param len length of input data
+//! @param flags WHITENING_CRC16, WHITENING_MANCHESTER
+//! @param crc_poly crc16 polynomial
+//! @param crc_init crc16 start value
+//! @return length of output data, or -1 on manchester or crc error
+int whitening_decode(const whitening_t *w, uint8_t *buf, int len, uint_fast8_t flags, uint_fast16_t crc_poly, uint_fast16_t crc_init)
+{
+	bool manchester = flags & WHITENING_MANCHESTER;
+	uint_fast16_t state = w->seed, crc = crc_init;
+	uint8_t tmp[8];
+	int i=0;
+
+	if(manchester) {
+		if(len & 1)
+			return(-1);
+		len >>= 1;
+	}
+	if(flags & WHITENING_CRC16)
+		len -= 2;
+	if(len < 0)
+		return(-1);
+#ifdef CONFIG_WHITENING_WORD
+	for(;i+8<=len;i+=8) {
+		if(whitening_load(tmp, buf, i, 8, manchester))
+			return(-1);
+		whitening_xor64(tmp, WHITENING_KEY64(w, state));
+		state = WHITENING_NEXT64(w, state);
+		if(flags & WHITENING_CRC16)
+			crc = crc16_update(crc, crc_poly, tmp, 8);
+		memcpy(buf + i, tmp, 8);
+	}
+#endif
+	for(;i<len;i++) {
+		if(whitening_load(tmp, buf, i, 1, manchester))
+			return(-1);
+		tmp[0] ^= WHITENING_KEY8(w, state);
+		state = WHITENING_NEXT8(w, state);
+		if(flags & WHITENING_CRC16)
+			crc = crc16_update(crc, crc_poly, tmp, 1);
+		buf[i] = tmp[0];
+	}
+	if(flags & WHITENING_CRC16) {
+		if(whitening_load(tmp, buf, len, 2, manchester))
+			return(-1);
+		tmp[0] ^= WHITENING_KEY8(w, state);
+		state = WHITENING_NEXT8(w, state);
+		tmp[1] ^= WHITENING_KEY8(w, state);
+		if(tmp[0] != HIGH_BYTE(crc) || tmp[1] != LOW_BYTE(crc))
+			return(-1);
+	}
+	return(len);
+}
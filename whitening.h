@@ -0,0 +1,49 @@
+//! Data whitening (PN9/PN15 scrambler)
+
+//! @file whitening.h
+//!
+//! The keystream is the output of a right shifting Fibonacci LFSR, 8 keystream
+//! bits are XORed onto each byte (first bit is the LSB).
+//! The polynomial is given with the x^n term, so PN9 (x^9 + x^5 + 1) is 0x221.
+//! With seed 0x1FF this is the PN9 whitening of the Si4x6x/CC1101 radios.
+//!
+//! whitening_init() precomputes the keystream and next state for every byte of
+//! the LFSR state, as the LFSR is linear the tables of the low and high state
+//! byte are XORed together. This gives 64 (or 8) keystream bits per table step.
+//! Polynomials up to degree 16 are supported.
+//!
+//! The fused functions do CRC16 and Manchester coding in the same pass.
+
+#ifndef WHITENING_H
+#define WHITENING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "helper.h"
+
+#define WHITENING_PN9  0x0221 //!< x^9 + x^5 + 1
+#define WHITENING_PN15 0xC001 //!< x^15 + x^14 + 1
+
+#define WHITENING_CRC16      BIT(0) //!< append/check a crc16 of the plain data, then whiten it too
+#define WHITENING_MANCHESTER BIT(1) //!< manchester (G.E. Thomas) code the whitened data
+
+typedef struct {
+	uint_fast16_t poly;
+	uint_fast16_t seed;
+	uint_fast8_t degree;
+	uint8_t key8[2][256];   //!< 8 keystream bits from low/high state byte
+	uint16_t next8[2][256]; //!< state after 8 steps from low/high state byte
+#ifdef CONFIG_WHITENING_WORD
+	uint64_t key64[2][256];   //!< 64 keystream bits from low/high state byte
+	uint16_t next64[2][256];  //!< state after 64 steps from low/high state byte
+#endif
+} whitening_t;
+
+int whitening_init(whitening_t *w, uint_fast16_t poly, uint_fast16_t seed);
+uint_fast16_t whitening_lfsr(uint_fast16_t poly, uint_fast16_t state, uint8_t *buf, int len);
+uint_fast16_t whitening_xor(const whitening_t *w, uint_fast16_t state, uint8_t *buf, int len);
+int whitening_encode(const whitening_t *w, uint8_t *buf, int len, uint_fast8_t flags, uint_fast16_t crc_poly, uint_fast16_t crc_init);
+int whitening_decode(const whitening_t *w, uint8_t *buf, int len, uint_fast8_t flags, uint_fast16_t crc_poly, uint_fast16_t crc_init);
+
+#endif